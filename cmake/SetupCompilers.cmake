@@ -12,10 +12,10 @@ set(BOUT_USE_MPI ${BOUT_ENABLE_MPI})
 
 option(BOUT_ENABLE_OPENMP "Enable OpenMP support" OFF)
 set(BOUT_OPENMP_SCHEDULE static CACHE STRING "Set OpenMP schedule")
-set_property(CACHE BOUT_OPENMP_SCHEDULE PROPERTY STRINGS static dynamic guided auto)
+set_property(CACHE BOUT_OPENMP_SCHEDULE PROPERTY STRINGS static dynamic guided auto runtime)
 if (BOUT_ENABLE_OPENMP)
   find_package(OpenMP REQUIRED)
-  set(possible_openmp_schedules static dynamic guided auto)
+  set(possible_openmp_schedules static dynamic guided auto runtime)
   if (NOT BOUT_OPENMP_SCHEDULE IN_LIST possible_openmp_schedules)
     message(FATAL_ERROR "BOUT_OPENMP_SCHEDULE must be one of ${possible_openmp_schedules}; got ${BOUT_OPENMP_SCHEDULE}")
   endif()
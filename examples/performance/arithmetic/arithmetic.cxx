@@ -7,11 +7,16 @@
 
 #include <bout/expr.hxx>
 
+#include <algorithm>
 #include <chrono>
+#include <memory>
+#include <vector>
 
 using SteadyClock = std::chrono::time_point<std::chrono::steady_clock>;
 using Duration = std::chrono::duration<double>;
 using namespace std::chrono;
+using bout::expr::lazy;
+using RawFields = std::vector<std::unique_ptr<BoutReal[]>>;
 
 #define TIMEIT(elapsed, ...)                                                     \
   {                                                                              \
@@ -39,14 +44,18 @@ protected:
     Field3D b = 2.0;
     Field3D c = 3.0;
 
-    Field3D result1, result2, result3, result4;
+    Field3D d = 4.0;
+    Field3D e = 5.0;
+    Field3D f = 6.0;
+
+    Field3D result1, result2, result3, result4, result5, result6;
 
     // Using Field methods (classic operator overloading)
 
     result1 = 2. * a + b * c;
 #define dur_init {Duration::min(), Duration::max(), Duration::zero(), 0}
     Durations elapsed1 = dur_init, elapsed2 = dur_init, elapsed3 = dur_init,
-              elapsed4 = dur_init;
+              elapsed4 = dur_init, elapsed5 = dur_init, elapsed6 = dur_init;
 
     for (int ik = 0; ik < 1e2; ++ik) {
       TIMEIT(elapsed1, result1 = 2. * a + b * c;);
@@ -69,11 +78,52 @@ protected:
           });
 
       // Template expressions
-      TIMEIT(elapsed3, result3 = eval3D(add(mul(2, a), mul(b, c))););
+      TIMEIT(elapsed3, result3 = bout::expr::eval(2. * lazy(a) + lazy(b) * c););
 
       // Range iterator
       result4.allocate();
       TIMEIT(elapsed4, for (auto i : result4) result4[i] = 2. * a[i] + b[i] * c[i];);
+
+      // Longer expression, with one temporary per operator
+      TIMEIT(elapsed5, result5 = a * b + c * d - e / f;);
+
+      // The same expression fused into a single loop
+      TIMEIT(elapsed6,
+             result6 = bout::expr::eval(lazy(a) * b + lazy(c) * d - lazy(e) / f););
+    }
+
+    // Memory placement. With OpenMP on a multi-socket node, memory
+    // pages are put on the socket of the thread which first writes to
+    // them. Time the same loop over data first written by one thread,
+    // and by all threads in the same order as the loop, which is what
+    // Field3D::allocate does
+    Durations elapsed7 = dur_init, elapsed8 = dur_init;
+    {
+      const auto& region = mesh->getRegion3D("RGN_ALL");
+      const int npoints = mesh->LocalNx * mesh->LocalNy * mesh->LocalNz;
+
+      RawFields serial, parallel;
+      for (int k = 0; k < 4; ++k) {
+        serial.emplace_back(new BoutReal[npoints]);
+        std::fill(serial.back().get(), serial.back().get() + npoints, 1.0);
+
+        parallel.emplace_back(new BoutReal[npoints]);
+        BoutReal* data = parallel.back().get();
+        BOUT_FOR(i, region) { data[i.ind] = 1.0; }
+      }
+
+      const auto loop = [&region](RawFields& fields) {
+        BoutReal* rd = fields[0].get();
+        const BoutReal* ad = fields[1].get();
+        const BoutReal* bd = fields[2].get();
+        const BoutReal* cd = fields[3].get();
+        BOUT_FOR(i, region) { rd[i.ind] = 2. * ad[i.ind] + bd[i.ind] * cd[i.ind]; }
+      };
+
+      for (int ik = 0; ik < 1e2; ++ik) {
+        TIMEIT(elapsed7, loop(serial););
+        TIMEIT(elapsed8, loop(parallel););
+      }
     }
 
     output.enable();
@@ -87,6 +137,10 @@ protected:
     PRINT("C loop:    ", elapsed2);
     PRINT("Templates: ", elapsed3);
     PRINT("Range For: ", elapsed4);
+    PRINT("Fields (5):", elapsed5);
+    PRINT("Fused (5): ", elapsed6);
+    PRINT("Serial:    ", elapsed7);
+    PRINT("Parallel:  ", elapsed8);
     output.disable();
     SOLVE_FOR(n);
     return 0;
@@ -5,6 +5,7 @@
 
 #include <bout/bout.hxx>
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
@@ -90,11 +91,18 @@ int main(int argc, char** argv) {
     ITERATOR_TEST_BLOCK("Bracket [3D,3D] DEFAULT", result = bracket(a, b, BRACKET_STD););
   }
 
-  // Uncomment below for a "correctness" check
-  // Field3D resNew = bracket(a, b, BRACKET_ARAKAWA); mesh->communicate(resNew);
-  // Field3D resOld = bracket(a, b, BRACKET_ARAKAWA_OLD); mesh->communicate(resOld);
-  // time_output << "Max abs diff is
-  // "<<max(abs(resNew-resOld),true)/max(abs(resOld),true)<<std::endl;
+  // BRACKET_ARAKAWA uses vectorised loops over z, and should give the
+  // same result as the scalar loops in BRACKET_ARAKAWA_OLD
+  const auto compareArakawa = [&](const std::string& name, const Field3D& vectorised,
+                                  const Field3D& scalar) {
+    const auto time = [&](const std::string& method) {
+      const auto found = std::find(names.begin(), names.end(), name + " " + method);
+      return times[std::distance(names.begin(), found)].count();
+    };
+    time_output << name << " ARAKAWA speedup over ARAKAWA_OLD: "
+                << time("ARAKAWA_OLD") / time("ARAKAWA") << ", max relative difference: "
+                << max(abs(vectorised - scalar), true) / max(abs(scalar), true) << "\n";
+  };
 
   if (profileMode) {
     int nthreads = 0;
@@ -157,6 +165,15 @@ int main(int argc, char** argv) {
       time_output << std::setw(width) << names[i] << "\t" << times[i].count() / NUM_LOOPS
                   << "\n";
     }
+    time_output << "\n";
+    if (do2D3D) {
+      compareArakawa("Bracket [2D,3D]", bracket(a, c, BRACKET_ARAKAWA),
+                     bracket(a, c, BRACKET_ARAKAWA_OLD));
+    }
+    if (do3D3D) {
+      compareArakawa("Bracket [3D,3D]", bracket(a, b, BRACKET_ARAKAWA),
+                     bracket(a, b, BRACKET_ARAKAWA_OLD));
+    }
   };
 
   BoutFinalise();
@@ -137,6 +137,24 @@ int main(int argc, char** argv) {
   Field3D flagosad;
   TEST_BLOCK("flagosad", flagosad = lap->solve(input, set_to););
 
+  /// Compare the cyclic solver with and without pipelining the
+  /// communication of the interface equations
+
+  auto lap_pipeline =
+      std::unique_ptr<Laplacian>{Laplacian::create(&Options::root()["laplace_pipeline"])};
+
+  for (auto* solver : {lap.get(), lap_pipeline.get()}) {
+    solver->setCoefA(0.0);
+    solver->setCoefC(1.0);
+    solver->setCoefD(1.0);
+    solver->setInnerBoundaryFlags(0);
+    solver->setOuterBoundaryFlags(0);
+  }
+  Field3D unpipelined;
+  TEST_BLOCK("unpipelined", unpipelined = lap->solve(input););
+  Field3D pipelined;
+  TEST_BLOCK("pipelined", pipelined = lap_pipeline->solve(input););
+
   MPI_Barrier(BoutComm::get()); // Wait for all processors to write data
 
   // Report
@@ -64,6 +64,44 @@ int main(int argc, char** argv) {
         name, BOUT_FOR(i, region) { result[i] = a[i] + b[i]; });
   }
 
+  // Time an x and y stencil with different tile shapes. Tiles span
+  // all of x, so only the y and z sizes are varied
+  const auto& noBndry = mesh->getRegion3D("RGN_NOBNDRY");
+  const int blocksize = mesh->maxregionblocksize;
+
+  ITERATOR_TEST_BLOCK(
+      "untiled stencil", BOUT_FOR(i, noBndry) {
+        result[i] = a[i.xp()] - 2. * a[i] + a[i.xm()] + b[i.yp()] - b[i.ym()];
+      });
+
+  std::vector<RegionTileShape> shapes{
+      bout::defaultRegionTileShape(mesh->LocalNx, mesh->LocalNy, mesh->LocalNz)};
+  for (int tile_y = 1; tile_y <= mesh->LocalNy; tile_y *= 2) {
+    for (int tile_z = mesh->LocalNz; tile_z >= std::min(8, mesh->LocalNz);
+         tile_z /= 2) {
+      shapes.push_back({mesh->LocalNx, tile_y, tile_z});
+    }
+  }
+
+  const auto first_tiled = times.size();
+  for (const auto& shape : shapes) {
+    std::string name = "tile y, z : " + std::to_string(shape.y) + ", "
+                       + std::to_string(shape.z);
+    auto region = noBndry;
+    region.tile(shape, blocksize);
+
+    ITERATOR_TEST_BLOCK(
+        name, BOUT_FOR(i, region) {
+          result[i] = a[i.xp()] - 2. * a[i] + a[i.xm()] + b[i.yp()] - b[i.ym()];
+        });
+  }
+  // The first shape is the automatic one, so list it as such
+  names[first_tiled] = "automatic " + names[first_tiled];
+
+  const auto fastest =
+      std::min_element(begin(times) + first_tiled, end(times)) - begin(times);
+  const auto& best_shape = shapes[fastest - first_tiled];
+
   // Report
   constexpr auto min_width = 5;
   const auto width =
@@ -80,6 +118,10 @@ int main(int argc, char** argv) {
                 << "\n";
   }
 
+  time_output << "\nFastest tile shape is " << names[fastest] << ". To use it, set\n"
+              << "\n[mesh]\nregion_tiling = true\ntile_y = " << best_shape.y
+              << "\ntile_z = " << best_shape.z << "\n";
+
   BoutFinalise();
   return 0;
 }
@@ -21,12 +21,16 @@
  *
  * 2021 Holger Jones, Ben Dudson
  *     o Added Umpire support, in multiple iterations/variations
+ *
+ *     o Optional limit on the memory held by each thread's store,
+ *       and statistics on how often stored data is reused
  */
 
 #ifndef __ARRAY_H__
 #define __ARRAY_H__
 
 #include <algorithm>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <vector>
@@ -52,6 +56,32 @@ template <typename T>
 using const_iterator = const T*;
 } // namespace
 
+/// Statistics on the reuse of released Array data, for one thread's
+/// store or summed over all threads
+struct ArrayStoreStats {
+  /// Number of times data was taken from the store
+  std::size_t hits{0};
+  /// Number of times new data had to be allocated
+  std::size_t misses{0};
+  /// Number of data blocks freed to keep within the store limit
+  std::size_t evictions{0};
+  /// Bytes currently held in the store
+  std::size_t bytes_held{0};
+  /// Largest number of bytes held in the store. When summed over
+  /// threads this is an upper bound, as the peaks may be at
+  /// different times
+  std::size_t peak_bytes_held{0};
+
+  ArrayStoreStats& operator+=(const ArrayStoreStats& other) {
+    hits += other.hits;
+    misses += other.misses;
+    evictions += other.evictions;
+    bytes_held += other.bytes_held;
+    peak_bytes_held += other.peak_bytes_held;
+    return *this;
+  }
+};
+
 /*!
  * ArrayData holds the actual data
  * Handles the allocation and deletion of data
@@ -160,6 +190,16 @@ private:
  *
  * Array<dcomplex>::useStore(false); // Disables memory store
  *
+ * Each OpenMP thread has its own store, so no locking is needed. By
+ * default the stores keep everything released to them, which can use
+ * a lot of memory if many different sizes are used. The memory held
+ * by each thread's store can be limited with
+ *
+ * Array<dcomplex>::setStoreLimit(1 << 30); // At most 1 GiB per thread
+ *
+ * after which data of other sizes is freed to make room, and
+ * `storeStats()` reports how well the store is working.
+ *
  * The second template argument determines what type of container to use to
  * store data. This defaults to a custom struct but can be std::valarray (
  * provided T is a compatible type), std::vector etc. Must provide the following :
@@ -220,10 +260,16 @@ public:
    * Reallocate the array with size = \p new_size
    *
    * Note that this invalidates the existing data!
+   *
+   * Returns true if the memory was newly allocated rather than
+   * taken from the store, so has never been written to. Callers can
+   * use this to decide which threads touch the memory first
    */
-  void reallocate(size_type new_size) {
+  bool reallocate(size_type new_size) {
     release(ptr);
-    ptr = get(new_size);
+    bool allocated = false;
+    ptr = get(new_size, &allocated);
+    return allocated;
   }
 
   /*!
@@ -245,6 +291,23 @@ public:
     return value;
   }
 
+  /// Set the maximum number of bytes of released data which each
+  /// thread's store holds for reuse. Zero means no limit
+  static void setStoreLimit(std::size_t bytes) noexcept { storeLimit() = bytes; }
+
+  /// The maximum number of bytes held by each thread's store, or zero
+  /// if there is no limit
+  static std::size_t getStoreLimit() noexcept { return storeLimit(); }
+
+  /// Statistics for the stores, summed over all threads
+  static ArrayStoreStats storeStats() {
+    ArrayStoreStats total;
+    for (const auto& thread_store : arena()) {
+      total += thread_store.stats;
+    }
+    return total;
+  }
+
   /*!
    * Release data. After this the Array is empty and any data access
    * will be invalid
@@ -360,14 +423,41 @@ private:
    */
   dataPtrType ptr;
 
-  using storeType = std::map<size_type, std::vector<dataPtrType>>;
+  /// One thread's store of released data
+  struct storeType {
+    /// Maps from array size to the released dataBlock objects of that size
+    std::map<size_type, std::vector<dataPtrType>> blocks;
+    ArrayStoreStats stats;
+  };
   using arenaType = std::vector<storeType>;
 
+  /// The stores for all threads
+  ///
+  /// By putting the static arena inside a function it is initialised
+  /// on first use, and doesn't need to be separately declared for
+  /// each type T
+  static arenaType& arena() {
+#ifdef _OPENMP
+    static arenaType stores(omp_get_max_threads());
+#else
+    static arenaType stores(1);
+#endif
+    return stores;
+  }
+
+  /// Holds the value for setStoreLimit/getStoreLimit
+  static std::size_t& storeLimit() noexcept {
+    static std::size_t limit{0};
+    return limit;
+  }
+
+  /// Number of bytes used by \p len elements
+  static std::size_t bytes(size_type len) noexcept {
+    return static_cast<std::size_t>(len) * sizeof(T);
+  }
+
   /*!
-   * This maps from array size (size_type) to vectors of pointers to dataBlock objects
-   *
-   * By putting the static store inside a function it is initialised on first use,
-   * and doesn't need to be separately declared for each type T
+   * The store for the current thread
    *
    * Inputs
    * ------
@@ -375,16 +465,12 @@ private:
    * @param[in] cleanup   If set to true, deletes all dataBlock and clears the store
    */
   static storeType& store(bool cleanup = false) {
-#ifdef _OPENMP
-    static arenaType arena(omp_get_max_threads());
-#else
-    static arenaType arena(1);
-#endif
+    auto& threads = arena();
     if (!cleanup) {
 #ifdef _OPENMP
-      return arena[omp_get_thread_num()];
+      return threads[omp_get_thread_num()];
 #else
-      return arena[0];
+      return threads[0];
 #endif
     }
 
@@ -392,43 +478,87 @@ private:
     // sufficient rather than looping over each entry.
     BOUT_OMP(single)
     {
-      for (auto& stores : arena) {
-        for (auto& p : stores) {
+      for (auto& stores : threads) {
+        for (auto& p : stores.blocks) {
           auto& v = p.second;
           for (dataPtrType a : v) {
             a.reset();
           }
           v.clear();
         }
-        stores.clear();
+        stores.blocks.clear();
+        stores.stats.bytes_held = 0;
       }
       // Here we ensure there is exactly one empty map still
       // left in the arena as we have to return one such item
-      arena.resize(1);
+      threads.resize(1);
     }
 
     // Store should now be empty but we need to return something,
     // so return an empty storeType from the arena.
-    return arena[0];
+    return threads[0];
+  }
+
+  /*!
+   * Make room in \p thread_store for a block of size \p len, freeing
+   * stored blocks of other sizes if needed to stay under the store
+   * limit. Returns false if there still isn't enough room.
+   *
+   * Only frees blocks, so is noexcept
+   */
+  static bool makeRoom(storeType& thread_store, size_type len) noexcept {
+    const std::size_t limit = storeLimit();
+    if (limit == 0) {
+      return true;
+    }
+    auto& stats = thread_store.stats;
+    const std::size_t needed = bytes(len);
+    if (needed > limit) {
+      // Would never fit, so don't free anything else
+      return false;
+    }
+    for (auto& p : thread_store.blocks) {
+      if (stats.bytes_held + needed <= limit) {
+        break;
+      }
+      if (p.first == len) {
+        continue;
+      }
+      auto& v = p.second;
+      while (!v.empty() and (stats.bytes_held + needed > limit)) {
+        v.pop_back();
+        stats.bytes_held -= bytes(p.first);
+        ++stats.evictions;
+      }
+    }
+    return stats.bytes_held + needed <= limit;
   }
 
   /*!
    * Returns a pointer to a dataBlock object of size \p len with no
-   * references. This is either from the store, or newly allocated
+   * references. This is either from the store, or newly allocated,
+   * in which case \p allocated is set to true if it isn't null
    *
    * Expects \p len >= 0
    */
-  dataPtrType get(size_type len) {
+  dataPtrType get(size_type len, bool* allocated = nullptr) {
     ASSERT3(len >= 0);
 
     dataPtrType p;
 
-    auto& st = store()[len];
+    auto& thread_store = store();
+    auto& st = thread_store.blocks[len];
 
     if (!st.empty()) {
       p = st.back();
       st.pop_back();
+      thread_store.stats.bytes_held -= bytes(len);
+      ++thread_store.stats.hits;
     } else {
+      ++thread_store.stats.misses;
+      if (allocated != nullptr) {
+        *allocated = true;
+      }
       // Ensure that when we release the data block later we'll have
       // enough space to put it in the store so that `release` can be
       // noexcept
@@ -459,8 +589,17 @@ private:
     // Reduce reference count, and if zero return to store
     if (d.use_count() == 1) {
       if (useStore()) {
-        // Put back into store
-        store()[d->size()].push_back(std::move(d));
+        auto& thread_store = store();
+        const size_type len = d->size();
+        if (makeRoom(thread_store, len)) {
+          // Put back into store
+          thread_store.blocks[len].push_back(std::move(d));
+          auto& stats = thread_store.stats;
+          stats.bytes_held += bytes(len);
+          stats.peak_bytes_held = std::max(stats.peak_bytes_held, stats.bytes_held);
+        } else {
+          ++thread_store.stats.evictions;
+        }
         // Could return here but seems to slow things down a lot
       }
     }
@@ -8,7 +8,58 @@
 #include "bout/unused.hxx"
 #include <bout/field_factory.hxx>
 
+#include <memory>
 #include <utility>
+#include <vector>
+
+/// Values of a boundary generator at the innermost points of a
+/// boundary region, as visited by `BoundaryRegion::next1d`.
+///
+/// The values are calculated for all points at once with a compiled
+/// `bout::generator::Program`. If the generator doesn't depend on
+/// time they are only calculated the first time, otherwise the
+/// time-independent parts of the expression are saved and reused.
+///
+/// Example:
+///
+///     values.update(generator, bndry, loc, t, mesh->LocalNz);
+///     for (bndry->first(); !bndry->isDone(); bndry->next1d()) {
+///       for (int zk = 0; zk < mesh->LocalNz; zk++) {
+///         BoutReal val = values(zk);
+///
+class BoundaryGeneratorValues {
+public:
+  /// Calculate the values of \p gen at the points of \p bndry, for
+  /// a field at \p loc with \p nz points in Z (1 for Field2D), at time
+  /// \p t. Leaves \p bndry at its first point
+  void update(const std::shared_ptr<FieldGenerator>& gen, BoundaryRegion* bndry,
+              CELL_LOC loc, BoutReal t, int nz);
+
+  /// The value at the current point of the boundary region, at Z
+  /// index \p zk. Points which aren't innermost points of the region
+  /// are calculated directly
+  BoutReal operator()(int zk = 0) const;
+
+private:
+  std::shared_ptr<FieldGenerator> generator;
+  std::unique_ptr<bout::generator::Program> program;
+  bout::generator::Program::SavedValues saved;
+
+  /// The values are for these points
+  BoundaryRegion* region{nullptr};
+  CELL_LOC location{CELL_DEFAULT};
+  int nz{0};
+  BoutReal time{0.0};
+  /// Have the values been calculated?
+  bool calculated{false};
+
+  /// Indices of the points, in the order they are visited
+  std::vector<int> x_index, y_index;
+  /// Coordinates and values at each point, with nz values per point
+  std::vector<BoutReal> x, y, z, values;
+  /// Contexts at each point, only set if needed by the program
+  std::vector<bout::generator::Context> contexts;
+};
 
 /// Dirichlet boundary condition set half way between guard cell and grid cell at 2nd order accuracy
 class BoundaryDirichlet_2ndOrder : public BoundaryOp {
@@ -55,6 +106,7 @@ public:
 
 private:
   std::shared_ptr<FieldGenerator> gen; // Generator
+  BoundaryGeneratorValues bndry_values;
 };
 
 BoutReal default_func(BoutReal t, int x, int y, int z);
@@ -81,6 +133,7 @@ public:
 
 private:
   std::shared_ptr<FieldGenerator> gen; // Generator
+  BoundaryGeneratorValues bndry_values;
 };
 
 /// 4th-order boundary condition
@@ -105,6 +158,7 @@ public:
 
 private:
   std::shared_ptr<FieldGenerator> gen; // Generator
+  BoundaryGeneratorValues bndry_values;
 };
 
 /// Dirichlet boundary condition set half way between guard cell and grid cell at 4th order accuracy
@@ -208,6 +262,7 @@ public:
 
 private:
   std::shared_ptr<FieldGenerator> gen;
+  BoundaryGeneratorValues bndry_values;
 };
 
 /// Neumann boundary condition set half way between guard cell and grid cell at 4th order accuracy
@@ -255,6 +310,7 @@ public:
 
 private:
   std::shared_ptr<FieldGenerator> gen;
+  BoundaryGeneratorValues bndry_values;
 };
 
 /// NeumannPar (zero-gradient) boundary condition on
@@ -49,6 +49,10 @@ public:
   static int rank(); ///< Rank: my processor number
   static int size(); ///< Size: number of processors
 
+  /// Level of thread support provided by MPI, e.g. MPI_THREAD_FUNNELED
+  /// if the master thread can make MPI calls inside OpenMP parallel regions
+  static int threadSupport();
+
   // Setting options
   void setComm(MPI_Comm c);
 
@@ -117,6 +117,10 @@ public:
   /// Calculate differential geometry quantities from the metric tensor
   int geometry(bool recalculate_staggered = true,
                bool force_interpolate_from_centre = false);
+  /// Incremented every time `geometry` is called. Anything calculated
+  /// from the metric can compare this with its value at the time, to
+  /// find out if it is out of date
+  int geometryGeneration() const { return geometry_generation; }
   /// Invert contravatiant metric to get covariant components
   int calcCovariant(const std::string& region = "RGN_ALL");
   /// Invert covariant metric to get contravariant components
@@ -222,6 +226,8 @@ public:
 
 private:
   int nz; // Size of mesh in Z. This is mesh->ngz-1
+  /// Number of calls to `geometry`, see `geometryGeneration`
+  int geometry_generation{0};
   Mesh* localmesh;
   CELL_LOC location;
 
@@ -236,11 +242,30 @@ private:
   mutable std::map<std::string, std::unique_ptr<FieldMetric>> Grad2_par2_DDY_invSgCache;
   mutable std::unique_ptr<FieldMetric> invSgCache{nullptr};
 
+  /// Coefficients used by the FFT version of Delp2. Row `i` of each
+  /// matrix is the `i`th (x, y) point of `result_region`, with one
+  /// column per kz mode
+  struct Delp2Coefficients {
+    /// Points where the FFT of the input is needed: the result points
+    /// and their neighbours in x
+    Region<Ind2D> fft_region;
+    /// Points where the result is calculated
+    Region<Ind2D> result_region;
+    /// Number of y points in each x row of the regions
+    int ny;
+    /// Coefficients of the points at x - 1, x and x + 1
+    Matrix<dcomplex> a, b, c;
+  };
+  /// Cache variable for Delp2 coefficients. Invalidated when
+  /// `Coordinates::geometry` is called
+  mutable std::unique_ptr<Delp2Coefficients> delp2_coefs_cache{nullptr};
+
   /// Set the parallel (y) transform from the options file.
   /// Used in the constructor to create the transform object.
   void setParallelTransform(Options* options);
 
   const FieldMetric& invSg() const;
+  const Delp2Coefficients& delp2Coefficients() const;
   const FieldMetric& Grad2_par2_DDY_invSg(CELL_LOC outloc,
                                           const std::string& method) const;
 
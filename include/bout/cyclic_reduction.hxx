@@ -58,6 +58,9 @@
 
 #include "bout/openmpwrap.hxx"
 
+#include <algorithm>
+#include <vector>
+
 template <class T>
 class CyclicReduce {
 public:
@@ -92,6 +95,15 @@ public:
   /// By default not periodic
   void setPeriodic(bool p = true) { periodic = p; }
 
+  /// Pipeline the solve: the interface equations for each processor
+  /// are sent as soon as they have been calculated, while the
+  /// equations for the next processor are reduced. Similarly, the
+  /// local back-solve for the systems from each processor starts as
+  /// soon as their interface solutions arrive. This hides some of
+  /// the communication latency when there are many processors in X.
+  /// By default not pipelined
+  void setPipelined(bool p = true) { pipelined = p; }
+
   void setCoefs(const Array<T>& a, const Array<T>& b, const Array<T>& c) {
     ASSERT2(a.size() == b.size());
     ASSERT2(a.size() == c.size());
@@ -113,6 +125,10 @@ public:
 
   /// Set the entries in the matrix to be inverted
   ///
+  /// The factorisation of the matrix is calculated by the next call
+  /// to `solve`, and reused by later calls until the coefficients
+  /// are set again
+  ///
   /// @param[in] a   Left diagonal. Should have size [nsys][N]
   ///                where N is set in the constructor or setup
   /// @param[in] b   Diagonal values. Should have size [nsys][N]
@@ -124,6 +140,7 @@ public:
 
     // Make sure correct memory arrays allocated
     allocMemory(nprocs, nsys, N);
+    factorised = false;
 
     // Fill coefficient array
     BOUT_OMP(parallel for)
@@ -164,6 +181,10 @@ public:
     }
   };
 
+  /// True if the coefficients have been factorised by a previous
+  /// `solve`, so that further solves only need to sweep the RHS
+  bool isFactorised() const { return factorised; }
+
   /// Solve a set of tridiagonal systems
   ///
   /// @param[in] rhs Matrix storing Values of the rhs for each system
@@ -191,9 +212,37 @@ public:
       }
     }
 
+    // Only pipeline if there is communication to hide
+    const bool pipeline = pipelined and (nprocs > 1);
+
+    // Reduce local part of the matrix to interface equations for
+    // systems [first, first + count). If the coefficients haven't
+    // changed, only the RHS needs reducing
+    auto reduceLocal = [&](int first, int count) {
+      if (factorised) {
+        reduceRHS(count, N, coefs, myif, first);
+      } else {
+        reduce(count, N, coefs, myif, &reduce_factors, first);
+      }
+    };
+
+    // Solve local equations for systems [first, first + count), once
+    // x1 and xn are known for them
+    auto backSolveLocal = [&](int first, int count) {
+      if (factorised) {
+        back_solveRHS(count, N, coefs, x1, xn, x, first);
+      } else {
+        back_solve(count, N, coefs, x1, xn, x, &back_factors, first);
+      }
+    };
+
     ///////////////////////////////////////
-    // Reduce local part of the matrix to interface equations
-    reduce(Nsys, N, coefs, myif);
+    // Reduce local part of the matrix to interface equations. When
+    // pipelining, this is done for each processor's systems just
+    // before sending them
+    if (not pipeline) {
+      reduceLocal(0, Nsys);
+    }
 
     ///////////////////////////////////////
     // Gather all interface equations onto single processor
@@ -218,6 +267,8 @@ public:
     int nsextra = Nsys % nprocs; // Number of processors with 1 extra
 
     auto* req = new MPI_Request[nprocs];
+    // Non-blocking sends used when pipelining
+    std::vector<MPI_Request> send_req(nprocs, MPI_REQUEST_NULL);
 
     if (myns > 0) {
       // Post receives from all other processors
@@ -228,15 +279,7 @@ public:
         // 3 coefficients + 1 RHS value
         int len = 2 * myns * 4 * sizeof(T); // Length of data in bytes
 
-        if (p == myproc) {
-          // Just copy the data
-          BOUT_OMP(parallel for)
-          for (int i = 0; i < myns; i++) {
-            for (int j = 0; j < 8; j++) {
-              ifcs(i, 8 * p + j) = myif(sys0 + i, j);
-            }
-          }
-        } else {
+        if (p != myproc) {
 #ifdef DIAGNOSE
           output << "Expecting to receive " << len << " from " << p << endl;
 #endif
@@ -251,27 +294,50 @@ public:
     }
 
     // Send data
-    int s0 = 0;
-    for (int p = 0; p < nprocs; p++) { // Loop over processor
+    for (int k = 0; k < nprocs; k++) { // Loop over processor
+      // When pipelining, start with the next processor so that they
+      // don't all send to the same one first
+      const int p = pipeline ? (myproc + 1 + k) % nprocs : k;
+      const int s0 = (p * ns) + std::min(p, nsextra);
       int nsp = ns;
       if (p < nsextra) {
         nsp++;
       }
-      if ((p != myproc) && (nsp > 0)) {
+      if (pipeline) {
+        reduceLocal(s0, nsp);
+      }
+      if (p == myproc) {
+        // Just copy the data
+        BOUT_OMP(parallel for)
+        for (int i = 0; i < myns; i++) {
+          for (int j = 0; j < 8; j++) {
+            ifcs(i, 8 * p + j) = myif(sys0 + i, j);
+          }
+        }
+      } else if (nsp > 0) {
 #ifdef DIAGNOSE
         output << "Sending to " << p << endl;
         for (int i = 0; i < 8; i++) {
           output << "value " << i << " : " << myif(s0, i) << endl;
         }
 #endif
-        MPI_Send(&myif(s0, 0),        // Data pointer
-                 8 * nsp * sizeof(T), // Number
-                 MPI_BYTE,            // Type
-                 p,                   // Destination
-                 myproc,              // Message identifier
-                 comm);               // Communicator
+        if (pipeline) {
+          MPI_Isend(&myif(s0, 0),        // Data pointer
+                    8 * nsp * sizeof(T), // Number
+                    MPI_BYTE,            // Type
+                    p,                   // Destination
+                    myproc,              // Message identifier
+                    comm,                // Communicator
+                    &send_req[p]);       // Request
+        } else {
+          MPI_Send(&myif(s0, 0),        // Data pointer
+                   8 * nsp * sizeof(T), // Number
+                   MPI_BYTE,            // Type
+                   p,                   // Destination
+                   myproc,              // Message identifier
+                   comm);               // Communicator
+        }
       }
-      s0 += nsp;
     }
 
     if (myns > 0) {
@@ -350,6 +416,10 @@ public:
       back_solve(myns, 2 * nprocs, ifcs, x1, xn, ifx);
     }
 
+    // myif isn't changed until the next solve, but the sends must
+    // finish before then
+    MPI_Waitall(nprocs, send_req.data(), MPI_STATUSES_IGNORE);
+
     if (nprocs > 1) {
       ///////////////////////////////////////
       // Scatter back solution
@@ -370,6 +440,9 @@ public:
             xn[sys0 + i] = ifx(i, 2 * p + 1);
           }
           req[p] = MPI_REQUEST_NULL;
+          if (pipeline) {
+            backSolveLocal(sys0, myns);
+          }
         } else if (nsp > 0) {
 #ifdef DIAGNOSE
           output << "Expecting receive from " << p << " of size " << len << endl;
@@ -437,13 +510,21 @@ public:
 #endif
           }
           req[fromproc] = MPI_REQUEST_NULL;
+          if (pipeline) {
+            // Back-solve these systems while waiting for the others
+            backSolveLocal(s0, nsp);
+          }
         }
       } while (fromproc != MPI_UNDEFINED);
     }
 
     ///////////////////////////////////////
-    // Solve local equations
-    back_solve(Nsys, N, coefs, x1, xn, x);
+    // Solve local equations. When pipelining this has already been
+    // done as the solutions of the interface equations arrived
+    if (not pipeline) {
+      backSolveLocal(0, Nsys);
+    }
+    factorised = true;
     delete[] req;
   }
 
@@ -456,7 +537,8 @@ private:
   int myns;    ///< Number of systems for interface solve on this processor
   int sys0;    ///< Starting system index for interface solve
 
-  bool periodic{false}; ///< Is the domain periodic?
+  bool periodic{false};  ///< Is the domain periodic?
+  bool pipelined{false}; ///< Overlap communication with reduction and back-solve?
 
   Matrix<T> coefs; ///< Starting coefficients, rhs [Nsys, {3*coef,rhs}*N]
   Matrix<T> myif;  ///< Interface equations for this processor
@@ -468,6 +550,15 @@ private:
   Array<T> ifp;         ///< Interface equations returned to processor p
   Array<T> x1, xn;      ///< Interface solutions for back-solving
 
+  /// True if reduce_factors and back_factors are set for the current coefficients
+  bool factorised{false};
+  /// Multipliers used to reduce the local equations to the interface
+  /// equations [Nsys, {upper,lower}*N]
+  Matrix<T> reduce_factors;
+  /// Thomas algorithm pivots and multipliers for the local back-solve
+  /// [Nsys, {pivot,multiplier}*N]
+  Matrix<T> back_factors;
+
   /// Allocate memory arrays
   /// @param[in] np   Number of processors
   /// @param[in] nsys  Number of independent systems to solve
@@ -520,6 +611,10 @@ private:
 
     x1.reallocate(Nsys);
     xn.reallocate(Nsys);
+
+    reduce_factors.reallocate(Nsys, 2 * N);
+    back_factors.reallocate(Nsys, 2 * N);
+    factorised = false;
   }
 
   /// Calculate interface equations
@@ -533,7 +628,11 @@ private:
   /// (      a3 b3 c3            )   =>  (   A2 B2 C2)
   /// (              ...         )
   /// (                  an bn cn)
-  void reduce(int ns, int nloc, Matrix<T>& co, Matrix<T>& ifc) {
+  ///
+  /// If \p factors is not null, the multipliers used are saved in
+  /// it so that `reduceRHS` can reduce a new RHS
+  void reduce(int ns, int nloc, Matrix<T>& co, Matrix<T>& ifc,
+              Matrix<T>* factors = nullptr, int first = 0) {
 #ifdef DIAGNOSE
     if (nloc < 2) {
       throw BoutException("CyclicReduce::reduce nloc < 2");
@@ -541,7 +640,7 @@ private:
 #endif
 
     BOUT_OMP(parallel for)
-    for (int j = 0; j < ns; j++) {
+    for (int j = first; j < first + ns; j++) {
       // Calculate upper interface equation
 
       // v_l <- v_(k+N-2)
@@ -558,6 +657,9 @@ private:
 
         // beta <- v_{i,i+1} / v_u,i
         T beta = co(j, 4 * i + 2) / ifc(j, 1);
+        if (factors != nullptr) {
+          (*factors)(j, i) = beta;
+        }
 
         // v_u <- v_i - beta * v_u
         ifc(j, 1) = co(j, 4 * i + 1) - beta * ifc(j, 0);
@@ -586,6 +688,9 @@ private:
 
         // alpha <- v_{i,i-1} / v_l,i-1
         T alpha = co(j, 4 * i) / ifc(j, 4 + 1);
+        if (factors != nullptr) {
+          (*factors)(j, nloc + i) = alpha;
+        }
 
         // v_l <- v_i - alpha*v_l
         ifc(j, 4 + 0) *= -alpha;
@@ -609,10 +714,34 @@ private:
     // Upper system couples {-1. 0, N-1}
   }
 
+  /// Reduce only the RHS of the local equations to the RHS of the
+  /// interface equations, using the multipliers saved by
+  /// `reduce`. The interface coefficients in \p ifc are unchanged
+  void reduceRHS(int ns, int nloc, const Matrix<T>& co, Matrix<T>& ifc, int first = 0) {
+    BOUT_OMP(parallel for)
+    for (int j = first; j < first + ns; j++) {
+      // Upper interface equation
+      ifc(j, 3) = co(j, 4 * (nloc - 2) + 3);
+      for (int i = nloc - 3; i >= 0; i--) {
+        ifc(j, 3) = co(j, 4 * i + 3) - reduce_factors(j, i) * ifc(j, 3);
+      }
+
+      // Lower interface equation
+      ifc(j, 4 + 3) = co(j, 4 + 3);
+      for (int i = 2; i < nloc; i++) {
+        ifc(j, 4 + 3) = co(j, 4 * i + 3) - reduce_factors(j, nloc + i) * ifc(j, 4 + 3);
+      }
+    }
+  }
+
   /// Back-solve from x at ends (x1, xn) to obtain remaining values
   /// Coefficients ordered [ns, nloc*(a,b,c,r)]
+  ///
+  /// If \p factors is not null, the pivots and multipliers are saved
+  /// in it so that `back_solveRHS` can solve for a new RHS
   void back_solve(int ns, int nloc, const Matrix<T>& co, const Array<T>& x1,
-                  const Array<T>& xn, Matrix<T>& xa) {
+                  const Array<T>& xn, Matrix<T>& xa, Matrix<T>* factors = nullptr,
+                  int first = 0) {
 
     xa.ensureUnique(); // Going to be modified, so call this outside parallel region
 
@@ -620,8 +749,8 @@ private:
     // xa -- Result for each system
     // co -- Coefficients & rhs for each system
     BOUT_OMP(parallel for)
-    for (int i = 0; i < ns; i++) { // Loop over systems
-      Array<T> gam(nloc);          // Thread-local array
+    for (int i = first; i < first + ns; i++) { // Loop over systems
+      Array<T> gam(nloc);                      // Thread-local array
       T bet = 1.0;
       xa(i, 0) = x1[i]; // Already know the first
       gam[1] = 0.;
@@ -630,6 +759,10 @@ private:
         xa(i, j) = (co(i, 4 * j + 3) - co(i, 4 * j) * xa(i, j - 1))
                    / bet;                    // x[j] = (r[j]-a[j]*x[j-1])/bet;
         gam[j + 1] = co(i, 4 * j + 2) / bet; // gam[j+1] = c[j]/bet
+        if (factors != nullptr) {
+          (*factors)(i, j) = bet;
+          (*factors)(i, nloc + j + 1) = gam[j + 1];
+        }
       }
       xa(i, nloc - 1) = xn[i]; // Know the last value
 
@@ -638,6 +771,27 @@ private:
       }
     }
   }
+
+  /// Back-solve for a new RHS, using the pivots and multipliers
+  /// saved by `back_solve`
+  void back_solveRHS(int ns, int nloc, const Matrix<T>& co, const Array<T>& x1,
+                     const Array<T>& xn, Matrix<T>& xa, int first = 0) {
+
+    xa.ensureUnique(); // Going to be modified, so call this outside parallel region
+
+    BOUT_OMP(parallel for)
+    for (int i = first; i < first + ns; i++) { // Loop over systems
+      xa(i, 0) = x1[i];
+      for (int j = 1; j < nloc - 1; j++) {
+        xa(i, j) = (co(i, 4 * j + 3) - co(i, 4 * j) * xa(i, j - 1)) / back_factors(i, j);
+      }
+      xa(i, nloc - 1) = xn[i];
+
+      for (int j = nloc - 2; j > 0; j--) {
+        xa(i, j) = xa(i, j) - back_factors(i, nloc + j + 1) * xa(i, j + 1);
+      }
+    }
+  }
 };
 
 #endif // __CYCLIC_REDUCE_H__
@@ -41,6 +41,8 @@
 #include <bout/msg_stack.hxx>
 #include <bout/options.hxx>
 
+struct stencil;
+
 /// Here we have a templated singleton that is used to store DerivativeFunctions
 /// for all types of derivatives. It is templated on the FieldType (2D or 3D) as
 /// the function interfaces also depend on this. It provides public routines for
@@ -56,6 +58,23 @@ struct DerivativeStore {
                                       const std::string&)>;
   using upwindFunc = flowFunc;
   using fluxFunc = flowFunc;
+  /// Calculates an unstaggered second and first derivative in the
+  /// same pass; arguments are input, second derivative, first
+  /// derivative and region
+  using fusedPairFunc =
+      std::function<void(const FieldType&, FieldType&, FieldType&, const std::string&)>;
+
+  /// Calculates a derivative at a single point from its stencil, so
+  /// that several derivatives can share the stencil. Only methods
+  /// which are defined in terms of a stencil have these, and only
+  /// for unstaggered standard and upwind derivatives
+  struct StencilKernel {
+    BoutReal (*standard)(const stencil&){nullptr};
+    BoutReal (*upwind)(BoutReal, const stencil&){nullptr};
+    int nGuards{0};
+
+    bool isValid() const { return (standard != nullptr) or (upwind != nullptr); }
+  };
 
 #ifdef USE_ORDERED_MAP_FOR_DERIVATIVE_STORE
   template <typename K, typename V>
@@ -206,6 +225,35 @@ struct DerivativeStore {
     registeredMethods[getKey(direction, stagger, toString(derivType))].insert(methodName);
   };
 
+  /// Register the single point version of an unstaggered standard or
+  /// upwind derivative method
+  void registerStencilKernel(StencilKernel kernel, DERIV derivType, DIRECTION direction,
+                             const std::string& methodName) {
+    AUTO_TRACE();
+    const auto key = getKernelKey(direction, derivType, methodName);
+    if (stencilKernels.count(key) != 0) {
+      throw BoutException("Trying to override stencil kernel : "
+                          "direction {:s}, type {:s}, key {:s}",
+                          toString(direction), toString(derivType), methodName);
+    }
+    stencilKernels[key] = kernel;
+  }
+
+  /// Register a function which calculates the unstaggered second
+  /// derivative with method \p secondName and the first derivative
+  /// with method \p firstName together
+  void registerFusedPair(fusedPairFunc func, DIRECTION direction,
+                         const std::string& secondName, const std::string& firstName) {
+    AUTO_TRACE();
+    const auto key = getFusedPairKey(direction, secondName, firstName);
+    if (fusedPairs.count(key) != 0) {
+      throw BoutException("Trying to override fused pair : "
+                          "direction {:s}, keys {:s} and {:s}",
+                          toString(direction), secondName, firstName);
+    }
+    fusedPairs[key] = func;
+  }
+
   /// Templated versions of the above registration routines.
   template <typename Direction, typename Stagger, typename Method>
   void registerDerivative(standardFunc func, Direction direction, Stagger stagger,
@@ -260,6 +308,48 @@ struct DerivativeStore {
                         getMethodName(realName, direction, stagger), toString(derivType));
   };
 
+  /// The name of the method which is used when \p name is
+  /// requested, which is the default method if \p name is "DEFAULT"
+  std::string resolveMethodName(const std::string& name, DIRECTION direction,
+                                STAGGER stagger, DERIV derivType) const {
+    AUTO_TRACE();
+    return nameLookup(
+        name, defaultMethods.at(getKey(direction, stagger, toString(derivType))));
+  }
+
+  /// The single point version of the unstaggered \p derivType
+  /// derivative method \p name. The result isn't valid if the method
+  /// has no stencil kernel, for example if it uses FFTs
+  StencilKernel getStencilKernel(const std::string& name, DIRECTION direction,
+                                 DERIV derivType) const {
+    AUTO_TRACE();
+    const auto realName = resolveMethodName(name, direction, STAGGER::None, derivType);
+    const auto resultOfFind =
+        stencilKernels.find(getKernelKey(direction, derivType, realName));
+    if (resultOfFind != stencilKernels.end()) {
+      return resultOfFind->second;
+    }
+    return StencilKernel{};
+  }
+
+  /// The function calculating the unstaggered second derivative with
+  /// method \p secondName and first derivative with method \p
+  /// firstName together. This is empty if that pair wasn't registered
+  fusedPairFunc getFusedPair(const std::string& secondName, const std::string& firstName,
+                             DIRECTION direction) const {
+    AUTO_TRACE();
+    const auto realSecond = resolveMethodName(secondName, direction, STAGGER::None,
+                                              DERIV::StandardSecond);
+    const auto realFirst =
+        resolveMethodName(firstName, direction, STAGGER::None, DERIV::Standard);
+    const auto resultOfFind =
+        fusedPairs.find(getFusedPairKey(direction, realSecond, realFirst));
+    if (resultOfFind != fusedPairs.end()) {
+      return resultOfFind->second;
+    }
+    return fusedPairFunc{};
+  }
+
   standardFunc getStandard2ndDerivative(std::string name, DIRECTION direction,
                                         STAGGER stagger = STAGGER::None) const {
     AUTO_TRACE();
@@ -414,6 +504,8 @@ struct DerivativeStore {
     standardFourth.clear();
     upwind.clear();
     flux.clear();
+    stencilKernels.clear();
+    fusedPairs.clear();
     registeredMethods.clear();
   }
 
@@ -438,6 +530,8 @@ private:
   storageType<std::size_t, standardFunc> standardFourth;
   storageType<std::size_t, upwindFunc> upwind;
   storageType<std::size_t, fluxFunc> flux;
+  storageType<std::size_t, StencilKernel> stencilKernels;
+  storageType<std::size_t, fusedPairFunc> fusedPairs;
 
   storageType<std::size_t, std::set<std::string>> registeredMethods;
 
@@ -518,6 +612,21 @@ private:
     return result;
   }
 
+  /// Key for the stencil kernels, which are stored together for all
+  /// types of derivative
+  std::size_t getKernelKey(DIRECTION direction, DERIV derivType,
+                           const std::string& methodName) const {
+    return getKey(direction, STAGGER::None, methodName)
+           ^ (std::hash<std::string>{}(toString(derivType)) << 1);
+  }
+
+  /// Key for the fused pairs of second and first derivatives
+  std::size_t getFusedPairKey(DIRECTION direction, const std::string& secondName,
+                              const std::string& firstName) const {
+    return getKey(direction, STAGGER::None, secondName)
+           ^ (std::hash<std::string>{}(firstName) << 1);
+  }
+
   /// Provides a routine to produce a unique key given information
   /// about the specific type required. This is templated so requires
   /// compile-time information. Makes use of a non-templated version
@@ -1,208 +1,408 @@
 /**************************************************************************
+ * Lazy expression templates for Field3D/Field2D arithmetic
  *
- * Operators, and support for template expressions
- * 
- * Originally based on article by Klaus Kreft & Angelika Langer
- * http://www.angelikalanger.com/Articles/Cuj/ExpressionTemplates/ExpressionTemplates.htm
- * 
- * Parts adapted from Blitz++ library
+ * Each of the usual binary operators on fields allocates a new
+ * result and makes a full pass over memory, so that an expression
+ * like `a*b + c*d - e/f` creates five temporaries. The classes here
+ * instead build an expression tree at compile time, which is then
+ * evaluated in a single loop over a Region, with no temporaries.
+ *
+ * Expressions are started by wrapping a field with `lazy()`, and
+ * evaluated with `eval()` or `assign()`:
+ *
+ *     using bout::expr::lazy;
+ *     Field3D result = bout::expr::eval(lazy(a) * b + lazy(c) * d - lazy(e) / f);
+ *
+ *     // Only evaluate in the interior
+ *     bout::expr::assign(result, lazy(a) * b + 2.0, "RGN_NOBNDRY");
+ *
+ * Once one operand is an expression, the others may be `Field3D`,
+ * `Field2D` or `BoutReal`. Operators only build an expression if one
+ * of their own operands is already an expression, so each product or
+ * quotient of plain fields must also start with `lazy()`: in
+ * `lazy(a) * b + c * d`, `c * d` is evaluated eagerly into a
+ * temporary before it is added. Field2D operands are broadcast in z. If
+ * the expression contains any Field3D, the result is a Field3D,
+ * otherwise it is a Field2D.
+ *
+ * Note that expressions only hold references to their operands, so
+ * they should be evaluated within the same statement in which they
+ * are built.
+ *
+ **************************************************************************
+ * Copyright 2010 - 2023 BOUT++ contributors
+ *
+ * Contact: Ben Dudson, dudson2@llnl.gov
+ *
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
  *
  **************************************************************************/
 
 #ifndef __EXPR_H__
 #define __EXPR_H__
 
-#warning expr.hxx is deprecated. Do not use!
-
 #include <bout/field2d.hxx>
 #include <bout/field3d.hxx>
 #include <bout/mesh.hxx>
+#include <bout/openmpwrap.hxx>
+#include <bout/region.hxx>
 
-/// Literal class to capture BoutReal values in expressions
-class Literal {
+#include <algorithm>
+#include <string>
+#include <type_traits>
+
+namespace bout {
+namespace expr {
+
+/// Expression leaf wrapping a Field3D
+///
+/// Evaluated with the flattened 3D index \p i3d; the 2D index is
+/// ignored
+class Field3DLeaf {
 public:
-  /// Type of this expression
-  using type = Literal;
+  static constexpr bool has3D = true;
+  static constexpr bool has2D = false;
 
-  Literal(BoutReal v) : val(v) {}
-  ~Literal() {}
-  BoutReal operator()(int x, int y, int z) const { return val; }
+  explicit Field3DLeaf(const Field3D& f) : field(f), data(&f(0, 0, 0)) {}
 
-private:
-  const BoutReal val;
-};
+  BoutReal operator()(int i3d, int UNUSED(i2d)) const { return data[i3d]; }
 
-class Field3DExpr {
-public:
-  using type = Field3D;
+  const Field3D* getField3D() const { return &field; }
+  const Field2D* getField2D() const { return nullptr; }
 
-  Field3DExpr(const Field3D& f) : data(&f(0, 0, 0)) {}
-  const BoutReal& operator()(int x, int y, int z) const {
-    return data[(x * bout::globals::mesh->LocalNy + y) * bout::globals::mesh->LocalNz
-                + z];
+  template <class T>
+  void check(const T& prototype) const {
+    ASSERT1_FIELDS_COMPATIBLE(prototype, field);
+    checkData(field);
   }
 
 private:
+  const Field3D& field;
   const BoutReal* data;
 };
 
-class Field2DExpr {
+/// Expression leaf wrapping a Field2D, which is broadcast in z
+///
+/// Evaluated with the flattened 2D index \p i2d
+class Field2DLeaf {
 public:
-  using type = Field2D;
+  static constexpr bool has3D = false;
+  static constexpr bool has2D = true;
+
+  explicit Field2DLeaf(const Field2D& f) : field(f), data(&f(0, 0)) {}
 
-  Field2DExpr(const Field2D& f) : data(&f(0, 0)) {}
-  const BoutReal& operator()(int x, int y, int z) const {
-    return data[x * bout::globals::mesh->LocalNy + y];
+  BoutReal operator()(int UNUSED(i3d), int i2d) const { return data[i2d]; }
+
+  const Field3D* getField3D() const { return nullptr; }
+  const Field2D* getField2D() const { return &field; }
+
+  template <class T>
+  void check(const T& prototype) const {
+    ASSERT1_FIELDS_COMPATIBLE(prototype, field);
+    checkData(field);
   }
 
 private:
+  const Field2D& field;
   const BoutReal* data;
 };
 
-/// Expression traits, to convert doubles etc. to Literal
+/// Expression leaf holding a constant value
+class ScalarLeaf {
+public:
+  static constexpr bool has3D = false;
+  static constexpr bool has2D = false;
 
-template <class ExprT>
-struct exprTraits {
-  using expr_type = ExprT;
-};
+  ScalarLeaf(BoutReal value) : value(value) {}
 
-template <>
-struct exprTraits<double> {
-  using expr_type = Literal;
-};
+  BoutReal operator()(int UNUSED(i3d), int UNUSED(i2d)) const { return value; }
 
-template <>
-struct exprTraits<float> {
-  using expr_type = Literal;
-};
+  const Field3D* getField3D() const { return nullptr; }
+  const Field2D* getField2D() const { return nullptr; }
 
-template <>
-struct exprTraits<int> {
-  using expr_type = Literal;
+  template <class T>
+  void check(const T& UNUSED(prototype)) const {}
+
+private:
+  BoutReal value;
 };
 
-///////////////////////////////////////////////
-// asExpr: convert objects to expressions
+/// Binary operator classes
+#define DEFINE_EXPR_BINARY_OP(name, op)                       \
+  struct name {                                               \
+    static inline BoutReal apply(BoutReal lhs, BoutReal rhs) { \
+      return lhs op rhs;                                      \
+    }                                                         \
+  };
 
-template <typename T>
-struct asExpr {
-  using type = T;
-  static const T& getExpr(const T& x) { return x; }
-};
+DEFINE_EXPR_BINARY_OP(Add, +)
+DEFINE_EXPR_BINARY_OP(Subtract, -)
+DEFINE_EXPR_BINARY_OP(Multiply, *)
+DEFINE_EXPR_BINARY_OP(Divide, /)
 
-template <>
-struct asExpr<int> {
-  using type = Literal;
-  static const Literal getExpr(const int& x) { return Literal(x); }
-};
+#undef DEFINE_EXPR_BINARY_OP
 
-template <>
-struct asExpr<double> {
-  using type = Literal;
-  static const Literal getExpr(const double& x) { return Literal(x); }
-};
+/// Node applying \p Op to the results of two sub-expressions
+template <class Op, class Lhs, class Rhs>
+class BinaryExpr {
+public:
+  static constexpr bool has3D = Lhs::has3D or Rhs::has3D;
+  static constexpr bool has2D = Lhs::has2D or Rhs::has2D;
 
-template <>
-struct asExpr<float> {
-  using type = Literal;
-  static const Literal getExpr(const float& x) { return Literal(x); }
-};
+  BinaryExpr(Lhs lhs, Rhs rhs) : lhs(lhs), rhs(rhs) {}
 
-template <>
-struct asExpr<Field3D> {
-  using type = Field3DExpr;
-  static const Field3DExpr getExpr(const Field3D& x) { return Field3DExpr(x); }
-};
+  BoutReal operator()(int i3d, int i2d) const {
+    return Op::apply(lhs(i3d, i2d), rhs(i3d, i2d));
+  }
 
-/////////////////////////////////////////////////////////////
-// Type promotion. Work out the type of a calculation,
-// based on the type of the arguments
+  const Field3D* getField3D() const {
+    const auto* field = lhs.getField3D();
+    return field != nullptr ? field : rhs.getField3D();
+  }
+  const Field2D* getField2D() const {
+    const auto* field = lhs.getField2D();
+    return field != nullptr ? field : rhs.getField2D();
+  }
 
-template <typename Lhs, typename Rhs> // If in doubt, convert to Field3D
-struct PromoteType {
-  using type = Field3D;
-};
+  template <class T>
+  void check(const T& prototype) const {
+    lhs.check(prototype);
+    rhs.check(prototype);
+  }
 
-/////////////////////////////////////////////////////////////
-// Binary expressions
+private:
+  const Lhs lhs;
+  const Rhs rhs;
+};
 
-template <class ExprT1, class ExprT2, class BinOp>
-class BinaryExpr {
+/// Node negating a sub-expression
+template <class Arg>
+class NegateExpr {
 public:
-  BinaryExpr(const ExprT1& e1, const ExprT2& e2) : _expr1(e1), _expr2(e2) {}
+  static constexpr bool has3D = Arg::has3D;
+  static constexpr bool has2D = Arg::has2D;
+
+  explicit NegateExpr(Arg arg) : arg(arg) {}
 
-  // Work out the type of the inputs
-  using ltype = typename exprTraits<ExprT1>::expr_type;
-  using rtype = typename exprTraits<ExprT2>::expr_type;
+  BoutReal operator()(int i3d, int i2d) const { return -arg(i3d, i2d); }
 
-  /// Type of the resulting expression
-  using type = typename PromoteType<ltype, rtype>::type;
+  const Field3D* getField3D() const { return arg.getField3D(); }
+  const Field2D* getField2D() const { return arg.getField2D(); }
 
-  BoutReal operator()(int x, int y, int z) const {
-    return BinOp::apply((_expr1)(x, y, z), (_expr2)(x, y, z));
+  template <class T>
+  void check(const T& prototype) const {
+    arg.check(prototype);
   }
 
 private:
-  ltype const _expr1;
-  rtype const _expr2;
+  const Arg arg;
 };
 
-template <typename ExprT1, typename ExprT2, class name>
-struct BinaryResult {
-  using arg1 = typename asExpr<ExprT1>::type;
-  using arg2 = typename asExpr<ExprT2>::type;
-  using type = BinaryExpr<arg1, arg2, name>;
+/// Is \p T an expression node?
+template <class T>
+struct is_expr : std::false_type {};
+template <>
+struct is_expr<Field3DLeaf> : std::true_type {};
+template <>
+struct is_expr<Field2DLeaf> : std::true_type {};
+template <class Op, class Lhs, class Rhs>
+struct is_expr<BinaryExpr<Op, Lhs, Rhs>> : std::true_type {};
+template <class Arg>
+struct is_expr<NegateExpr<Arg>> : std::true_type {};
+
+/// Convert operands of the arithmetic operators to expression nodes
+template <class T, class Enable = void>
+struct asExpr {};
+
+template <class T>
+struct asExpr<T, std::enable_if_t<is_expr<T>::value>> {
+  using type = T;
+  static const T& get(const T& x) { return x; }
 };
 
-/// Binary operator classes
-
-#define DEFINE_BINARY_OP(name, op)    \
-  struct name {                       \
-    template <typename T>             \
-    static inline T apply(T a, T b) { \
-      return a op b;                  \
-    }                                 \
-  };
+template <>
+struct asExpr<Field3D> {
+  using type = Field3DLeaf;
+  static Field3DLeaf get(const Field3D& x) { return Field3DLeaf{x}; }
+};
 
-DEFINE_BINARY_OP(Add, +)
-DEFINE_BINARY_OP(Subtract, -)
-DEFINE_BINARY_OP(Multiply, *)
-DEFINE_BINARY_OP(Divide, /)
+template <>
+struct asExpr<Field2D> {
+  using type = Field2DLeaf;
+  static Field2DLeaf get(const Field2D& x) { return Field2DLeaf{x}; }
+};
 
-struct Power {
-  template <typename T>
-  static inline T apply(T a, T b) {
-    return pow(a, b);
-  }
+template <class T>
+struct asExpr<T, std::enable_if_t<std::is_arithmetic<T>::value>> {
+  using type = ScalarLeaf;
+  static ScalarLeaf get(T x) { return ScalarLeaf{static_cast<BoutReal>(x)}; }
 };
 
-/// Define functions add, mul which use operator structs
-#define DEFINE_OVERLOAD_FUNC(name, func)                                     \
-  template <typename ExprT1, typename ExprT2>                                \
-  typename BinaryResult<ExprT1, ExprT2, name>::type func(const ExprT1& e1,   \
-                                                         const ExprT2& e2) { \
-    using type = typename BinaryResult<ExprT1, ExprT2, name>::type;          \
-    return type(asExpr<ExprT1>::getExpr(e1), asExpr<ExprT2>::getExpr(e2));   \
+template <class T>
+using asExpr_t = typename asExpr<std::decay_t<T>>::type;
+
+/// Enable the operators below only if at least one argument is
+/// already an expression, so that the eager operators on fields
+/// are not affected
+template <class Lhs, class Rhs>
+using EnableIfExpr = std::enable_if_t<is_expr<std::decay_t<Lhs>>::value
+                                      or is_expr<std::decay_t<Rhs>>::value>;
+
+/// Start an expression from a field
+inline Field3DLeaf lazy(const Field3D& f) { return Field3DLeaf{f}; }
+inline Field2DLeaf lazy(const Field2D& f) { return Field2DLeaf{f}; }
+
+#define DEFINE_EXPR_OPERATOR(name, op)                                            \
+  template <class Lhs, class Rhs, class = EnableIfExpr<Lhs, Rhs>>                 \
+  BinaryExpr<name, asExpr_t<Lhs>, asExpr_t<Rhs>> operator op(const Lhs& lhs,      \
+                                                             const Rhs& rhs) {    \
+    return {asExpr<std::decay_t<Lhs>>::get(lhs), asExpr<std::decay_t<Rhs>>::get(rhs)}; \
   }
 
-/// Addition of two Expressions
-DEFINE_OVERLOAD_FUNC(Add, add);
-/// Multiplication of two Expressions
-DEFINE_OVERLOAD_FUNC(Multiply, mul);
-
-/// A function to evaluate expressions
-template <typename Expr>
-const Field3D eval3D(Expr e) {
-  Field3D result;
-  result.allocate();
-  for (int i = 0; i < bout::globals::mesh->LocalNx; i++) {
-    for (int j = 0; j < bout::globals::mesh->LocalNy; j++) {
-      for (int k = 0; k < bout::globals::mesh->LocalNz; k++) {
-        result(i, j, k) = e(i, j, k);
+DEFINE_EXPR_OPERATOR(Add, +)
+DEFINE_EXPR_OPERATOR(Subtract, -)
+DEFINE_EXPR_OPERATOR(Multiply, *)
+DEFINE_EXPR_OPERATOR(Divide, /)
+
+#undef DEFINE_EXPR_OPERATOR
+
+template <class Arg, class = std::enable_if_t<is_expr<Arg>::value>>
+NegateExpr<Arg> operator-(const Arg& arg) {
+  return NegateExpr<Arg>{arg};
+}
+
+/// Evaluate expression \p e into the existing, allocated Field3D
+/// \p result, over \p region. A single pass is made over memory.
+///
+/// Field2D operands are handled by splitting each contiguous block
+/// of the region into runs of constant (x, y), so that the inner
+/// loop over z can be vectorised.
+template <class Expr, class = std::enable_if_t<is_expr<Expr>::value>>
+void evaluateInto(Field3D& result, const Expr& e, const Region<Ind3D>& region) {
+  BoutReal* out = &result(0, 0, 0);
+  const auto& blocks = region.getBlocks();
+
+  if (Expr::has2D) {
+    const int nz = result.getNz();
+    BOUT_OMP(parallel for schedule(BOUT_OPENMP_SCHEDULE))
+    for (auto block = blocks.cbegin(); block < blocks.cend(); ++block) {
+      int i = block->first.ind;
+      const int iend = block->second.ind;
+      while (i < iend) {
+        const int i2d = i / nz;
+        const int runend = std::min(iend, (i2d + 1) * nz);
+        for (; i < runend; ++i) {
+          out[i] = e(i, i2d);
+        }
+      }
+    }
+  } else {
+    BOUT_OMP(parallel for schedule(BOUT_OPENMP_SCHEDULE))
+    for (auto block = blocks.cbegin(); block < blocks.cend(); ++block) {
+      const int iend = block->second.ind;
+      for (int i = block->first.ind; i < iend; ++i) {
+        out[i] = e(i, 0);
       }
     }
   }
+}
+
+/// Evaluate a Field2D-only expression \p e into \p result over \p region
+template <class Expr, class = std::enable_if_t<is_expr<Expr>::value>>
+void evaluateInto(Field2D& result, const Expr& e, const Region<Ind2D>& region) {
+  static_assert(not Expr::has3D, "Cannot evaluate a 3D expression into a Field2D");
+  BoutReal* out = &result(0, 0);
+  const auto& blocks = region.getBlocks();
+
+  BOUT_OMP(parallel for schedule(BOUT_OPENMP_SCHEDULE))
+  for (auto block = blocks.cbegin(); block < blocks.cend(); ++block) {
+    const int iend = block->second.ind;
+    for (int i = block->first.ind; i < iend; ++i) {
+      out[i] = e(i, i);
+    }
+  }
+}
+
+/// Type of field an expression evaluates to
+template <class Expr>
+using result_t = std::conditional_t<Expr::has3D, Field3D, Field2D>;
+
+namespace detail {
+template <class Expr>
+const Field3D& getPrototype(const Expr& e, std::true_type) {
+  return *e.getField3D();
+}
+template <class Expr>
+const Field2D& getPrototype(const Expr& e, std::false_type) {
+  return *e.getField2D();
+}
+inline void clearParallelSlices(Field3D& f) { f.clearParallelSlices(); }
+inline void clearParallelSlices(Field2D& UNUSED(f)) {}
+} // namespace detail
+
+/// Assign expression \p e to \p result over \p region_name. If
+/// \p result is not allocated, new data is allocated for it, with
+/// meta-data copied from the first field in the expression. Data
+/// shared with other fields is copied before being overwritten.
+///
+/// It is safe for \p result to also appear in \p e
+template <class T, class Expr, class = std::enable_if_t<is_expr<Expr>::value>>
+T& assign(T& result, const Expr& e, const std::string& region_name = "RGN_ALL") {
+  static_assert(std::is_same<T, result_t<Expr>>::value,
+                "Result of expression must be a Field3D, or a Field2D if the "
+                "expression has no Field3D operands");
+  const auto& prototype =
+      detail::getPrototype(e, std::integral_constant<bool, Expr::has3D>{});
+#if CHECK > 0
+  e.check(prototype);
+#endif
+
+  if (result.isAllocated()) {
+    ASSERT1_FIELDS_COMPATIBLE(result, prototype);
+    // Parallel slices are not updated, so would be incorrect
+    detail::clearParallelSlices(result);
+    result.allocate();
+  } else {
+    result = emptyFrom(prototype);
+  }
+
+  evaluateInto(result, e, result.getRegion(region_name));
+
+  checkData(result, region_name);
   return result;
 }
 
+/// Evaluate expression \p e over \p region_name, returning a new
+/// field. Points outside the region are not set.
+template <class Expr, class = std::enable_if_t<is_expr<Expr>::value>>
+result_t<Expr> eval(const Expr& e, const std::string& region_name = "RGN_ALL") {
+  const auto& prototype =
+      detail::getPrototype(e, std::integral_constant<bool, Expr::has3D>{});
+#if CHECK > 0
+  e.check(prototype);
+#endif
+
+  result_t<Expr> result{emptyFrom(prototype)};
+  evaluateInto(result, e, result.getRegion(region_name));
+
+  checkData(result, region_name);
+  return result;
+}
+
+} // namespace expr
+} // namespace bout
+
 #endif // __EXPR_H__
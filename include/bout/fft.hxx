@@ -31,7 +31,10 @@
 #include "bout/dcomplex.hxx"
 #include <bout/array.hxx>
 #include <bout/bout_enum_class.hxx>
+#include <bout/region.hxx>
+#include <bout/utils.hxx>
 
+class Field3D;
 class Options;
 
 BOUT_ENUM_CLASS(FFT_MEASUREMENT_FLAG, estimate, measure, exhaustive);
@@ -73,6 +76,53 @@ void rfft(const BoutReal* in, int length, dcomplex* out);
  */
 void irfft(const dcomplex* in, int length, BoutReal* out);
 
+/*!
+ * Batched version of `rfft`, which transforms \p howmany signals in
+ * one call. This is faster than transforming them one at a time, as
+ * FFTW can use vector instructions across the signals. Large batches
+ * are split between OpenMP threads.
+ *
+ * \param[in] in       Pointer to the first signal. Signal `i` starts
+ *                     at `in + i * in_dist`
+ * \param[in] length   Number of points in each signal
+ * \param[out] out     Pointer to the first output. The transform of
+ *                     signal `i` is written to `out + i * out_dist`
+ * \param[in] howmany  Number of signals
+ * \param[in] in_dist  Distance between the start of each signal
+ * \param[in] out_dist Distance between the start of each output, at
+ *                     least `(length / 2) + 1`
+ */
+void rfft(const BoutReal* in, int length, dcomplex* out, int howmany, int in_dist,
+          int out_dist);
+
+/*!
+ * Batched version of `irfft`, which inverse transforms \p howmany
+ * signals in one call
+ *
+ * \param[in] in       Pointer to the first set of modes. Set `i`
+ *                     starts at `in + i * in_dist`
+ * \param[in] length   Number of points in each real output
+ * \param[out] out     Pointer to the first output. Output `i` is
+ *                     written to `out + i * out_dist`
+ * \param[in] howmany  Number of signals
+ * \param[in] in_dist  Distance between the start of each set of modes,
+ *                     at least `(length / 2) + 1`
+ * \param[in] out_dist Distance between the start of each output
+ */
+void irfft(const dcomplex* in, int length, BoutReal* out, int howmany, int in_dist,
+           int out_dist);
+
+/// FFT in Z of every (x, y) column of \p f in \p region. Row `i` of
+/// the result is the transform of the column at `region[i]`, with
+/// `(f.getNz() / 2) + 1` modes
+Matrix<dcomplex> rfft(const Field3D& f, const Region<Ind2D>& region);
+
+/// Inverse FFT in Z of each row of \p in, as returned by
+/// `rfft(const Field3D&, const Region<Ind2D>&)`, into the column of
+/// \p out at the corresponding index of \p region. Other points in
+/// \p out are unchanged
+void irfft(const Matrix<dcomplex>& in, const Region<Ind2D>& region, Field3D& out);
+
 /*!
  * Discrete Sine Transform
  *
@@ -97,6 +147,11 @@ void fft_init(FFT_MEASUREMENT_FLAG fft_flag);
 /// "fftw_measure". If it is nullptr, use the global `Options` root
 void fft_init(Options* options = nullptr);
 
+/// Save FFTW wisdom to the file given by the `fft:wisdom_file`
+/// option, if set, and free the plans used by this thread. Plans are
+/// created again if needed
+void fft_cleanup();
+
 /// Returns the fft of a real signal \p in using fftw_forward
 Array<dcomplex> rfft(const Array<BoutReal>& in);
 
@@ -284,6 +284,10 @@ private:
   /// Array sizes (from fieldmesh). These are valid only if fieldmesh is not null
   int nx{-1}, ny{-1};
 
+  /// Write to newly allocated data in the same order as BOUT_FOR
+  /// loops, so that memory pages are local to the threads using them
+  void firstTouch();
+
   /// Time-derivative, can be nullptr
   Field2D* deriv{nullptr};
 };
@@ -496,6 +496,10 @@ private:
   /// Internal data array. Handles allocation/freeing of memory
   Array<BoutReal> data;
 
+  /// Write to newly allocated data in the same order as BOUT_FOR
+  /// loops, so that memory pages are local to the threads using them
+  void firstTouch();
+
   /// Time derivative (may be nullptr)
   Field3D* deriv{nullptr};
 
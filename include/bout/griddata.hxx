@@ -31,6 +31,7 @@ class GridDataSource;
 #include "mesh.hxx"
 #include "bout/bout_types.hxx"
 #include "bout/options.hxx"
+#include "bout/options_netcdf.hxx"
 
 #include <bout/field2d.hxx>
 #include <bout/field3d.hxx>
@@ -88,13 +89,20 @@ public:
 
 /// Interface to grid data in a file
 /*!
- * This is a thin wrapper around a DataFormat object. Only needs to implement
+ * This is a thin wrapper around an OptionsNetCDF object. Only needs to implement
  * reading routines.
+ *
+ * Only the attributes, scalars and 1D arrays are read when the file is
+ * opened. Fields are read when requested, and then only the part of
+ * the global array which is needed on this processor
  */
 class GridFile : public GridDataSource {
 public:
   GridFile() = delete;
-  GridFile(std::string gridfilename);
+  /// If \p parallel is true, the file is opened collectively by all
+  /// processors using parallel NetCDF, rather than by each processor
+  /// separately
+  GridFile(std::string gridfilename, bool parallel = false);
   ~GridFile() = default;
 
   bool hasVar(const std::string& name) override;
@@ -127,11 +135,18 @@ public:
   bool hasYBoundaryGuards() override { return grid_yguards > 0; }
 
 private:
+  bout::OptionsNetCDF file;
+  /// Attributes of all variables, and values of scalars and 1D arrays
   Options data;
+  /// Shapes of all variables in the file
+  std::map<std::string, std::vector<int>> shapes;
   std::string filename;
   int grid_yguards{0};
   int ny_inner{0};
 
+  /// Global shape of variable \p name, with scalars having shape {1}
+  std::vector<int> getShape(const std::string& name) const;
+
   bool readgrid_3dvar_fft(Mesh* m, const std::string& name, int yread, int ydest,
                           int ysize, int xread, int xdest, int xsize, Field3D& var);
 
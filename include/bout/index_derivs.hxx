@@ -122,6 +122,10 @@ public:
   BoutReal apply(const stencil& f) const { return func(f); }
   BoutReal apply(BoutReal v, const stencil& f) const { return func(v, f); }
   BoutReal apply(const stencil& v, const stencil& f) const { return func(v, f); }
+
+  /// Single point versions, for `DerivativeStore::StencilKernel`
+  static BoutReal standardKernel(const stencil& f) { return func(f); }
+  static BoutReal upwindKernel(BoutReal v, const stencil& f) { return func(v, f); }
 };
 
 // Redundant definitions because C++
@@ -131,11 +135,44 @@ constexpr FF DerivativeType<FF>::func;
 template <class FF>
 constexpr metaData DerivativeType<FF>::meta;
 
+/// Some helper defines for now that allow us to wrap up enums
+/// and the specific methods.
+#define WRAP_ENUM(family, value) enumWrapper<family, family::value>
+
 /////////////////////////////////////////////////////////////////////////////////
 /// Following code is for dealing with registering a method/methods for all
 /// template combinations, in conjunction with the template_combinations code.
 /////////////////////////////////////////////////////////////////////////////////
 
+/// Methods which aren't stencil-based (or are staggered) don't have
+/// a stencil kernel
+template <typename FieldType, typename Direction, typename Stagger, typename Method>
+void registerStencilKernel(DerivativeStore<FieldType>& UNUSED(derivativeRegister),
+                           Direction, Stagger, Method) {}
+
+template <typename FieldType, typename Direction, typename FF>
+void registerStencilKernel(DerivativeStore<FieldType>& derivativeRegister,
+                           Direction direction, WRAP_ENUM(STAGGER, None),
+                           DerivativeType<FF> method) {
+  typename DerivativeStore<FieldType>::StencilKernel kernel;
+  kernel.nGuards = method.meta.nGuards;
+
+  switch (method.meta.derivType) {
+  case (DERIV::Standard):
+  case (DERIV::StandardSecond):
+  case (DERIV::StandardFourth):
+    kernel.standard = &DerivativeType<FF>::standardKernel;
+    break;
+  case (DERIV::Upwind):
+    kernel.upwind = &DerivativeType<FF>::upwindKernel;
+    break;
+  default:
+    return;
+  }
+  derivativeRegister.registerStencilKernel(kernel, method.meta.derivType,
+                                           direction.lookup(), method.meta.key);
+}
+
 struct registerMethod {
   template <typename Direction, typename Stagger, typename FieldTypeContainer,
             typename Method>
@@ -211,6 +248,64 @@ struct registerMethod {
     default:
       throw BoutException("Unhandled derivative method in registerMethod.");
     };
+
+    registerStencilKernel(derivativeRegister, Direction{}, Stagger{}, method);
+  }
+};
+
+/// Calculates the second derivative with the \p Second functor and
+/// the first derivative with the \p First functor in one pass. Both
+/// are known at compile time so, unlike the general
+/// `fusedDerivatives` loop over `StencilKernel`s, they can be inlined
+/// and the loop vectorised
+template <typename Second, typename First>
+struct FusedPairDerivativeType {
+  template <DIRECTION direction, int nGuards, typename T>
+  void fused(const T& var, T& second, T& first, const std::string& region) const {
+    AUTO_TRACE();
+    ASSERT2(var.getMesh()->getNguard(direction) >= nGuards);
+
+    const Second secondFunc{};
+    const First firstFunc{};
+    BOUT_FOR(i, var.getRegion(region)) {
+      const auto s = populateStencil<direction, STAGGER::None, nGuards>(var, i);
+      second[i] = secondFunc(s);
+      first[i] = firstFunc(s);
+    }
+  }
+};
+
+/// Register a `FusedPairDerivativeType` for each combination of
+/// direction, field type, second and first derivative method
+struct registerFusedPair {
+  template <typename Direction, typename FieldTypeContainer, typename Second,
+            typename First>
+  void operator()(Direction, FieldTypeContainer, Second, First) {
+    AUTO_TRACE();
+    using namespace std::placeholders;
+    using FieldType = typename FieldTypeContainer::type;
+    using Pair = FusedPairDerivativeType<Second, First>;
+
+    static_assert(Second::meta.derivType == DERIV::StandardSecond
+                      and First::meta.derivType == DERIV::Standard,
+                  "registerFusedPair needs a second and a first derivative method");
+
+    auto& derivativeRegister = DerivativeStore<FieldType>::getInstance();
+
+    const int nGuards = (Second::meta.nGuards > First::meta.nGuards)
+                            ? Second::meta.nGuards
+                            : First::meta.nGuards;
+    if (nGuards == 1) {
+      derivativeRegister.registerFusedPair(
+          std::bind(&Pair::template fused<Direction::value, 1, FieldType>, Pair{}, _1,
+                    _2, _3, _4),
+          Direction{}.lookup(), Second::meta.key, First::meta.key);
+    } else {
+      derivativeRegister.registerFusedPair(
+          std::bind(&Pair::template fused<Direction::value, 2, FieldType>, Pair{}, _1,
+                    _2, _3, _4),
+          Direction{}.lookup(), Second::meta.key, First::meta.key);
+    }
   }
 };
 
@@ -262,10 +357,6 @@ struct registerMethod {
 #define DEFINE_FLUX_DERIV_STAGGERED(name, key, nGuards, type) \
   DEFINE_FLUX_DERIV(name, key, nGuards, type)
 
-/// Some helper defines for now that allow us to wrap up enums
-/// and the specific methods.
-#define WRAP_ENUM(family, value) enumWrapper<family, family::value>
-
 #define REGISTER_DERIVATIVE(name)                                                      \
   namespace {                                                                          \
   produceCombinations<Set<WRAP_ENUM(DIRECTION, X), WRAP_ENUM(DIRECTION, Y),            \
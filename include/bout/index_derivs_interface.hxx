@@ -33,6 +33,12 @@
 #include <bout/bout_types.hxx>
 #include <bout/deriv_store.hxx>
 #include <bout/msg_stack.hxx>
+#include <bout/region.hxx>
+#include <bout/stencils.hxx>
+#include <bout/unused.hxx>
+
+#include <algorithm>
+#include <vector>
 
 class Field3D;
 class Field2D;
@@ -106,6 +112,37 @@ T flowDerivative(const T& vel, const T& f, CELL_LOC outloc, const std::string& m
   return result;
 }
 
+/// Can the parallel transform calculate the \p derivType Y derivative
+/// of \p f, which is not field aligned, without transforming \p f to
+/// field-aligned coordinates? See `ParallelTransform::canFusedYDerivative`
+bool canFusedYDerivative(const Field3D& f, DERIV derivType, CELL_LOC outloc,
+                         const std::string& method, const std::string& region);
+
+/// Calculate the \p derivType Y derivative of \p f with the parallel
+/// transform. Only valid if `canFusedYDerivative` is true
+Field3D fusedYDerivative(const Field3D& f, DERIV derivType, const std::string& method,
+                         const std::string& region);
+
+/// Weights of the points at offsets -n, ..., n in the central finite
+/// difference \p method ("C2" or "C4") for \p derivType, taken from
+/// the registered stencils. Empty if not a supported central difference
+std::vector<BoutReal> centralDifferenceWeights(DERIV derivType,
+                                               const std::string& method);
+
+/// Other types of field are never transformed
+template <typename T>
+bool canFusedYDerivative(const T& UNUSED(f), DERIV UNUSED(derivType),
+                         CELL_LOC UNUSED(outloc), const std::string& UNUSED(method),
+                         const std::string& UNUSED(region)) {
+  return false;
+}
+
+template <typename T>
+T fusedYDerivative(const T& UNUSED(f), DERIV UNUSED(derivType),
+                   const std::string& UNUSED(method), const std::string& UNUSED(region)) {
+  throw BoutException("fusedYDerivative only implemented for Field3D");
+}
+
 /// The main kernel used for all standard derivatives
 template <typename T, DIRECTION direction, DERIV derivType>
 T standardDerivative(const T& f, CELL_LOC outloc, const std::string& method,
@@ -168,6 +205,155 @@ T standardDerivative(const T& f, CELL_LOC outloc, const std::string& method,
   return result;
 }
 
+/// One of the derivatives calculated by `fusedDerivatives`
+template <typename T>
+struct FusedDerivative {
+  /// One of Standard, StandardSecond, StandardFourth or Upwind
+  DERIV derivType;
+  /// Field to put the result in
+  T* result;
+  /// The velocity, only used for Upwind derivatives
+  const T* velocity{nullptr};
+  /// The method to use
+  std::string method{"DEFAULT"};
+};
+
+namespace detail {
+/// Calculate one of \p derivatives of \p f on its own
+template <typename T, DIRECTION direction>
+T separateDerivative(const T& f, const FusedDerivative<T>& derivative,
+                     const std::string& region);
+
+/// Calculate all the \p derivatives of \p f with their \p kernels,
+/// populating the stencil once per point. The kernels are called
+/// through pointers, so can't be inlined
+template <DIRECTION direction, int nGuards, typename T, typename Kernel>
+void fusedDerivativesLoop(const T& f, const std::vector<FusedDerivative<T>>& derivatives,
+                          const std::vector<Kernel>& kernels,
+                          const std::string& region) {
+  const auto nderivs = derivatives.size();
+  BOUT_FOR(i, f.getRegion(region)) {
+    const auto s = populateStencil<direction, STAGGER::None, nGuards>(f, i);
+    for (std::size_t k = 0; k < nderivs; ++k) {
+      const auto& derivative = derivatives[k];
+      (*derivative.result)[i] = (derivative.velocity == nullptr)
+                                    ? kernels[k].standard(s)
+                                    : kernels[k].upwind((*derivative.velocity)[i], s);
+    }
+  }
+}
+} // namespace detail
+
+/// Calculate several \p derivatives of \p f in the same \p direction
+/// together, at the location of \p f. This is equivalent to calling
+/// `standardDerivative` or `flowDerivative` for each one, but the
+/// stencil-based methods are all calculated in one pass over \p
+/// region which reads the stencil of \p f once per point. Any others
+/// (staggered velocities, or methods such as FFT) are calculated
+/// separately. A second and a first derivative together use a loop
+/// with both kernels inlined, if that pair of methods was registered
+/// with `registerFusedPair`. The results must not be \p f or any of
+/// the velocities.
+///
+/// As for `standardDerivative`, Y derivatives of \p f must already be
+/// field aligned, or use DIRECTION::YOrthogonal with parallel slices.
+template <typename T, DIRECTION direction>
+void fusedDerivatives(const T& f, const std::vector<FusedDerivative<T>>& derivatives,
+                      const std::string& region = "RGN_NOBNDRY") {
+  AUTO_TRACE();
+
+  static_assert(bout::utils::is_Field2D<T>::value || bout::utils::is_Field3D<T>::value,
+                "fusedDerivatives only works on Field2D or Field3D input");
+
+  auto* localmesh = f.getMesh();
+
+  ASSERT1(f.isAllocated());
+  {
+    TRACE("Checking input");
+    checkData(f);
+  }
+
+  const auto& store = DerivativeStore<T>::getInstance();
+  using Kernel = typename DerivativeStore<T>::StencilKernel;
+
+  // Check for early exit
+  if (localmesh->getNpoints(direction) == 1) {
+    for (const auto& derivative : derivatives) {
+      *derivative.result = zeroFrom(f);
+    }
+    return;
+  }
+
+  std::vector<FusedDerivative<T>> fused;
+  std::vector<Kernel> kernels;
+  int nGuards = 1;
+  for (const auto& derivative : derivatives) {
+    // The results are allocated before the loop, so can't be any of the inputs
+    ASSERT1(derivative.result != nullptr);
+    ASSERT1(derivative.result != &f);
+    const bool is_upwind = (derivative.derivType == DERIV::Upwind);
+    if (is_upwind) {
+      ASSERT1(derivative.velocity != nullptr);
+      ASSERT1(derivative.velocity->getMesh() == localmesh);
+      ASSERT1(derivative.velocity->isAllocated());
+    }
+
+    const auto kernel = store.getStencilKernel(derivative.method, direction,
+                                               derivative.derivType);
+    const bool can_fuse =
+        kernel.isValid()
+        and (not is_upwind or derivative.velocity->getLocation() == f.getLocation())
+        and kernel.nGuards <= localmesh->getNguard(direction);
+    if (not can_fuse) {
+      *derivative.result = detail::separateDerivative<T, direction>(f, derivative, region);
+      continue;
+    }
+
+    if (is_upwind) {
+      TRACE("Checking velocity");
+      checkData(*derivative.velocity);
+    }
+    *derivative.result = emptyFrom(f);
+    fused.push_back(derivative);
+    kernels.push_back(kernel);
+    nGuards = std::max(nGuards, kernel.nGuards);
+  }
+
+  if (fused.empty()) {
+    return;
+  }
+
+  // A second and first derivative pair may have been compiled into
+  // its own loop, with both kernels inlined
+  typename DerivativeStore<T>::fusedPairFunc pair;
+  if (fused.size() == 2) {
+    const std::size_t second = (fused[0].derivType == DERIV::StandardSecond) ? 0 : 1;
+    const std::size_t first = 1 - second;
+    if (fused[second].derivType == DERIV::StandardSecond
+        and fused[first].derivType == DERIV::Standard) {
+      pair = store.getFusedPair(fused[second].method, fused[first].method, direction);
+      if (pair) {
+        pair(f, *fused[second].result, *fused[first].result, region);
+      }
+    }
+  }
+
+  if (not pair) {
+    if (nGuards == 1) {
+      detail::fusedDerivativesLoop<direction, 1>(f, fused, kernels, region);
+    } else {
+      detail::fusedDerivativesLoop<direction, 2>(f, fused, kernels, region);
+    }
+  }
+
+  {
+    TRACE("Checking result");
+    for (const auto& derivative : fused) {
+      checkData(*derivative.result);
+    }
+  }
+}
+
 ////// STANDARD OPERATORS
 
 ////////////// X DERIVATIVE /////////////////
@@ -206,6 +392,10 @@ T DDY(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "D
                                                                           method, region);
   } else {
     const bool is_unaligned = (f.getDirectionY() == YDirectionType::Standard);
+    if (is_unaligned
+        and canFusedYDerivative(f, DERIV::Standard, outloc, method, region)) {
+      return fusedYDerivative(f, DERIV::Standard, method, region);
+    }
     const T f_aligned = is_unaligned ? toFieldAligned(f, "RGN_NOX") : f;
     T result = standardDerivative<T, DIRECTION::Y, DERIV::Standard>(f_aligned, outloc,
                                                                     method, region);
@@ -223,6 +413,10 @@ T D2DY2(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method =
         f, outloc, method, region);
   } else {
     const bool is_unaligned = (f.getDirectionY() == YDirectionType::Standard);
+    if (is_unaligned
+        and canFusedYDerivative(f, DERIV::StandardSecond, outloc, method, region)) {
+      return fusedYDerivative(f, DERIV::StandardSecond, method, region);
+    }
     const T f_aligned = is_unaligned ? toFieldAligned(f, "RGN_NOX") : f;
     T result = standardDerivative<T, DIRECTION::Y, DERIV::StandardSecond>(
         f_aligned, outloc, method, region);
@@ -400,6 +594,31 @@ T FDDZ(const T& vel, const T& f, CELL_LOC outloc = CELL_DEFAULT,
   return flowDerivative<T, DIRECTION::Z, DERIV::Flux>(vel, f, outloc, method, region);
 }
 
+namespace detail {
+template <typename T, DIRECTION direction>
+T separateDerivative(const T& f, const FusedDerivative<T>& derivative,
+                     const std::string& region) {
+  switch (derivative.derivType) {
+  case DERIV::Standard:
+    return standardDerivative<T, direction, DERIV::Standard>(f, CELL_DEFAULT,
+                                                             derivative.method, region);
+  case DERIV::StandardSecond:
+    return standardDerivative<T, direction, DERIV::StandardSecond>(
+        f, CELL_DEFAULT, derivative.method, region);
+  case DERIV::StandardFourth:
+    return standardDerivative<T, direction, DERIV::StandardFourth>(
+        f, CELL_DEFAULT, derivative.method, region);
+  case DERIV::Upwind:
+    return flowDerivative<T, direction, DERIV::Upwind>(
+        *derivative.velocity, f, CELL_DEFAULT, derivative.method, region);
+  default:
+    throw BoutException("fusedDerivatives only works for derivType in {{Standard, "
+                        "StandardSecond, StandardFourth, Upwind}} but received {:s}",
+                        toString(derivative.derivType));
+  }
+}
+} // namespace detail
+
 } // Namespace index
 } // Namespace derivatives
 } // Namespace bout
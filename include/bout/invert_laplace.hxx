@@ -50,6 +50,8 @@ class Laplacian;
 
 #include "bout/dcomplex.hxx"
 
+#include <vector>
+
 class Solver;
 
 constexpr auto LAPLACE_SPT = "spt";
@@ -234,9 +236,24 @@ public:
     setCoefEz(f);
   }
 
-  virtual void setGlobalFlags(int f) { global_flags = f; }
-  virtual void setInnerBoundaryFlags(int f) { inner_boundary_flags = f; }
-  virtual void setOuterBoundaryFlags(int f) { outer_boundary_flags = f; }
+  virtual void setGlobalFlags(int f) {
+    global_flags = f;
+    coefficientsChanged();
+  }
+  virtual void setInnerBoundaryFlags(int f) {
+    inner_boundary_flags = f;
+    coefficientsChanged();
+  }
+  virtual void setOuterBoundaryFlags(int f) {
+    outer_boundary_flags = f;
+    coefficientsChanged();
+  }
+
+  /// Incremented every time the coefficients or flags are changed.
+  /// Solvers can compare this with its value when they last built
+  /// their matrices, and skip building them again if only the RHS
+  /// has changed
+  int coefficientGeneration() const { return coefficient_generation; }
 
   /// Does this solver use Field3D coefficients (true) or only their DC component (false)
   virtual bool uses3DCoefs() const { return false; }
@@ -251,6 +268,15 @@ public:
   virtual Field3D solve(const Field3D& b, const Field3D& x0);
   virtual Field2D solve(const Field2D& b, const Field2D& x0);
 
+  /// Solve for several right-hand sides \p b, which share the same
+  /// coefficients. By default each is solved separately, but solvers
+  /// can override this to solve them together
+  virtual std::vector<Field3D> solve(const std::vector<Field3D>& b);
+  /// Solve for several right-hand sides \p b, with the values in \p
+  /// x0 used to set boundary conditions
+  virtual std::vector<Field3D> solve(const std::vector<Field3D>& b,
+                                     const std::vector<Field3D>& x0);
+
   /// Coefficients in tridiagonal inversion
   void tridagCoefs(int jx, int jy, int jz, dcomplex& a, dcomplex& b, dcomplex& c,
                    const Field2D* ccoef = nullptr, const Field2D* d = nullptr,
@@ -333,6 +359,17 @@ protected:
                     int outer_boundary_flags, const Field2D* a, const Field2D* c1coef,
                     const Field2D* c2coef, const Field2D* d, bool includeguards = true,
                     bool zperiodic = true);
+  /// Apply the boundary conditions to the RHS \p bk of a tridiagonal
+  /// system, in the same way as `tridagMatrix`. Used when the matrix
+  /// from a previous call to `tridagMatrix` is reused
+  void tridagRHS(dcomplex* bk, int kz, int flags, int inner_boundary_flags,
+                 int outer_boundary_flags, bool includeguards = true,
+                 bool zperiodic = true);
+
+  /// Record that the coefficients have changed, so that matrices
+  /// built from the old ones are out of date
+  void coefficientsChanged() { ++coefficient_generation; }
+
   CELL_LOC location;   ///< staggered grid location of this solver
   Mesh* localmesh;     ///< Mesh object for this solver
   Coordinates* coords; ///< Coordinates object, so we only have to call
@@ -341,6 +378,8 @@ protected:
 private:
   /// Singleton instance
   static std::unique_ptr<Laplacian> instance;
+  /// Number of changes to the coefficients, see `coefficientGeneration`
+  int coefficient_generation{0};
   /// Name for writing performance infomation; default taken from
   /// constructing `Options` section
   std::string performance_name;
@@ -295,6 +295,88 @@ public:
   /// @param g  The group of fields to communicate. Guard cells will be modified
   void communicateYZ(FieldGroup& g);
 
+  /// Start communicating guard cells of a list of FieldData objects,
+  /// without waiting for the communication to finish. Must be
+  /// followed by a call to finishCommunicate() with the same fields.
+  ///
+  /// In between, calculations which don't depend on guard cells can
+  /// be overlapped with the communication, for example by iterating
+  /// over the "RGN_NOBNDRY_INTERIOR" region. The remaining points in
+  /// "RGN_NOBNDRY_SHELL" can be calculated after finishCommunicate():
+  ///
+  ///     auto handle = mesh->startCommunicate(n, phi);
+  ///     BOUT_FOR(i, mesh->getRegion("RGN_NOBNDRY_INTERIOR")) { ... }
+  ///     mesh->finishCommunicate(handle, n, phi);
+  ///     BOUT_FOR(i, mesh->getRegion("RGN_NOBNDRY_SHELL")) { ... }
+  template <typename... Ts>
+  comm_handle startCommunicate(Ts&... ts) {
+    FieldGroup g(ts...);
+    return startCommunicate(g);
+  }
+
+  /// Wait for a communication started by startCommunicate() to
+  /// finish. The fields must be the same as those passed to
+  /// startCommunicate()
+  template <typename... Ts>
+  void finishCommunicate(comm_handle handle, Ts&... ts) {
+    FieldGroup g(ts...);
+    finishCommunicate(handle, g);
+  }
+
+  /// Start communicating a group of fields. Returns a handle to be
+  /// passed to finishCommunicate()
+  ///
+  /// If include_corner_cells is true, only the y-communication is
+  /// started here, as the x-communication must include the y-guard
+  /// cells and so can only be started once that has finished.
+  comm_handle startCommunicate(FieldGroup& g);
+
+  /// Finish communicating a group of fields, started with
+  /// startCommunicate(). Calculates the parallel slices of 3D fields
+  /// if calcParallelSlices_on_communicate is set, as communicate() does
+  void finishCommunicate(comm_handle handle, FieldGroup& g);
+
+  /// Create a plan for communicating the same fields many times, for
+  /// example every timestep. Setting up the communication is done
+  /// once here, rather than on every communicate() call:
+  ///
+  ///     auto plan = mesh->createCommPlan(n, phi);
+  ///     ...
+  ///     mesh->communicate(plan); // In the RHS function
+  ///     ...
+  ///     mesh->freeCommPlan(plan);
+  ///
+  /// The fields must not be destroyed while the plan is in use, but
+  /// may be assigned to. The plan must be freed with freeCommPlan()
+  template <typename... Ts>
+  comm_handle createCommPlan(Ts&... ts) {
+    FieldGroup g(ts...);
+    return createCommPlan(g);
+  }
+
+  /// Create a plan for communicating a group of fields
+  ///
+  /// The default implementation just stores the fields, and calls
+  /// startCommunicate() and finishCommunicate()
+  virtual comm_handle createCommPlan(FieldGroup& g);
+
+  /// Start communicating the fields in \p plan. Must be followed by a
+  /// call to finishCommPlan(). This works like startCommunicate()
+  virtual void startCommPlan(comm_handle plan);
+
+  /// Wait for the communication started by startCommPlan() to finish
+  virtual void finishCommPlan(comm_handle plan);
+
+  /// Release the resources used by \p plan. It must not be used afterwards
+  virtual void freeCommPlan(comm_handle plan);
+
+  /// Communicate the fields in \p plan, waiting for the communication
+  /// to finish. Equivalent to communicate() on the same fields
+  void communicate(comm_handle plan) {
+    startCommPlan(plan);
+    finishCommPlan(plan);
+  }
+
   /*!
    * Communicate an X-Z field
    */
@@ -756,6 +838,12 @@ public:
   /// Creates RGN_{ALL,NOBNDRY,NOX,NOY}
   void createDefaultRegions();
 
+  /// Time loops over each of the default 3D regions with a range of
+  /// block sizes, and keep the fastest for each region. If the OpenMP
+  /// schedule can be set at run time then the fastest schedule is
+  /// also chosen
+  void autotuneRegions();
+
 protected:
   /// Source for grid data
   GridDataSource* source{nullptr};
@@ -788,6 +876,11 @@ public:
   // MAXREGIONBLOCKSIZE in include/bout/region.hxx
   int maxregionblocksize{MAXREGIONBLOCKSIZE};
 
+  /// If true, the default 3D regions are iterated over in tiles of
+  /// region_tile_shape points, see `Region::tile`
+  bool region_tiling{false};
+  RegionTileShape region_tile_shape{};
+
   /// Enable staggered grids (Centre, Lower). Otherwise all vars are
   /// cell centred (default).
   bool StaggerGrids{false};
@@ -806,6 +899,11 @@ private:
   createDefaultCoordinates(const CELL_LOC location,
                            bool force_interpolate_from_centre = false);
 
+  /// Call autotuneRegions when creating the default regions
+  bool autotune_regions{false};
+  /// Number of times each loop is timed when autotuning
+  int autotune_repeats{3};
+
   //Internal region related information
   std::map<std::string, Region<Ind3D>> regionMap3D;
   std::map<std::string, Region<Ind2D>> regionMap2D;
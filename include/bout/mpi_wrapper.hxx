@@ -87,6 +87,10 @@ public:
                          recvtype, root, comm);
   }
 
+  virtual int MPI_Get_address(const void* location, MPI_Aint* address) {
+    return ::MPI_Get_address(location, address);
+  }
+
   virtual int MPI_Group_union(MPI_Group group1, MPI_Group group2, MPI_Group* newgroup) {
     return ::MPI_Group_union(group1, group2, newgroup);
   }
@@ -108,6 +112,15 @@ public:
     return ::MPI_Recv(buf, count, datatype, source, tag, comm, status);
   }
 
+  virtual int MPI_Recv_init(void* buf, int count, MPI_Datatype datatype, int source,
+                            int tag, MPI_Comm comm, MPI_Request* request) {
+    return ::MPI_Recv_init(buf, count, datatype, source, tag, comm, request);
+  }
+
+  virtual int MPI_Request_free(MPI_Request* request) {
+    return ::MPI_Request_free(request);
+  }
+
   virtual int MPI_Scan(const void* sendbuf, void* recvbuf, int count,
                        MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
     return ::MPI_Scan(sendbuf, recvbuf, count, datatype, op, comm);
@@ -125,10 +138,33 @@ public:
     return ::MPI_Send(buf, count, datatype, dest, tag, comm);
   }
 
+  virtual int MPI_Send_init(const void* buf, int count, MPI_Datatype datatype, int dest,
+                            int tag, MPI_Comm comm, MPI_Request* request) {
+    return ::MPI_Send_init(buf, count, datatype, dest, tag, comm, request);
+  }
+
+  virtual int MPI_Start(MPI_Request* request) { return ::MPI_Start(request); }
+
   virtual int MPI_Type_commit(MPI_Datatype* datatype) {
     return ::MPI_Type_commit(datatype);
   }
 
+  virtual int MPI_Type_create_struct(int count, const int array_of_blocklengths[],
+                                     const MPI_Aint array_of_displacements[],
+                                     const MPI_Datatype array_of_types[],
+                                     MPI_Datatype* newtype) {
+    return ::MPI_Type_create_struct(count, array_of_blocklengths, array_of_displacements,
+                                    array_of_types, newtype);
+  }
+
+  virtual int MPI_Type_create_subarray(int ndims, const int array_of_sizes[],
+                                       const int array_of_subsizes[],
+                                       const int array_of_starts[], int order,
+                                       MPI_Datatype oldtype, MPI_Datatype* newtype) {
+    return ::MPI_Type_create_subarray(ndims, array_of_sizes, array_of_subsizes,
+                                      array_of_starts, order, oldtype, newtype);
+  }
+
   virtual int MPI_Type_free(MPI_Datatype* datatype) { return ::MPI_Type_free(datatype); }
 
   virtual int MPI_Type_vector(int count, int blocklength, int stride,
@@ -39,6 +39,7 @@ class MsgStack;
 #include <cstdarg>
 #include <exception>
 #include <string>
+#include <thread>
 #include <vector>
 
 /// The __PRETTY_FUNCTION__ variable is defined by GCC (and some other families) but is
@@ -64,6 +65,9 @@ class MsgStack;
  * This code is only enabled if CHECK > 1. If CHECK is disabled then this
  * message stack code reverts to empty functions which should be removed by
  * the optimiser
+ *
+ * Only the thread which created the stack can change it: messages from
+ * other threads (for example a background output thread) are ignored
  */
 class MsgStack {
 public:
@@ -105,6 +109,12 @@ public:
 private:
   std::vector<std::string> stack;                  ///< Message stack;
   std::vector<std::string>::size_type position{0}; ///< Position in stack
+#if BOUT_USE_MSGSTACK
+  std::thread::id owner{std::this_thread::get_id()}; ///< Thread which can change stack
+  /// Is this being called from a thread other than `owner`? OpenMP
+  /// threads are handled separately
+  bool isForeignThread() const;
+#endif
 };
 
 /*!
@@ -8,13 +8,18 @@
 
 #if !BOUT_HAS_NETCDF || BOUT_HAS_LEGACY_NETCDF
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include "bout/boutexception.hxx"
 #include "bout/options.hxx"
+#include "bout/unused.hxx"
 
 namespace bout {
 
+class AsyncOptionsWriter;
+
 class OptionsNetCDF {
 public:
   enum class FileMode {
@@ -22,7 +27,10 @@ public:
     append   ///< Append to file when writing
   };
 
-  OptionsNetCDF(const std::string& filename, FileMode mode = FileMode::replace) {}
+  OptionsNetCDF() {}
+  OptionsNetCDF(const std::string& UNUSED(filename),
+                FileMode UNUSED(mode) = FileMode::replace,
+                bool UNUSED(parallel) = false) {}
   OptionsNetCDF(const OptionsNetCDF&) = default;
   OptionsNetCDF(OptionsNetCDF&&) = default;
   OptionsNetCDF& operator=(const OptionsNetCDF&) = default;
@@ -30,9 +38,30 @@ public:
 
   /// Read options from file
   Options read() { throw BoutException("OptionsNetCDF not available\n"); }
+  Options readMetadata() { throw BoutException("OptionsNetCDF not available\n"); }
+  std::map<std::string, std::vector<int>> variableShapes() {
+    throw BoutException("OptionsNetCDF not available\n");
+  }
+  Options readSlab(const std::string& UNUSED(name),
+                   const std::vector<int>& UNUSED(start),
+                   const std::vector<int>& UNUSED(count)) {
+    throw BoutException("OptionsNetCDF not available\n");
+  }
 
   /// Write options to file
-  void write(const Options& options) {
+  void write(const Options& UNUSED(options)) {
+    throw BoutException("OptionsNetCDF not available\n");
+  }
+  void write(const Options& UNUSED(options), const std::string& UNUSED(time_dim)) {
+    throw BoutException("OptionsNetCDF not available\n");
+  }
+
+  void verifyTimesteps() const {}
+
+private:
+  friend class AsyncOptionsWriter;
+  void writeData(const Options& UNUSED(options),
+                 const std::string& UNUSED(time_dim)) {
     throw BoutException("OptionsNetCDF not available\n");
   }
 };
@@ -41,8 +70,10 @@ public:
 
 #else
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "bout/options.hxx"
 
@@ -54,6 +85,8 @@ class NcFile;
 
 namespace bout {
 
+class AsyncOptionsWriter;
+
 class OptionsNetCDF {
 public:
   enum class FileMode {
@@ -64,7 +97,13 @@ public:
   // Constructors need to be defined in implementation due to forward
   // declaration of NcFile
   OptionsNetCDF();
-  explicit OptionsNetCDF(std::string filename, FileMode mode = FileMode::replace);
+  /// If \p parallel is true, then all processors share a single
+  /// file, which must be created, written and read collectively.
+  /// Fields are stored as global arrays, with each processor writing
+  /// or reading its own part. This requires a netCDF library with
+  /// parallel I/O support
+  explicit OptionsNetCDF(std::string filename, FileMode mode = FileMode::replace,
+                         bool parallel = false);
   ~OptionsNetCDF();
   OptionsNetCDF(const OptionsNetCDF&) = delete;
   OptionsNetCDF(OptionsNetCDF&&) noexcept;
@@ -74,6 +113,22 @@ public:
   /// Read options from file
   Options read();
 
+  /// Read the attributes of all variables, but only the values of
+  /// scalars and 1D variables. Larger variables are in the result,
+  /// but are not set; use `readSlab` to read them. Unlike `read`,
+  /// this and the other partial reading methods keep the file open
+  Options readMetadata();
+
+  /// Shapes of all the variables in the root group of the file.
+  /// Scalars have an empty shape
+  std::map<std::string, std::vector<int>> variableShapes();
+
+  /// Read part of a 1D, 2D or 3D variable \p name: \p count elements
+  /// in each dimension, starting at index \p start. The result is an
+  /// Array, Matrix or Tensor with the variable's attributes
+  Options readSlab(const std::string& name, const std::vector<int>& start,
+                   const std::vector<int>& count);
+
   /// Write options to file
   void write(const Options& options) { write(options, "t"); }
   void write(const Options& options, const std::string& time_dim);
@@ -88,8 +143,20 @@ private:
   std::string filename;
   /// How to open the file for writing
   FileMode file_mode{FileMode::replace};
+  /// Is the file shared by all processors?
+  bool parallel{false};
   /// Pointer to netCDF file so we don't introduce direct dependence
   std::unique_ptr<netCDF::NcFile> data_file;
+  /// File opened by the partial reading methods
+  std::unique_ptr<netCDF::NcFile> read_file;
+
+  /// Open `read_file` if it isn't already open
+  netCDF::NcFile& getReadFile();
+
+  friend class AsyncOptionsWriter;
+  /// Implementation of `write`, without timing, so that it can be
+  /// used from `AsyncOptionsWriter`'s thread
+  void writeData(const Options& options, const std::string& time_dim);
 };
 
 } // namespace bout
@@ -99,11 +166,17 @@ private:
 namespace bout {
 /// Name of the directory for restart files
 std::string getRestartDirectoryName(Options& options);
-/// Name of the restart file on this rank
+/// Are restart files shared by all ranks? Set by `restart_files:parallel`
+bool isRestartParallel(Options& options);
+/// Name of the restart file on this rank. If restart files are
+/// parallel, this is the same on all ranks
 std::string getRestartFilename(Options& options);
 /// Name of the restart file on \p rank
 std::string getRestartFilename(Options& options, int rank);
-/// Name of the main output file on this rank
+/// Is the main output file shared by all ranks? Set by `output:parallel`
+bool isOutputParallel(Options& options);
+/// Name of the main output file on this rank. If the output is
+/// parallel, this is the same on all ranks
 std::string getOutputFilename(Options& options);
 /// Name of the main output file on \p rank
 std::string getOutputFilename(Options& options, int rank);
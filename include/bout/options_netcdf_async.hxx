@@ -0,0 +1,126 @@
+#pragma once
+
+#ifndef __OPTIONS_NETCDF_ASYNC_H__
+#define __OPTIONS_NETCDF_ASYNC_H__
+
+#include "bout/options.hxx"
+#include "bout/options_netcdf.hxx"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bout {
+
+/// Make a copy of \p options which doesn't share any data with the
+/// original, so that it is unaffected by later changes to the fields
+/// and arrays in \p options
+Options deepCopy(const Options& options);
+
+/// Writes `Options` to `OptionsNetCDF` files in a background thread,
+/// so that the simulation can continue while the data is written.
+///
+/// Each write takes a snapshot of the options, which is queued and
+/// then written to file in order. If there are already \p max_pending
+/// writes in the queue, `write` waits until there is room, so that
+/// memory use is bounded if the filesystem can't keep up.
+///
+/// Errors in the background thread are rethrown, as a `BoutException`
+/// with the same message, by the next call to `write`,
+/// `verifyTimesteps` or `flush`.
+///
+/// Example:
+///
+///     bout::OptionsNetCDF file("data.nc");
+///     bout::AsyncOptionsWriter writer;
+///     writer.write(file, options); // Returns before the data is written
+///     ...
+///     writer.flush(); // Wait until all data is written
+///
+/// The files must not be used by anything else until `flush` has been
+/// called. As netCDF is not thread safe, no other netCDF files should
+/// be used at the same time either.
+///
+/// Note: this uses a thread, so can't be used with parallel files
+/// unless MPI is initialised with MPI_THREAD_MULTIPLE
+class AsyncOptionsWriter {
+public:
+  explicit AsyncOptionsWriter(std::size_t max_pending = 2);
+  /// Waits for all queued writes to finish. Any error is printed
+  /// rather than thrown, so call `flush` first to check for errors
+  ~AsyncOptionsWriter();
+
+  AsyncOptionsWriter(const AsyncOptionsWriter&) = delete;
+  AsyncOptionsWriter(AsyncOptionsWriter&&) = delete;
+  AsyncOptionsWriter& operator=(const AsyncOptionsWriter&) = delete;
+  AsyncOptionsWriter& operator=(AsyncOptionsWriter&&) = delete;
+
+  /// Queue \p options to be written to \p file. \p file must outlive
+  /// this writer, or be flushed before it is destroyed
+  void write(OptionsNetCDF& file, const Options& options,
+             const std::string& time_dim = "t");
+
+  /// Queue a call to `OptionsNetCDF::verifyTimesteps`, after any
+  /// writes already queued for \p file
+  void verifyTimesteps(const OptionsNetCDF& file);
+
+  /// Wait until all queued operations have finished, and rethrow the
+  /// first error, if any
+  void flush();
+
+  /// Number of operations queued or in progress
+  std::size_t pending();
+
+private:
+  struct Task {
+    /// Run in the background thread
+    std::function<void()> operation;
+    /// Snapshot used by `operation`. Held by pointer so that it is
+    /// never copied or destroyed by the background thread
+    std::unique_ptr<Options> options;
+  };
+
+  /// Maximum number of queued operations
+  std::size_t max_pending;
+
+  std::mutex mutex;
+  /// Signals that a task has been added, or that the thread should stop
+  std::condition_variable task_added;
+  /// Signals that a task has finished
+  std::condition_variable task_done;
+
+  /// Operations waiting to be done. The front task is removed only
+  /// once it is finished
+  std::deque<Task> tasks;
+  /// Snapshots which have been written. These are destroyed by the
+  /// main thread, as the Array store isn't thread safe
+  std::vector<std::unique_ptr<Options>> finished;
+  /// Message of the first error thrown in the background thread. Only
+  /// the message is kept, so that the exception is made again by the
+  /// main thread
+  std::string error;
+  /// Has there been an error in the background thread?
+  bool failed{false};
+  /// Is the thread stopping?
+  bool stopping{false};
+
+  std::thread worker;
+
+  /// Add \p task to the queue, waiting for space if necessary
+  void enqueue(Task task);
+  /// Destroy finished snapshots, and rethrow any error. Must be
+  /// called with `mutex` locked, from the main thread
+  void collect();
+  /// Main loop of the background thread
+  void run();
+};
+
+} // namespace bout
+
+#endif //  __OPTIONS_NETCDF_ASYNC_H__
@@ -62,6 +62,26 @@ public:
 
   virtual bool canToFromFieldAligned() const = 0;
 
+  /// Can the index Y derivative \p derivType of a field which is not
+  /// field aligned be calculated directly by `fusedYDerivative`, using
+  /// the method \p method (not "DEFAULT") on \p region? This is
+  /// faster than transforming to field-aligned coordinates and back
+  virtual bool canFusedYDerivative(DERIV UNUSED(derivType),
+                                   const std::string& UNUSED(method),
+                                   const std::string& UNUSED(region)) const {
+    return false;
+  }
+
+  /// Index Y derivative of \p f, which is not field aligned, on \p
+  /// region. The result is not field aligned either. Only valid if
+  /// `canFusedYDerivative` returns true for the same arguments
+  virtual Field3D fusedYDerivative(const Field3D& UNUSED(f), DERIV UNUSED(derivType),
+                                   const std::string& UNUSED(method),
+                                   const std::string& UNUSED(region)) {
+    throw BoutException("ParallelTransform::fusedYDerivative not implemented in this "
+                        "subclass");
+  }
+
   struct PositionsAndWeights {
     int i, j, k;
     BoutReal weight;
@@ -221,6 +241,17 @@ public:
 
   bool canToFromFieldAligned() const override { return true; }
 
+  /// Central differences (C2 and C4) of first and second
+  /// derivatives on RGN_NOBNDRY or RGN_NOY can be calculated directly
+  bool canFusedYDerivative(DERIV derivType, const std::string& method,
+                           const std::string& region) const override;
+
+  /// Calculates the derivative with a single FFT in Z of each point
+  /// of \p f, by combining the phase shifts for each point in the
+  /// stencil with the finite difference weights
+  Field3D fusedYDerivative(const Field3D& f, DERIV derivType, const std::string& method,
+                           const std::string& region) override;
+
   /// Save zShift to the output
   void outputVars(Options& output_options) override;
 
@@ -304,6 +335,13 @@ private:
    */
   void shiftZ(const BoutReal* in, const dcomplex* phs, BoutReal* out) const;
 
+  /// FFT in Z of every (x, y) point of \p f. The modes of point (x,
+  /// y) are in row `x * LocalNy + y`
+  Matrix<dcomplex> fftColumns(const Field3D& f) const;
+
+  /// Phase shift for the parallel slice with offset \p y_offset
+  const Tensor<dcomplex>& slicePhase(int y_offset) const;
+
   /// Calculate and store the phases for to/from field aligned and for
   /// the parallel slices using zShift
   void cachePhases();
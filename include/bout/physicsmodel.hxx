@@ -43,6 +43,7 @@ class PhysicsModel;
 #include "bout/msg_stack.hxx"
 #include "bout/options.hxx"
 #include "bout/options_netcdf.hxx"
+#include "bout/options_netcdf_async.hxx"
 #include "bout/sys/variant.hxx"
 #include "bout/unused.hxx"
 #include "bout/utils.hxx"
@@ -237,6 +238,11 @@ public:
   /// variables have the correct length
   void finishOutputTimestep() const;
 
+  /// Wait until all output and restart data has been written. Only
+  /// needed if `output:async` is set, otherwise files are written
+  /// immediately
+  void finishOutput();
+
 protected:
   // The init and rhs functions are implemented by user code to specify problem
   /*!
@@ -392,6 +398,10 @@ private:
   bout::OptionsNetCDF restart_file;
   /// Should we write restart files
   bool restart_enabled{true};
+  /// Writes output and restart files in the background, if
+  /// `output:async` is set. Declared after the files so that it is
+  /// destroyed first
+  std::unique_ptr<bout::AsyncOptionsWriter> async_writer{nullptr};
   /// Split operator model?
   bool splitop{false};
   /// Pointer to user-supplied preconditioner function
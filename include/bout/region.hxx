@@ -43,7 +43,10 @@
 #define __REGION_H__
 
 #include <algorithm>
+#include <cstddef>
 #include <ostream>
+#include <string>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -422,6 +425,33 @@ inline std::ostream& operator<<(std::ostream& out, const RegionStats& stats) {
   return out;
 }
 
+/// Number of points in each direction in the tiles used by
+/// `Region::tile`
+struct RegionTileShape {
+  int x{1};
+  int y{1};
+  int z{1};
+};
+
+namespace bout {
+/// Choose a tile shape for an \p nx by \p ny by \p nz box of points,
+/// so that stencils in x and y find their neighbouring values still
+/// in cache. Tiles span all of z if possible, and as many y points as
+/// fit in \p cache_size bytes, which by default is the size of this
+/// machine's level 2 cache
+RegionTileShape defaultRegionTileShape(int nx, int ny, int nz,
+                                       std::size_t cache_size = 0);
+
+/// The OpenMP schedules which BOUT_FOR loops can be switched between
+/// at run time. Empty unless compiled with OpenMP and
+/// BOUT_OPENMP_SCHEDULE=runtime
+std::vector<std::string> runtimeSchedules();
+
+/// Set the OpenMP schedule used by BOUT_FOR loops to one of
+/// `runtimeSchedules()`
+void setRuntimeSchedule(const std::string& schedule);
+} // namespace bout
+
 /// Specifies a set of indices which can be iterated over and begin()
 /// and end() methods for range-based for loops.
 ///
@@ -595,6 +625,52 @@ public:
     indices = getRegionIndices();
   };
 
+  /// Change the order in which BOUT_FOR iterates over this region, so
+  /// that all the points in one tile of \p shape are done before the
+  /// next tile. This keeps neighbouring rows in x and y in cache for
+  /// stencil operations, when rows are too long for that otherwise.
+  /// Only the blocks are changed, so the indices are in the same
+  /// order as before. Operations that create a new Region, such as
+  /// adding or masking, don't keep the tiling
+  Region<T>& tile(const RegionTileShape& shape,
+                  int maxregionblocksize = MAXREGIONBLOCKSIZE) {
+    ASSERT1(shape.x > 0 and shape.y > 0 and shape.z > 0);
+
+    using Tile = std::tuple<int, int, int>;
+    const auto tileOf = [&shape](const T& index) {
+      return Tile{index.x() / shape.x, index.y() / shape.y, index.z() / shape.z};
+    };
+
+    // Split the contiguous blocks where they cross tile boundaries
+    std::vector<std::pair<Tile, ContiguousBlock>> tiled_blocks;
+    for (const auto& block : getContiguousBlocks(maxregionblocksize)) {
+      auto start = block.first;
+      auto start_tile = tileOf(start);
+      for (auto index = block.first; index < block.second; ++index) {
+        const auto index_tile = tileOf(index);
+        if (index_tile != start_tile) {
+          tiled_blocks.push_back({start_tile, {start, index}});
+          start = index;
+          start_tile = index_tile;
+        }
+      }
+      tiled_blocks.push_back({start_tile, {start, block.second}});
+    }
+
+    std::stable_sort(std::begin(tiled_blocks), std::end(tiled_blocks),
+                     [](const std::pair<Tile, ContiguousBlock>& a,
+                        const std::pair<Tile, ContiguousBlock>& b) {
+                       return a.first < b.first;
+                     });
+
+    blocks.clear();
+    blocks.reserve(tiled_blocks.size());
+    for (const auto& tiled_block : tiled_blocks) {
+      blocks.push_back(tiled_block.second);
+    }
+    return *this;
+  }
+
   /// Return a new Region that has the same indices as this one but
   /// ensures the indices are sorted.
   Region<T> asSorted() {
@@ -42,6 +42,7 @@
 #include <utility>
 
 #include "generator_context.hxx"
+#include "generator_program.hxx"
 
 class FieldGenerator;
 using FieldGeneratorPtr = std::shared_ptr<FieldGenerator>;
@@ -81,6 +82,14 @@ public:
   /// this function will be made pure virtual.
   virtual double generate(const bout::generator::Context& ctx);
 
+  /// Add instructions to \p program which calculate the value of
+  /// this generator, returning the register holding the result.
+  ///
+  /// The default calls `generate` at each point. Implementations
+  /// should only override this if the value depends only on x, y, z
+  /// and t, and not on other `Context` parameters
+  virtual int compile(bout::generator::Program& program);
+
   /// Create a string representation of the generator, for debugging output
   virtual std::string str() const { return std::string("?"); }
 };
@@ -211,6 +220,7 @@ public:
       : lhs(std::move(l)), rhs(std::move(r)), op(o) {}
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   double generate(const bout::generator::Context& context) override;
+  int compile(bout::generator::Program& program) override;
 
   std::string str() const override {
     return std::string("(") + lhs->str() + std::string(1, op) + rhs->str()
@@ -232,6 +242,9 @@ public:
   }
 
   double generate(const bout::generator::Context&) override { return value; }
+  int compile(bout::generator::Program& program) override {
+    return program.constant(value);
+  }
   std::string str() const override {
     std::stringstream ss;
     ss << value;
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "bout/bout_types.hxx"
+#include "bout/sys/generator_context.hxx"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class FieldGenerator;
+using FieldGeneratorPtr = std::shared_ptr<FieldGenerator>;
+
+namespace bout {
+namespace generator {
+
+/// A tree of `FieldGenerator`s compiled into a flat list of
+/// instructions, which evaluates the expression at many points at
+/// once.
+///
+/// Each instruction writes its result into its own register, holding
+/// the values for a batch of points, so that each operation is a
+/// simple loop over the batch which the compiler can vectorise.
+/// Operations on constants are done at compile time, and parts of
+/// the expression which don't depend on time are marked so that
+/// their values can be saved and reused (see `SavedValues`).
+///
+/// Generators are compiled by `FieldGenerator::compile`. Generators
+/// which don't implement it are evaluated one point at a time by
+/// calling `FieldGenerator::generate`, so any expression can be
+/// compiled.
+///
+/// Example:
+///
+///     Program program(generator);
+///     program.evaluate(n, x, y, z, t, result, [&](int i) { return Context(...); });
+///
+class Program {
+public:
+  /// Compile the expression \p generator
+  explicit Program(FieldGeneratorPtr generator);
+
+  /// The inputs which are the same for every expression
+  enum class Input { x, y, z, t };
+
+  /// Functions used by `FieldGenerator::compile` to add
+  /// instructions. Each returns the register holding the result.
+  /// If all the arguments are constant, the result is calculated
+  /// immediately and a constant is returned.
+  int constant(BoutReal value);
+  int input(Input which);
+  /// \p op is one of '+', '-', '*', '/' or '^'
+  int binary(char op, int lhs, int rhs);
+  int function(BoutReal (*func)(BoutReal), int arg);
+  int function(BoutReal (*func)(BoutReal, BoutReal), int arg1, int arg2);
+  /// Value of \p gt0 where \p test > 0, otherwise \p lt0. Both
+  /// branches are evaluated at all points
+  int where(int test, int gt0, int lt0);
+  /// Call `generator.generate` at each point
+  int fallback(FieldGenerator& generator);
+
+  /// Is the result the same at all points and times?
+  bool isConstant() const;
+  /// Does the result depend on time? True if any part of the
+  /// expression had to use `fallback`, as this is not known
+  bool dependsOnTime() const;
+  /// Number of instructions
+  std::size_t size() const { return instructions.size(); }
+  /// Are any generators evaluated with `FieldGenerator::generate`,
+  /// and so need a `Context` for each point?
+  bool usesContext() const;
+
+  /// Creates a `Context` for the point with the given index. Only
+  /// used for generators which can't be compiled
+  using ContextFunction = std::function<Context(int)>;
+
+  /// Values of the time-independent parts of the expression at a
+  /// fixed set of points. Filled in the first time it is passed to
+  /// `evaluate`, and then used instead of recalculating them. Must
+  /// only be used with one `Program`, and always the same points
+  struct SavedValues {
+    std::vector<BoutReal> values;
+    int npoints{-1};
+  };
+
+  /// Evaluate the expression at \p npoints points, with coordinates
+  /// (\p x[i], \p y[i], \p z[i]) and time \p t, putting the values
+  /// into \p result[i]. If \p saved is not null, the time-independent
+  /// parts are either saved into it, or read from it if already set
+  void evaluate(int npoints, const BoutReal* x, const BoutReal* y, const BoutReal* z,
+                BoutReal t, BoutReal* result, const ContextFunction& context,
+                SavedValues* saved = nullptr) const;
+
+  /// Number of points evaluated together in each batch
+  static constexpr int batch_size = 128;
+
+private:
+  enum class Op {
+    constant,
+    x,
+    y,
+    z,
+    t,
+    add,
+    subtract,
+    multiply,
+    divide,
+    power,
+    function1,
+    function2,
+    where,
+    fallback
+  };
+
+  struct Instruction {
+    Op op;
+    /// Registers of the arguments
+    int arg1{-1}, arg2{-1}, arg3{-1};
+    BoutReal value{0.0}; ///< For constants
+    BoutReal (*function1)(BoutReal){nullptr};
+    BoutReal (*function2)(BoutReal, BoutReal){nullptr};
+    FieldGenerator* generator{nullptr}; ///< For fallback
+    /// Does the value depend on time, or might it?
+    bool time_dependent{false};
+    /// Index in `SavedValues`, or -1 if not saved
+    int saved_index{-1};
+  };
+
+  /// The expression, which owns the generators used by fallbacks
+  FieldGeneratorPtr root;
+  std::vector<Instruction> instructions;
+  /// Register holding the final result
+  int result_register{-1};
+  /// Time-independent registers which are used by time-dependent
+  /// instructions, or are the result. These are saved in `SavedValues`
+  std::vector<int> saved_registers;
+
+  /// Add \p instruction and return its register
+  int add(Instruction instruction);
+  bool isConstant(int reg) const { return instructions[reg].op == Op::constant; }
+  /// Is the value of \p reg calculated once for all batches, or
+  /// cheap enough to always set?
+  bool isPrecalculated(int reg) const {
+    const Op op = instructions[reg].op;
+    return op == Op::constant or op == Op::x or op == Op::y or op == Op::z;
+  }
+  /// Time dependence of an instruction using these registers
+  bool timeDependent(int reg) const { return instructions[reg].time_dependent; }
+  bool timeDependent(int reg1, int reg2) const {
+    return timeDependent(reg1) or timeDependent(reg2);
+  }
+  /// Evaluate one batch of \p n points starting at \p start.
+  /// \p workspace has `batch_size` values for each register
+  void evaluateBatch(int start, int n, const BoutReal* x, const BoutReal* y,
+                     const BoutReal* z, BoutReal* result,
+                     const ContextFunction& context, SavedValues* saved,
+                     bool use_saved, std::vector<BoutReal>& workspace,
+                     std::vector<const BoutReal*>& registers) const;
+};
+
+} // namespace generator
+} // namespace bout
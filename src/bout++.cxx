@@ -36,6 +36,7 @@ const char DEFAULT_DIR[] = "data";
 #include "bout/boutcomm.hxx"
 #include "bout/boutexception.hxx"
 #include "bout/coordinates_accessor.hxx"
+#include "bout/fft.hxx"
 #include "bout/hyprelib.hxx"
 #include "bout/interpolation_xz.hxx"
 #include "bout/interpolation_z.hxx"
@@ -108,6 +109,31 @@ char get_spin();                     // Produces a spinning bar
 // Return the string "enabled" or "disabled"
 namespace {
 constexpr auto is_enabled(bool enabled) { return enabled ? "enabled" : "disabled"; }
+
+/// Limit the memory held for reuse by each thread, for all the Array
+/// types which are cleaned up in BoutFinalise
+void setArrayStoreLimit(std::size_t bytes) {
+  Array<BoutReal>::setStoreLimit(bytes);
+  Array<dcomplex>::setStoreLimit(bytes);
+  Array<fcmplx>::setStoreLimit(bytes);
+  Array<int>::setStoreLimit(bytes);
+  Array<unsigned long>::setStoreLimit(bytes);
+}
+
+/// Print how often released Array<T> data was reused
+template <typename T>
+void printArrayStoreStats(const std::string& name) {
+  const auto stats = Array<T>::storeStats();
+  if (stats.hits + stats.misses == 0) {
+    return;
+  }
+  constexpr BoutReal mebibyte = 1024. * 1024.;
+  output_info.write(_("\tArray<{:s}>: {:d} reused, {:d} allocated, {:d} freed over "
+                      "limit, {:.1f} MiB held (peak {:.1f} MiB)\n"),
+                    name, stats.hits, stats.misses, stats.evictions,
+                    static_cast<BoutReal>(stats.bytes_held) / mebibyte,
+                    static_cast<BoutReal>(stats.peak_bytes_held) / mebibyte);
+}
 } // namespace
 
 /*!
@@ -190,6 +216,13 @@ int BoutInitialise(int& argc, char**& argv) {
 
     setRunStartInfo(Options::root());
 
+    const BoutReal array_store_limit =
+        Options::root()["memory"]["array_store_limit"]
+            .doc("Maximum MiB of released Array data kept for reuse by each thread. "
+                 "If 0, there is no limit")
+            .withDefault(0.0);
+    setArrayStoreLimit(static_cast<std::size_t>(array_store_limit * 1024 * 1024));
+
     if (MYPE == 0) {
       writeSettingsFile(Options::root(), datadir, settingsfile);
     }
@@ -760,6 +793,16 @@ int BoutFinalise(bool write_settings) {
   // Laplacian inversion
   Laplacian::cleanup();
 
+  // FFT plans, and save FFTW wisdom
+  bout::fft::fft_cleanup();
+
+  output_info.write(_("\nArray memory store:\n"));
+  printArrayStoreStats<BoutReal>("BoutReal");
+  printArrayStoreStats<dcomplex>("dcomplex");
+  printArrayStoreStats<fcmplx>("fcmplx");
+  printArrayStoreStats<int>("int");
+  printArrayStoreStats<unsigned long>("unsigned long");
+
   // Delete field memory
   Array<BoutReal>::cleanup();
   Array<dcomplex>::cleanup();
@@ -101,7 +101,9 @@ Field2D& Field2D::allocate() {
       nx = fieldmesh->LocalNx;
       ny = fieldmesh->LocalNy;
     }
-    data.reallocate(nx * ny);
+    if (data.reallocate(nx * ny)) {
+      firstTouch();
+    }
 #if CHECK > 2
     invalidateGuards(*this);
 #endif
@@ -112,6 +114,15 @@ Field2D& Field2D::allocate() {
   return *this;
 }
 
+void Field2D::firstTouch() {
+#if BOUT_USE_OPENMP
+  // See Field3D::firstTouch
+  if (fieldmesh->hasRegion2D("RGN_ALL")) {
+    BOUT_FOR(i, fieldmesh->getRegion2D("RGN_ALL")) { data[i.ind] = 0.0; }
+  }
+#endif
+}
+
 BOUT_HOST_DEVICE Field2D* Field2D::timeDeriv() {
   if (deriv == nullptr) {
     deriv = new Field2D{emptyFrom(*this)};
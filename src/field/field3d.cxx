@@ -115,7 +115,9 @@ Field3D& Field3D::allocate() {
       ny = fieldmesh->LocalNy;
       nz = fieldmesh->LocalNz;
     }
-    data.reallocate(nx * ny * nz);
+    if (data.reallocate(nx * ny * nz)) {
+      firstTouch();
+    }
 #if CHECK > 2
     invalidateGuards(*this);
 #endif
@@ -126,6 +128,17 @@ Field3D& Field3D::allocate() {
   return *this;
 }
 
+void Field3D::firstTouch() {
+#if BOUT_USE_OPENMP
+  // Pages of memory are placed on the NUMA node of the thread which
+  // first writes to them. Without this they would all be written to
+  // first by whichever thread allocated them
+  if (fieldmesh->hasRegion3D("RGN_ALL")) {
+    BOUT_FOR(i, fieldmesh->getRegion3D("RGN_ALL")) { data[i.ind] = 0.0; }
+  }
+#endif
+}
+
 BOUT_HOST_DEVICE Field3D* Field3D::timeDeriv() {
   if (deriv == nullptr) {
     deriv = new Field3D{emptyFrom(*this)};
@@ -24,8 +24,10 @@
 #include <bout/field_factory.hxx>
 
 #include <cmath>
+#include <vector>
 
 #include <bout/constants.hxx>
+#include <bout/openmpwrap.hxx>
 #include <bout/output.hxx>
 #include <bout/utils.hxx>
 
@@ -80,6 +82,48 @@ private:
 
   FieldGeneratorPtr target;
 };
+
+/// Set all points of \p result, including guard cells, to the value
+/// of \p gen, using a compiled version of the expression
+template <typename T>
+void generateAll(const FieldGeneratorPtr& gen, T& result, CELL_LOC loc, Mesh* localmesh,
+                 BoutReal t) {
+  const bout::generator::Program program(gen);
+
+  const auto& indices = result.getRegion("RGN_ALL").getIndices();
+  const int npoints = static_cast<int>(indices.size());
+
+  // Each coordinate depends on only one index, so calculate them
+  // once for each index value, rather than creating a Context for
+  // every point
+  std::vector<BoutReal> x_index(localmesh->LocalNx), y_index(localmesh->LocalNy),
+      z_index(localmesh->LocalNz);
+  std::vector<bool> x_set(x_index.size()), y_set(y_index.size()), z_set(z_index.size());
+
+  std::vector<BoutReal> x(npoints), y(npoints), z(npoints);
+  for (int i = 0; i < npoints; ++i) {
+    const auto& ind = indices[i];
+    if (not(x_set[ind.x()] and y_set[ind.y()] and z_set[ind.z()])) {
+      const Context ctx(ind, loc, localmesh, t);
+      x_index[ind.x()] = ctx.x();
+      y_index[ind.y()] = ctx.y();
+      z_index[ind.z()] = ctx.z();
+      x_set[ind.x()] = y_set[ind.y()] = z_set[ind.z()] = true;
+    }
+    x[i] = x_index[ind.x()];
+    y[i] = y_index[ind.y()];
+    z[i] = z_index[ind.z()];
+  }
+
+  std::vector<BoutReal> values(npoints);
+  program.evaluate(npoints, x.data(), y.data(), z.data(), t, values.data(),
+                   [&](int i) { return Context(indices[i], loc, localmesh, t); });
+
+  BOUT_OMP(parallel for)
+  for (int i = 0; i < npoints; ++i) {
+    result[indices[i]] = values[i];
+  }
+}
 } // namespace
 
 //////////////////////////////////////////////////////////
@@ -183,9 +227,7 @@ Field2D FieldFactory::create2D(FieldGeneratorPtr gen, Mesh* localmesh, CELL_LOC
   result.allocate();
   result.setLocation(loc);
 
-  BOUT_FOR(i, result.getRegion("RGN_ALL")) {
-    result[i] = gen->generate(Context(i, loc, localmesh, t));
-  };
+  generateAll(gen, result, loc, localmesh, t);
 
   return result;
 }
@@ -215,9 +257,7 @@ Field3D FieldFactory::create3D(FieldGeneratorPtr gen, Mesh* localmesh, CELL_LOC
 
   auto result = Field3D(localmesh).setLocation(loc).setDirectionY(y_direction).allocate();
 
-  BOUT_FOR(i, result.getRegion("RGN_ALL")) {
-    result[i] = gen->generate(Context(i, loc, localmesh, t));
-  };
+  generateAll(gen, result, loc, localmesh, t);
 
   if (transform_from_field_aligned) {
     auto coords = result.getCoordinates();
@@ -267,9 +307,7 @@ FieldPerp FieldFactory::createPerp(FieldGeneratorPtr gen, Mesh* localmesh, CELL_
   auto result =
       FieldPerp(localmesh).setLocation(loc).setDirectionY(y_direction).allocate();
 
-  BOUT_FOR(i, result.getRegion("RGN_ALL")) {
-    result[i] = gen->generate(Context(i, loc, localmesh, t));
-  };
+  generateAll(gen, result, loc, localmesh, t);
 
   if (transform_from_field_aligned) {
     auto coords = result.getCoordinates();
@@ -1,10 +1,12 @@
 
 #include "fieldgenerators.hxx"
 
+#include <bout/build_config.hxx>
 #include <bout/constants.hxx>
 #include <bout/utils.hxx>
 
 using bout::generator::Context;
+using bout::generator::Program;
 
 //////////////////////////////////////////////////////////
 
@@ -45,6 +47,11 @@ BoutReal FieldHeaviside::generate(const Context& ctx) {
   return (gen->generate(ctx) > 0.0) ? 1.0 : 0.0;
 }
 
+int FieldHeaviside::compile(Program& program) {
+  return program.function([](BoutReal value) { return (value > 0.0) ? 1.0 : 0.0; },
+                          gen->compile(program));
+}
+
 //////////////////////////////////////////////////////////
 // Ballooning transform
 // Use a truncated Ballooning transform to enforce periodicity in y and z
@@ -202,3 +209,57 @@ BoutReal FieldTanhHat::generate(const Context& ctx) {
          * (tanh(s * (X->generate(ctx) - (c - 0.5 * w)))
             - tanh(s * (X->generate(ctx) - (c + 0.5 * w))));
 }
+
+//////////////////////////////////////////////////////////
+// Compiled versions of generators defined in the header
+
+int FieldATan::compile(Program& program) {
+  if (B == nullptr) {
+    return program.function([](BoutReal a) { return atan(a); }, A->compile(program));
+  }
+  return program.function([](BoutReal a, BoutReal b) { return atan2(a, b); },
+                          A->compile(program), B->compile(program));
+}
+
+int FieldMin::compile(Program& program) {
+  auto it = input.begin();
+  int result = (*it)->compile(program);
+  for (++it; it != input.end(); ++it) {
+    result = program.function(
+        [](BoutReal current, BoutReal val) { return (val < current) ? val : current; },
+        result, (*it)->compile(program));
+  }
+  return result;
+}
+
+int FieldMax::compile(Program& program) {
+  auto it = input.begin();
+  int result = (*it)->compile(program);
+  for (++it; it != input.end(); ++it) {
+    result = program.function(
+        [](BoutReal current, BoutReal val) { return (val > current) ? val : current; },
+        result, (*it)->compile(program));
+  }
+  return result;
+}
+
+int FieldRound::compile(Program& program) {
+  return program.function(
+      [](BoutReal val) -> BoutReal {
+        if (val > 0.0) {
+          return static_cast<int>(val + 0.5);
+        }
+        return static_cast<int>(val - 0.5);
+      },
+      gen->compile(program));
+}
+
+int FieldWhere::compile(Program& program) {
+  if (bout::build::use_sigfpe) {
+    // The compiled version evaluates both branches everywhere, which
+    // could signal an exception in the branch which isn't used
+    return program.fallback(*this);
+  }
+  return program.where(test->compile(program), gt0->compile(program),
+                       lt0->compile(program));
+}
@@ -50,6 +50,9 @@ public:
   BoutReal generate(const bout::generator::Context& pos) override {
     return Op(gen->generate(pos));
   }
+  int compile(bout::generator::Program& program) override {
+    return program.function(Op, gen->compile(program));
+  }
   std::string str() const override {
     return name + std::string("(") + gen->str() + std::string(")");
   }
@@ -77,6 +80,9 @@ public:
   BoutReal generate(const bout::generator::Context& pos) override {
     return Op(A->generate(pos), B->generate(pos));
   }
+  int compile(bout::generator::Program& program) override {
+    return program.function(Op, A->compile(program), B->compile(program));
+  }
   std::string str() const override {
     return name + std::string("(") + A->str() + "," + B->str() + std::string(")");
   }
@@ -106,6 +112,7 @@ public:
     }
     return atan2(A->generate(pos), B->generate(pos));
   }
+  int compile(bout::generator::Program& program) override;
 
 private:
   FieldGeneratorPtr A, B;
@@ -130,6 +137,7 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(const bout::generator::Context& pos) override;
+  int compile(bout::generator::Program& program) override;
   std::string str() const override {
     return std::string("H(") + gen->str() + std::string(")");
   }
@@ -160,6 +168,7 @@ public:
     }
     return result;
   }
+  int compile(bout::generator::Program& program) override;
 
 private:
   std::list<FieldGeneratorPtr> input;
@@ -187,6 +196,7 @@ public:
     }
     return result;
   }
+  int compile(bout::generator::Program& program) override;
 
 private:
   std::list<FieldGeneratorPtr> input;
@@ -253,6 +263,7 @@ public:
     }
     return static_cast<int>(val - 0.5);
   }
+  int compile(bout::generator::Program& program) override;
 
 private:
   FieldGeneratorPtr gen;
@@ -342,6 +353,7 @@ public:
     }
     return lt0->generate(pos);
   }
+  int compile(bout::generator::Program& program) override;
 
   std::string str() const override {
     return std::string("where(") + test->str() + std::string(",") + gt0->str()
@@ -28,20 +28,26 @@
 #include "bout/build_config.hxx"
 
 #include <bout/fft.hxx>
+#include <bout/field3d.hxx>
 #include <bout/globals.hxx>
 #include <bout/options.hxx>
 #include <bout/unused.hxx>
 
 #if BOUT_HAS_FFTW
+#include <bout/boutcomm.hxx>
 #include <bout/constants.hxx>
 #include <bout/openmpwrap.hxx>
+#include <bout/output.hxx>
 
+#include <algorithm>
 #include <cmath>
 #include <fftw3.h>
-
-#if BOUT_USE_OPENMP
-#include <omp.h>
-#endif // _OPENMP
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
 #else
 #include <bout/boutexception.hxx>
 #endif // BOUT_HAS_FFTW
@@ -53,6 +59,8 @@ namespace fft {
 bool fft_initialised{false};
 /// Should FFTW find an optimised plan by measuring various plans?
 FFT_MEASUREMENT_FLAG fft_measurement_flag{FFT_MEASUREMENT_FLAG::estimate};
+/// File to load FFTW wisdom from, and save it to in `fft_cleanup`
+std::string fft_wisdom_file;
 
 void fft_init(Options* options) {
   if (fft_initialised) {
@@ -66,6 +74,18 @@ void fft_init(Options* options) {
                                   "[estimate], measure, exhaustive")
                              .withDefault(FFT_MEASUREMENT_FLAG::estimate);
 
+  fft_wisdom_file = (*options)["wisdom_file"]
+                        .doc("File to read FFTW wisdom (optimised plans) from at the "
+                             "start, and save it to at the end. Empty for none")
+                        .withDefault(std::string{});
+
+#if BOUT_HAS_FFTW
+  if (not fft_wisdom_file.empty()) {
+    // Missing file is fine: it will be created at the end of the run
+    fftw_import_wisdom_from_filename(fft_wisdom_file.c_str());
+  }
+#endif
+
   fft_init(fft_measurement_flag);
 }
 
@@ -83,6 +103,193 @@ unsigned int get_measurement_flag(FFT_MEASUREMENT_FLAG fft_measurement_flag) {
     throw BoutException("Error, unimplemented fft_measurement_flag");
   }
 }
+
+/// FFTW's planner is not thread safe, so creating and destroying
+/// plans must hold this lock. Executing plans is thread safe
+std::mutex& plannerMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// The transforms which we have plans for
+enum class PlanKind {
+  r2c,    ///< Real to complex, used by rfft
+  c2r,    ///< Complex to real, used by irfft
+  dst,    ///< Real to complex of size 2 * (length - 1), used by DST
+  dst_rev ///< Complex to real of size 2 * (length - 1), used by DST_rev
+};
+
+/// An FFTW plan, along with the input and output arrays it transforms.
+/// Real and complex transforms are done on \p howmany signals at
+/// once, stored one after another in the arrays
+class Plan {
+public:
+  Plan(PlanKind kind, int length, int howmany) {
+    std::lock_guard<std::mutex> lock(plannerMutex());
+
+    fft_init();
+    const auto flags = get_measurement_flag(fft_measurement_flag);
+
+    // NOTE: Only the non-redundant output is given, i.e. the offset
+    // and the positive frequencies (so no mirroring around the
+    // Nyquist frequency)
+    const int nmodes = (length / 2) + 1;
+
+    switch (kind) {
+    case PlanKind::r2c:
+      real = allocate<double>(length * howmany);
+      complex = allocate<fftw_complex>(nmodes * howmany);
+      plan = fftw_plan_many_dft_r2c(1, &length, howmany, real, nullptr, 1, length,
+                                    complex, nullptr, 1, nmodes, flags);
+      break;
+    case PlanKind::c2r:
+      complex = allocate<fftw_complex>(nmodes * howmany);
+      real = allocate<double>(length * howmany);
+      plan = fftw_plan_many_dft_c2r(1, &length, howmany, complex, nullptr, 1, nmodes,
+                                    real, nullptr, 1, length, flags);
+      break;
+    case PlanKind::dst:
+      ASSERT1(howmany == 1);
+      // Could be optimized better
+      real = allocate<double>(2 * length);
+      complex = allocate<fftw_complex>(2 * length);
+      plan = fftw_plan_dft_r2c_1d(2 * (length - 1), real, complex, flags);
+      break;
+    case PlanKind::dst_rev:
+      ASSERT1(howmany == 1);
+      complex = allocate<fftw_complex>(2 * (length - 1));
+      real = allocate<double>(2 * (length - 1));
+      plan = fftw_plan_dft_c2r_1d(2 * (length - 1), complex, real, flags);
+      break;
+    }
+  }
+
+  ~Plan() {
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    fftw_destroy_plan(plan);
+    fftw_free(real);
+    fftw_free(complex);
+  }
+
+  Plan(const Plan&) = delete;
+  Plan& operator=(const Plan&) = delete;
+
+  /// Transform `real` into `complex` or vice versa
+  void execute() { fftw_execute(plan); }
+
+  double* real{nullptr};
+  fftw_complex* complex{nullptr};
+
+private:
+  fftw_plan plan{nullptr};
+
+  template <typename T>
+  static T* allocate(int size) {
+    return static_cast<T*>(fftw_malloc(sizeof(T) * size));
+  }
+};
+
+/// Plans for each kind, length and batch size of transform. Each
+/// thread has its own plans, so that they can be executed at the
+/// same time. The arrays are allocated with fftw_malloc, so are
+/// always aligned, and plans don't depend on the alignment of the
+/// user's data
+thread_local std::map<std::tuple<PlanKind, int, int>, std::unique_ptr<Plan>> plan_cache;
+
+/// Get the plan for \p howmany transforms \p kind of size \p length,
+/// creating it the first time it is used in this thread
+Plan& getPlan(PlanKind kind, int length, int howmany = 1) {
+  auto& plan = plan_cache[std::make_tuple(kind, length, howmany)];
+  if (not plan) {
+    plan = std::make_unique<Plan>(kind, length, howmany);
+  }
+  return *plan;
+}
+
+/// Maximum number of signals transformed by one batched plan. Larger
+/// batches are split into chunks of this size, which keeps the plan
+/// arrays small enough to stay in cache, and lets the chunks be
+/// shared between OpenMP threads
+constexpr int max_batch_size = 64;
+
+/// Forward transform of \p howmany signals of \p length points. The
+/// i'th signal is read from `input(i)` and its normalised transform
+/// written to `output(i)`
+template <typename InputFunc, typename OutputFunc>
+void rfftBatch(int length, int howmany, InputFunc input, OutputFunc output) {
+  auto& plan = getPlan(PlanKind::r2c, length, howmany);
+  const int nmodes = (length / 2) + 1;
+
+  for (int i = 0; i < howmany; i++) {
+    const BoutReal* in = input(i);
+    double* fin = plan.real + (i * length);
+    for (int j = 0; j < length; j++) {
+      fin[j] = in[j];
+    }
+  }
+
+  plan.execute();
+
+  //Normalising factor
+  const BoutReal fac = 1.0 / length;
+
+  for (int i = 0; i < howmany; i++) {
+    dcomplex* out = output(i);
+    const fftw_complex* fout = plan.complex + (i * nmodes);
+    for (int k = 0; k < nmodes; k++) {
+      out[k] = dcomplex(fout[k][0], fout[k][1]) * fac;
+    }
+  }
+}
+
+/// Inverse transform of \p howmany signals of \p length points. The
+/// i'th set of modes is read from `input(i)` and the real signal
+/// written to `output(i)`
+template <typename InputFunc, typename OutputFunc>
+void irfftBatch(int length, int howmany, InputFunc input, OutputFunc output) {
+  auto& plan = getPlan(PlanKind::c2r, length, howmany);
+  const int nmodes = (length / 2) + 1;
+
+  for (int i = 0; i < howmany; i++) {
+    const dcomplex* in = input(i);
+    fftw_complex* fin = plan.complex + (i * nmodes);
+    for (int k = 0; k < nmodes; k++) {
+      fin[k][0] = in[k].real();
+      fin[k][1] = in[k].imag();
+    }
+  }
+
+  plan.execute();
+
+  for (int i = 0; i < howmany; i++) {
+    BoutReal* out = output(i);
+    const double* fout = plan.real + (i * length);
+    for (int j = 0; j < length; j++) {
+      out[j] = fout[j];
+    }
+  }
+}
+
+/// Call \p transform(first, count) on chunks of at most
+/// `max_batch_size` out of \p howmany signals, sharing the chunks
+/// between OpenMP threads if there is more than one
+template <typename TransformFunc>
+void forEachChunk(int howmany, TransformFunc transform) {
+  if (howmany <= max_batch_size) {
+    if (howmany > 0) {
+      transform(0, howmany);
+    }
+    return;
+  }
+  const int nchunks = (howmany + max_batch_size - 1) / max_batch_size;
+  // Equal sized chunks, so that the same plan is used by all of them
+  const int chunk_size = (howmany + nchunks - 1) / nchunks;
+  BOUT_OMP(parallel for schedule(static))
+  for (int chunk = 0; chunk < nchunks; chunk++) {
+    const int first = chunk * chunk_size;
+    transform(first, std::min(chunk_size, howmany - first));
+  }
+}
 } // namespace
 #endif
 
@@ -100,73 +307,34 @@ void fft_init(bool fft_measure) {
   fft_initialised = true;
 }
 
+void fft_cleanup() {
+#if BOUT_HAS_FFTW
+  {
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    // All processors should have the same wisdom, so only one writes it
+    if (not fft_wisdom_file.empty() and BoutComm::rank() == 0) {
+      if (fftw_export_wisdom_to_filename(fft_wisdom_file.c_str()) == 0) {
+        output_warn.write("WARNING: Couldn't save FFTW wisdom to '{:s}'\n",
+                          fft_wisdom_file);
+      }
+    }
+  }
+  // Plans lock the planner when they are destroyed
+  plan_cache.clear();
+#endif
+}
+
 /***********************************************************
  * Real FFTs
  ***********************************************************/
 
-#if !BOUT_USE_OPENMP
-// Serial code
 void rfft(MAYBE_UNUSED(const BoutReal* in), MAYBE_UNUSED(int length),
           MAYBE_UNUSED(dcomplex* out)) {
 #if !BOUT_HAS_FFTW
   throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
 #else
-  // static variables initialized once
-  static double* fin;
-  static fftw_complex* fout;
-  static fftw_plan p;
-  static int n = 0;
-
-  // If the current length mismatches n
-  if (length != n) {
-    // If n has been used before
-    if (n > 0) {
-      // Free the previously initialized data
-      fftw_destroy_plan(p);
-      fftw_free(fin);
-      fftw_free(fout);
-    }
-
-    fft_init();
-
-    // Initialize the input for the fourier transformation
-    fin = static_cast<double*>(fftw_malloc(sizeof(double) * length));
-    // Initialize the output of the fourier transformation
-    /* NOTE: Only the non-redundant output is given
-     *       I.e the offset and the positive frequencies (so no mirroring
-     *       around the Nyquist frequency)
-     */
-    fout =
-        static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex) * (length / 2 + 1)));
-
-    auto flags = get_measurement_flag(fft_measurement_flag);
-
-    /* fftw call
-     * Plan a real-input/complex-output discrete Fourier transform (DFT)
-     * in 1 dimensions. Returns a fftw_plan (containing pointers etc.)
-     * r2c = real to complex
-     */
-    p = fftw_plan_dft_r2c_1d(length, fin, fout, flags);
-
-    n = length;
-  }
-
-  // Put the input to fin
-  for (int i = 0; i < n; i++) {
-    fin[i] = in[i];
-  }
-
-  // fftw call executing the fft
-  fftw_execute(p);
-
-  //Normalising factor
-  const BoutReal fac = 1.0 / n;
-  const int nmodes = (n / 2) + 1;
-
-  // Store the output in out, and normalize
-  for (int i = 0; i < nmodes; i++) {
-    out[i] = dcomplex(fout[i][0], fout[i][1]) * fac; // Normalise
-  }
+  rfftBatch(
+      length, 1, [in](int) { return in; }, [out](int) { return out; });
 #endif
 }
 
@@ -175,217 +343,82 @@ void irfft(MAYBE_UNUSED(const dcomplex* in), MAYBE_UNUSED(int length),
 #if !BOUT_HAS_FFTW
   throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
 #else
-  // static variables initialized once
-  static fftw_complex* fin;
-  static double* fout;
-  static fftw_plan p;
-  static int n = 0;
-
-  // If the current length mismatches n
-  if (length != n) {
-    // If n has been used before
-    if (n > 0) {
-      // Free the previously initialized data
-      fftw_destroy_plan(p);
-      fftw_free(fin);
-      fftw_free(fout);
-    }
-
-    fft_init();
-
-    // Initilaize the input for the inverse fourier transformation
-    /* NOTE: Only the non-redundant input is given
-     *       I.e the offset and the positive frequencies (so no mirroring
-     *       around the Nyquist frequency)
-     */
-    fin =
-        static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex) * (length / 2 + 1)));
-    // Initialize the output of the fourier transformation
-    fout = static_cast<double*>(fftw_malloc(sizeof(double) * length));
-
-    auto flags = get_measurement_flag(fft_measurement_flag);
-
-    /* fftw call
-     * Plan a complex-input/real-output discrete Fourier transform (DFT)
-     * in 1 dimensions. Returns a fftw_plan (containing pointers etc.)
-     * c2r = complex to real
-     */
-    p = fftw_plan_dft_c2r_1d(length, fin, fout, flags);
-
-    n = length;
-  }
-
-  // Store the real and imaginary parts in the proper way
-  const int nmodes = (n / 2) + 1;
-  for (int i = 0; i < nmodes; i++) {
-    fin[i][0] = in[i].real();
-    fin[i][1] = in[i].imag();
-  }
-
-  // fftw call executing the fft
-  fftw_execute(p);
-
-  // Store the output of the fftw to the out
-  for (int i = 0; i < n; i++) {
-    out[i] = fout[i];
-  }
+  irfftBatch(
+      length, 1, [in](int) { return in; }, [out](int) { return out; });
 #endif
 }
-#else
-// Parallel thread-safe version of rfft and irfft
+
 void rfft(MAYBE_UNUSED(const BoutReal* in), MAYBE_UNUSED(int length),
-          MAYBE_UNUSED(dcomplex* out)) {
+          MAYBE_UNUSED(dcomplex* out), MAYBE_UNUSED(int howmany),
+          MAYBE_UNUSED(int in_dist), MAYBE_UNUSED(int out_dist)) {
 #if !BOUT_HAS_FFTW
   throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
 #else
-  // ensure we are not nested
-  ASSERT1(omp_get_active_level() < 2);
-  static double* finall;
-  static fftw_complex* foutall;
-  static fftw_plan* p;
-  static int size = 0, nthreads = 0;
-
-  int th_id = omp_get_thread_num();
-  int n_th = omp_get_num_threads(); // Number of threads
-
-  // Sort out memory. Also, FFTW planning routines not thread safe
-  if ((size != length) || (nthreads < n_th)) {
-    // We make the check to see if the problem size has changed twice
-    // intentionally. The first check ensures we don't pay the cost of
-    // obtaining a lock for the critical section if we don't need to do
-    // any work here. The second check is required to make sure that
-    // only one thread does the actual setup when required. Note we can't
-    // use a `single` block here as that requires all threads to reach the
-    // block (implicit barrier) which may not be true in all cases (e.g.
-    // if there are 8 threads but only 4 call the fft routine).
-    BOUT_OMP(critical(rfft))
-    if ((size != length) || (nthreads < n_th)) {
-      if (size > 0) {
-        // Free all memory
-        for (int i = 0; i < nthreads; i++) {
-          fftw_destroy_plan(p[i]);
-        }
-        delete[] p;
-        fftw_free(finall);
-        fftw_free(foutall);
-      }
-
-      fft_init();
-
-      finall = static_cast<double*>(fftw_malloc(sizeof(double) * length * n_th));
-      foutall = static_cast<fftw_complex*>(
-          fftw_malloc(sizeof(fftw_complex) * (length / 2 + 1) * n_th));
-      p = new fftw_plan[n_th]; //Never freed
-
-      auto flags = get_measurement_flag(fft_measurement_flag);
-
-      for (int i = 0; i < n_th; i++) {
-        // fftw call
-        // Plan a real-input/complex-output discrete Fourier transform (DFT)
-        // in 1 dimensions. Returns a fftw_plan (containing pointers etc.)
-        p[i] = fftw_plan_dft_r2c_1d(length, finall + i * length,
-                                    foutall + i * (length / 2 + 1), flags);
-      }
-      size = length;
-      nthreads = n_th;
-    }
-  }
-
-  // Get working arrays for this thread
-  double* fin = finall + th_id * size;
-  fftw_complex* fout = foutall + th_id * (size / 2 + 1);
-
-  for (int i = 0; i < size; i++) {
-    fin[i] = in[i];
-  }
-
-  // fftw call executing the fft
-  fftw_execute(p[th_id]);
-
-  //Normalising factor
-  const BoutReal fac = 1.0 / static_cast<BoutReal>(size);
-  const int nmodes = (size / 2) + 1;
-
-  for (int i = 0; i < nmodes; i++) {
-    out[i] = dcomplex(fout[i][0], fout[i][1]) * fac; // Normalise
-  }
+  forEachChunk(howmany, [&](int first, int count) {
+    rfftBatch(
+        length, count, [&](int i) { return in + ((first + i) * in_dist); },
+        [&](int i) { return out + ((first + i) * out_dist); });
+  });
 #endif
 }
 
 void irfft(MAYBE_UNUSED(const dcomplex* in), MAYBE_UNUSED(int length),
-           MAYBE_UNUSED(BoutReal* out)) {
+           MAYBE_UNUSED(BoutReal* out), MAYBE_UNUSED(int howmany),
+           MAYBE_UNUSED(int in_dist), MAYBE_UNUSED(int out_dist)) {
 #if !BOUT_HAS_FFTW
   throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
 #else
-  static fftw_complex* finall;
-  static double* foutall;
-  static fftw_plan* p;
-  static int size = 0, nthreads = 0;
-
-  int th_id = omp_get_thread_num();
-  int n_th = omp_get_num_threads(); // Number of threads
-
-  // Sort out memory. Also, FFTW planning routines not thread safe
-  if ((size != length) || (nthreads < n_th)) {
-    // We make the check to see if the problem size has changed twice
-    // intentionally. The first check ensures we don't pay the cost of
-    // obtaining a lock for the critical section if we don't need to do
-    // any work here. The second check is required to make sure that
-    // only one thread does the actual setup when required. Note we can't
-    // use a `single` block here as that requires all threads to reach the
-    // block (implicit barrier) which may not be true in all cases (e.g.
-    // if there are 8 threads but only 4 call the fft routine).
-    BOUT_OMP(critical(irfft))
-    if ((size != length) || (nthreads < n_th)) {
-      if (size > 0) {
-        // Free all memory
-        for (int i = 0; i < nthreads; i++) {
-          fftw_destroy_plan(p[i]);
-        }
-        delete[] p;
-        fftw_free(finall);
-        fftw_free(foutall);
-      }
-
-      fft_init();
-
-      finall = static_cast<fftw_complex*>(
-          fftw_malloc(sizeof(fftw_complex) * (length / 2 + 1) * n_th));
-      foutall = static_cast<double*>(fftw_malloc(sizeof(double) * length * n_th));
-
-      p = new fftw_plan[n_th]; // Never freed
-
-      auto flags = get_measurement_flag(fft_measurement_flag);
-
-      for (int i = 0; i < n_th; i++) {
-        p[i] = fftw_plan_dft_c2r_1d(length, finall + i * (length / 2 + 1),
-                                    foutall + i * length, flags);
-      }
-      size = length;
-      nthreads = n_th;
-    }
-  }
-
-  // Get working arrays for this thread
-  fftw_complex* fin = finall + th_id * (size / 2 + 1);
-  double* fout = foutall + th_id * size;
+  forEachChunk(howmany, [&](int first, int count) {
+    irfftBatch(
+        length, count, [&](int i) { return in + ((first + i) * in_dist); },
+        [&](int i) { return out + ((first + i) * out_dist); });
+  });
+#endif
+}
 
-  const int nmodes = (size / 2) + 1;
+Matrix<dcomplex> rfft(const Field3D& f, const Region<Ind2D>& region) {
+  const int length = f.getNz();
+  const auto& indices = region.getIndices();
+  const int howmany = static_cast<int>(indices.size());
 
-  for (int i = 0; i < nmodes; i++) {
-    fin[i][0] = in[i].real();
-    fin[i][1] = in[i].imag();
-  }
+  Matrix<dcomplex> out(howmany, (length / 2) + 1);
+#if !BOUT_HAS_FFTW
+  throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
+#else
+  forEachChunk(howmany, [&](int first, int count) {
+    rfftBatch(
+        length, count,
+        [&](int i) {
+          const auto& ind = indices[first + i];
+          return &f(ind.x(), ind.y(), 0);
+        },
+        [&](int i) { return &out(first + i, 0); });
+  });
+#endif
+  return out;
+}
 
-  // fftw call executing the fft
-  fftw_execute(p[th_id]);
+void irfft(const Matrix<dcomplex>& in, const Region<Ind2D>& region, Field3D& out) {
+  const int length = out.getNz();
+  const auto& indices = region.getIndices();
+  const int howmany = static_cast<int>(indices.size());
 
-  for (int i = 0; i < size; i++) {
-    out[i] = fout[i];
-  }
+  ASSERT1(in.shape() == std::make_tuple(howmany, (length / 2) + 1));
+  out.allocate();
+#if !BOUT_HAS_FFTW
+  throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
+#else
+  forEachChunk(howmany, [&](int first, int count) {
+    irfftBatch(
+        length, count, [&](int i) { return &in(first + i, 0); },
+        [&](int i) {
+          const auto& ind = indices[first + i];
+          return &out(ind.x(), ind.y(), 0);
+        });
+  });
 #endif
 }
-#endif
+
 //  Discrete sine transforms (B Shanahan)
 
 void DST(MAYBE_UNUSED(const BoutReal* in), MAYBE_UNUSED(int length),
@@ -393,36 +426,13 @@ void DST(MAYBE_UNUSED(const BoutReal* in), MAYBE_UNUSED(int length),
 #if !BOUT_HAS_FFTW
   throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
 #else
-  static double* fin;
-  static fftw_complex* fout;
-  static fftw_plan p;
-  static int n = 0;
-
   ASSERT1(length > 0);
 
-  if (length != n) {
-    if (n > 0) {
-      fftw_destroy_plan(p);
-      fftw_free(fin);
-      fftw_free(fout);
-    }
-
-    //  fft_init();
-
-    // Could be optimized better
-    fin = static_cast<double*>(fftw_malloc(sizeof(double) * 2 * length));
-    fout = static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex) * 2 * length));
-
-    auto flags = get_measurement_flag(fft_measurement_flag);
-
-    // fftw call
-    // Plan a real-input/complex-output discrete Fourier transform (DFT)
-    // in 1 dimensions. Returns a fftw_plan (containing pointers etc.)
-    p = fftw_plan_dft_r2c_1d(2 * (length - 1), fin, fout, flags);
+  auto& plan = getPlan(PlanKind::dst, length);
+  double* fin = plan.real;
+  const fftw_complex* fout = plan.complex;
 
-    n = length;
-  }
-  for (int i = 0; i < n; i++) {
+  for (int i = 0; i < length; i++) {
     fin[i] = in[i];
   }
 
@@ -435,7 +445,7 @@ void DST(MAYBE_UNUSED(const BoutReal* in), MAYBE_UNUSED(int length),
   }
 
   // fftw call executing the fft
-  fftw_execute(p);
+  plan.execute();
 
   out[0] = 0.0;
   out[length - 1] = 0.0;
@@ -451,35 +461,13 @@ void DST_rev(MAYBE_UNUSED(dcomplex* in), MAYBE_UNUSED(int length),
 #if !BOUT_HAS_FFTW
   throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
 #else
-  static fftw_complex* fin;
-  static double* fout;
-  static fftw_plan p;
-  static int n = 0;
-
   ASSERT1(length > 0);
 
-  if (length != n) {
-    if (n > 0) {
-      fftw_destroy_plan(p);
-      fftw_free(fin);
-      fftw_free(fout);
-    }
-
-    //fft_init();
-
-    // Could be optimized better
-    fin =
-        static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex) * 2 * (length - 1)));
-    fout = static_cast<double*>(fftw_malloc(sizeof(double) * 2 * (length - 1)));
-
-    auto flags = get_measurement_flag(fft_measurement_flag);
-
-    p = fftw_plan_dft_c2r_1d(2 * (length - 1), fin, fout, flags);
-
-    n = length;
-  }
+  auto& plan = getPlan(PlanKind::dst_rev, length);
+  fftw_complex* fin = plan.complex;
+  const double* fout = plan.real;
 
-  for (int i = 0; i < n; i++) {
+  for (int i = 0; i < length; i++) {
     fin[i][0] = in[i].real();
     fin[i][1] = in[i].imag();
   }
@@ -497,7 +485,7 @@ void DST_rev(MAYBE_UNUSED(dcomplex* in), MAYBE_UNUSED(int length),
   }
 
   // fftw call executing the fft
-  fftw_execute(p);
+  plan.execute();
 
   out[0] = 0.0;
   out[length - 1] = 0.0;
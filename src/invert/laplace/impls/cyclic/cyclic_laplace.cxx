@@ -40,6 +40,7 @@
 
 #include <bout/boutexception.hxx>
 #include <bout/constants.hxx>
+#include <bout/coordinates.hxx>
 #include <bout/fft.hxx>
 #include <bout/globals.hxx>
 #include <bout/mesh.hxx>
@@ -64,6 +65,17 @@ LaplaceCyclic::LaplaceCyclic(Options* opt, const CELL_LOC loc, Mesh* mesh_in,
             .doc("Use Discrete Sine Transform in Z to enforce Dirichlet boundaries in Z")
             .withDefault<bool>(false);
 
+  const bool pipeline =
+      (*opt)["pipeline"]
+          .doc("Overlap the communication of the interface equations in the cyclic "
+               "reduction with the local reduction and back-solve")
+          .withDefault<bool>(false);
+
+  reuse_matrices = (*opt)["reuse_matrices"]
+                       .doc("Reuse the tridiagonal matrices and their factorisation "
+                            "between solves if the coefficients haven't changed")
+                       .withDefault<bool>(true);
+
   if (dst) {
     nmode = localmesh->LocalNz - 2;
   } else {
@@ -99,6 +111,7 @@ LaplaceCyclic::LaplaceCyclic(Options* opt, const CELL_LOC loc, Mesh* mesh_in,
   // Create a cyclic reduction object, operating on dcomplex values
   cr = new CyclicReduce<dcomplex>(localmesh->getXcomm(), n);
   cr->setPeriodic(localmesh->periodicX);
+  cr->setPipelined(pipeline);
 }
 
 LaplaceCyclic::~LaplaceCyclic() {
@@ -106,6 +119,12 @@ LaplaceCyclic::~LaplaceCyclic() {
   delete cr;
 }
 
+bool LaplaceCyclic::matricesUpToDate(int jy, int nrhs) const {
+  return reuse_matrices and (cr_generation == coefficientGeneration())
+         and (cr_geometry == coords->geometryGeneration()) and (cr_jy == jy)
+         and (cr_nrhs == nrhs);
+}
+
 FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
   ASSERT1(localmesh == rhs.getMesh() && localmesh == x0.getMesh());
   ASSERT1(rhs.getLocation() == location);
@@ -130,6 +149,9 @@ FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
     outbndry = 1;
   }
 
+  // Only build the matrices if the coefficients have changed
+  const bool assemble = not matricesUpToDate(jy, 1);
+
   if (dst) {
     BOUT_OMP(parallel)
     {
@@ -166,18 +188,29 @@ FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
         // wave number is 1/[rad]; DST has extra 2.
         BoutReal kwave = kz * 2.0 * PI / (2. * zlen);
 
-        tridagMatrix(&a(kz, 0), &b(kz, 0), &c(kz, 0), &bcmplx(kz, 0), jy,
-                     kz,    // wave number index
-                     kwave, // kwave (inverse wave length)
-                     global_flags, inner_boundary_flags, outer_boundary_flags, &Acoef,
-                     &C1coef, &C2coef, &Dcoef,
-                     false,  // Don't include guard cells in arrays
-                     false); // Z domain not periodic
+        if (assemble) {
+          tridagMatrix(&a(kz, 0), &b(kz, 0), &c(kz, 0), &bcmplx(kz, 0), jy,
+                       kz,    // wave number index
+                       kwave, // kwave (inverse wave length)
+                       global_flags, inner_boundary_flags, outer_boundary_flags, &Acoef,
+                       &C1coef, &C2coef, &Dcoef,
+                       false,  // Don't include guard cells in arrays
+                       false); // Z domain not periodic
+        } else {
+          tridagRHS(&bcmplx(kz, 0), kz, global_flags, inner_boundary_flags,
+                    outer_boundary_flags, false, false);
+        }
       }
     }
 
     // Solve tridiagonal systems
-    cr->setCoefs(a, b, c);
+    if (assemble) {
+      cr->setCoefs(a, b, c);
+      cr_generation = coefficientGeneration();
+      cr_geometry = coords->geometryGeneration();
+      cr_jy = jy;
+      cr_nrhs = 1;
+    }
     cr->solve(bcmplx, xcmplx);
 
     // FFT back to real space
@@ -237,18 +270,29 @@ FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
       // including boundary conditions
       BOUT_OMP(for nowait)
       for (int kz = 0; kz < nmode; kz++) {
-        BoutReal kwave = kz * 2.0 * PI / zlength; // wave number is 1/[rad]
-        tridagMatrix(&a(kz, 0), &b(kz, 0), &c(kz, 0), &bcmplx(kz, 0), jy,
-                     kz,    // True for the component constant (DC) in Z
-                     kwave, // Z wave number
-                     global_flags, inner_boundary_flags, outer_boundary_flags, &Acoef,
-                     &C1coef, &C2coef, &Dcoef,
-                     false); // Don't include guard cells in arrays
+        if (assemble) {
+          BoutReal kwave = kz * 2.0 * PI / zlength; // wave number is 1/[rad]
+          tridagMatrix(&a(kz, 0), &b(kz, 0), &c(kz, 0), &bcmplx(kz, 0), jy,
+                       kz,    // True for the component constant (DC) in Z
+                       kwave, // Z wave number
+                       global_flags, inner_boundary_flags, outer_boundary_flags, &Acoef,
+                       &C1coef, &C2coef, &Dcoef,
+                       false); // Don't include guard cells in arrays
+        } else {
+          tridagRHS(&bcmplx(kz, 0), kz, global_flags, inner_boundary_flags,
+                    outer_boundary_flags, false);
+        }
       }
     }
 
     // Solve tridiagonal systems
-    cr->setCoefs(a, b, c);
+    if (assemble) {
+      cr->setCoefs(a, b, c);
+      cr_generation = coefficientGeneration();
+      cr_geometry = coords->geometryGeneration();
+      cr_jy = jy;
+      cr_nrhs = 1;
+    }
     cr->solve(bcmplx, xcmplx);
 
     if (localmesh->periodicX) {
@@ -302,15 +346,29 @@ FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
 }
 
 Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
-  TRACE("LaplaceCyclic::solve(Field3D, Field3D)");
+  return solve(std::vector<Field3D>{rhs}, std::vector<Field3D>{x0})[0];
+}
 
-  ASSERT1(rhs.getLocation() == location);
-  ASSERT1(x0.getLocation() == location);
-  ASSERT1(localmesh == rhs.getMesh() && localmesh == x0.getMesh());
+std::vector<Field3D> LaplaceCyclic::solve(const std::vector<Field3D>& rhs,
+                                          const std::vector<Field3D>& x0) {
+  TRACE("LaplaceCyclic::solve(std::vector<Field3D>, std::vector<Field3D>)");
 
-  Timer timer("invert");
+  ASSERT1(rhs.size() == x0.size());
+  const int nrhs = static_cast<int>(rhs.size());
 
-  Field3D x{emptyFrom(rhs)}; // Result
+  std::vector<Field3D> x; // Results
+  x.reserve(nrhs);
+  for (int r = 0; r < nrhs; r++) {
+    ASSERT1(rhs[r].getLocation() == location);
+    ASSERT1(x0[r].getLocation() == location);
+    ASSERT1(localmesh == rhs[r].getMesh() && localmesh == x0[r].getMesh());
+    x.emplace_back(emptyFrom(rhs[r]));
+  }
+  if (nrhs == 0) {
+    return x;
+  }
+
+  Timer timer("invert");
 
   // Get the width of the boundary
 
@@ -326,6 +384,14 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
     outbndry = 1;
   }
 
+  // True if the values in x0 should be used in the boundary at ix
+  auto useX0 = [&](int ix) {
+    return ((ix < inbndry) && ((inner_boundary_flags & INVERT_SET) != 0)
+            && localmesh->firstX())
+           || ((localmesh->LocalNx - ix - 1 < outbndry)
+               && ((outer_boundary_flags & INVERT_SET) != 0) && localmesh->lastX());
+  };
+
   int nx = xe - xs + 1; // Number of X points on this processor
 
   // Get range of Y indices
@@ -347,15 +413,26 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
   }
 
   const int ny = (ye - ys + 1); // Number of Y points
-  const int nsys = nmode * ny;  // Number of systems of equations to solve
+  const int nsys = nmode * ny;  // Number of systems of equations for each RHS
   const int nxny = nx * ny;     // Number of points in X-Y
 
-  auto a3D = Matrix<dcomplex>(nsys, nx);
-  auto b3D = Matrix<dcomplex>(nsys, nx);
-  auto c3D = Matrix<dcomplex>(nsys, nx);
+  // The systems for all the RHS are solved together. System
+  // r * nsys + (iy - ys) * nmode + kz is mode kz at iy of RHS r
+  const int nsys_all = nrhs * nsys;
+
+  // Only build the matrices if the coefficients have changed. The
+  // matrices are the same for every RHS, so are only built for the
+  // first one
+  const bool assemble = not matricesUpToDate(-1, nrhs);
+  Matrix<dcomplex> a3D, b3D, c3D;
+  if (assemble) {
+    a3D.reallocate(nsys_all, nx);
+    b3D.reallocate(nsys_all, nx);
+    c3D.reallocate(nsys_all, nx);
+  }
 
-  auto xcmplx3D = Matrix<dcomplex>(nsys, nx);
-  auto bcmplx3D = Matrix<dcomplex>(nsys, nx);
+  auto xcmplx3D = Matrix<dcomplex>(nsys_all, nx);
+  auto bcmplx3D = Matrix<dcomplex>(nsys_all, nx);
 
   if (dst) {
     BOUT_OMP(parallel)
@@ -367,26 +444,24 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
       // Loop over X and Y indices, including boundaries but not guard cells.
       // (unless periodic in x)
       BOUT_OMP(for)
-      for (int ind = 0; ind < nxny; ++ind) {
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
+      for (int ind = 0; ind < nrhs * nxny; ++ind) {
+        // ind = r * nxny + (ix - xs)*(ye - ys + 1) + (iy - ys)
+        int r = ind / nxny;
+        int ix = xs + (ind % nxny) / ny;
         int iy = ys + ind % ny;
 
         // Take DST in Z direction and put result in k1d
 
-        if (((ix < inbndry) && ((inner_boundary_flags & INVERT_SET) != 0)
-             && localmesh->firstX())
-            || ((localmesh->LocalNx - ix - 1 < outbndry)
-                && ((outer_boundary_flags & INVERT_SET) != 0) && localmesh->lastX())) {
+        if (useX0(ix)) {
           // Use the values in x0 in the boundary
-          DST(x0(ix, iy) + 1, localmesh->LocalNz - 2, std::begin(k1d));
+          DST(x0[r](ix, iy) + 1, localmesh->LocalNz - 2, std::begin(k1d));
         } else {
-          DST(rhs(ix, iy) + 1, localmesh->LocalNz - 2, std::begin(k1d));
+          DST(rhs[r](ix, iy) + 1, localmesh->LocalNz - 2, std::begin(k1d));
         }
 
         // Copy into array, transposing so kz is first index
         for (int kz = 0; kz < nmode; kz++) {
-          bcmplx3D((iy - ys) * nmode + kz, ix - xs) = k1d[kz];
+          bcmplx3D(r * nsys + (iy - ys) * nmode + kz, ix - xs) = k1d[kz];
         }
       }
 
@@ -394,27 +469,31 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
       // including boundary conditions
       const BoutReal zlen = getUniform(coords->dz) * (localmesh->LocalNz - 3);
       BOUT_OMP(for nowait)
-      for (int ind = 0; ind < nsys; ind++) {
-        // ind = (iy - ys) * nmode + kz
-        int iy = ys + ind / nmode;
+      for (int ind = 0; ind < nsys_all; ind++) {
+        // ind = r * nsys + (iy - ys) * nmode + kz
+        int iy = ys + (ind % nsys) / nmode;
         int kz = ind % nmode;
 
         // wave number is 1/[rad]; DST has extra 2.
         BoutReal kwave = kz * 2.0 * PI / (2. * zlen);
 
-        tridagMatrix(&a3D(ind, 0), &b3D(ind, 0), &c3D(ind, 0), &bcmplx3D(ind, 0), iy,
-                     kz,    // wave number index
-                     kwave, // kwave (inverse wave length)
-                     global_flags, inner_boundary_flags, outer_boundary_flags, &Acoef,
-                     &C1coef, &C2coef, &Dcoef,
-                     false,  // Don't include guard cells in arrays
-                     false); // Z domain not periodic
+        if (assemble and (ind < nsys)) {
+          tridagMatrix(&a3D(ind, 0), &b3D(ind, 0), &c3D(ind, 0), &bcmplx3D(ind, 0), iy,
+                       kz,    // wave number index
+                       kwave, // kwave (inverse wave length)
+                       global_flags, inner_boundary_flags, outer_boundary_flags,
+                       &Acoef, &C1coef, &C2coef, &Dcoef,
+                       false,  // Don't include guard cells in arrays
+                       false); // Z domain not periodic
+        } else {
+          tridagRHS(&bcmplx3D(ind, 0), kz, global_flags, inner_boundary_flags,
+                    outer_boundary_flags, false, false);
+        }
       }
     }
 
     // Solve tridiagonal systems
-    cr->setCoefs(a3D, b3D, c3D);
-    cr->solve(bcmplx3D, xcmplx3D);
+    solveSystems(assemble, nrhs, a3D, b3D, c3D, bcmplx3D, xcmplx3D);
 
     // FFT back to real space
     BOUT_OMP(parallel)
@@ -424,99 +503,108 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
       auto k1d = Array<dcomplex>(localmesh->LocalNz);
 
       BOUT_OMP(for nowait)
-      for (int ind = 0; ind < nxny; ++ind) { // Loop over X and Y
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
+      for (int ind = 0; ind < nrhs * nxny; ++ind) { // Loop over RHS, X and Y
+        // ind = r * nxny + (ix - xs)*(ye - ys + 1) + (iy - ys)
+        int r = ind / nxny;
+        int ix = xs + (ind % nxny) / ny;
         int iy = ys + ind % ny;
 
         for (int kz = 0; kz < nmode; kz++) {
-          k1d[kz] = xcmplx3D((iy - ys) * nmode + kz, ix - xs);
+          k1d[kz] = xcmplx3D(r * nsys + (iy - ys) * nmode + kz, ix - xs);
         }
 
         for (int kz = nmode; kz < localmesh->LocalNz; kz++) {
           k1d[kz] = 0.0; // Filtering out all higher harmonics
         }
 
-        DST_rev(std::begin(k1d), localmesh->LocalNz - 2, &x(ix, iy, 1));
+        DST_rev(std::begin(k1d), localmesh->LocalNz - 2, &x[r](ix, iy, 1));
 
-        x(ix, iy, 0) = -x(ix, iy, 2);
-        x(ix, iy, localmesh->LocalNz - 1) = -x(ix, iy, localmesh->LocalNz - 3);
+        x[r](ix, iy, 0) = -x[r](ix, iy, 2);
+        x[r](ix, iy, localmesh->LocalNz - 1) = -x[r](ix, iy, localmesh->LocalNz - 3);
       }
     }
   } else {
     const BoutReal zlength = getUniform(coords->zlength());
+    const int nz_modes = localmesh->LocalNz / 2 + 1;
     BOUT_OMP(parallel)
     {
-      /// Create a local thread-scope working array
-      // ZFFT routine expects input of this length
-      auto k1d = Array<dcomplex>(localmesh->LocalNz / 2 + 1);
+      /// Create a local thread-scope working array, holding the
+      /// modes at all Y indices for one X index
+      auto k2d = Matrix<dcomplex>(ny, nz_modes);
 
-      // Loop over X and Y indices, including boundaries but not guard cells
-      // (unless periodic in x)
+      // Loop over RHS and X indices, including boundaries but not
+      // guard cells (unless periodic in x)
 
       BOUT_OMP(for)
-      for (int ind = 0; ind < nxny; ++ind) {
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
-        int iy = ys + ind % ny;
+      for (int ind = 0; ind < nrhs * nx; ++ind) {
+        // ind = r * nx + (ix - xs)
+        int r = ind / nx;
+        int ix = xs + ind % nx;
 
-        // Take FFT in Z direction, apply shift, and put result in k1d
+        // Take FFT in Z direction of all Y indices at once, and put
+        // result in k2d. The Y indices are contiguous in the fields
 
-        if (((ix < inbndry) && ((inner_boundary_flags & INVERT_SET) != 0)
-             && localmesh->firstX())
-            || ((localmesh->LocalNx - ix - 1 < outbndry)
-                && ((outer_boundary_flags & INVERT_SET) != 0) && localmesh->lastX())) {
+        if (useX0(ix)) {
           // Use the values in x0 in the boundary
-          rfft(x0(ix, iy), localmesh->LocalNz, std::begin(k1d));
+          bout::fft::rfft(x0[r](ix, ys), localmesh->LocalNz, &k2d(0, 0), ny,
+                          localmesh->LocalNz, nz_modes);
         } else {
-          rfft(rhs(ix, iy), localmesh->LocalNz, std::begin(k1d));
+          bout::fft::rfft(rhs[r](ix, ys), localmesh->LocalNz, &k2d(0, 0), ny,
+                          localmesh->LocalNz, nz_modes);
         }
 
         // Copy into array, transposing so kz is first index
-        for (int kz = 0; kz < nmode; kz++) {
-          bcmplx3D((iy - ys) * nmode + kz, ix - xs) = k1d[kz];
+        for (int iy = 0; iy < ny; iy++) {
+          for (int kz = 0; kz < nmode; kz++) {
+            bcmplx3D(r * nsys + iy * nmode + kz, ix - xs) = k2d(iy, kz);
+          }
         }
       }
 
       // Get elements of the tridiagonal matrix
       // including boundary conditions
       BOUT_OMP(for nowait)
-      for (int ind = 0; ind < nsys; ind++) {
-        // ind = (iy - ys) * nmode + kz
-        int iy = ys + ind / nmode;
+      for (int ind = 0; ind < nsys_all; ind++) {
+        // ind = r * nsys + (iy - ys) * nmode + kz
+        int iy = ys + (ind % nsys) / nmode;
         int kz = ind % nmode;
 
-        BoutReal kwave = kz * 2.0 * PI / zlength; // wave number is 1/[rad]
-        tridagMatrix(&a3D(ind, 0), &b3D(ind, 0), &c3D(ind, 0), &bcmplx3D(ind, 0), iy,
-                     kz,    // True for the component constant (DC) in Z
-                     kwave, // Z wave number
-                     global_flags, inner_boundary_flags, outer_boundary_flags, &Acoef,
-                     &C1coef, &C2coef, &Dcoef,
-                     false); // Don't include guard cells in arrays
+        if (assemble and (ind < nsys)) {
+          BoutReal kwave = kz * 2.0 * PI / zlength; // wave number is 1/[rad]
+          tridagMatrix(&a3D(ind, 0), &b3D(ind, 0), &c3D(ind, 0), &bcmplx3D(ind, 0), iy,
+                       kz,    // True for the component constant (DC) in Z
+                       kwave, // Z wave number
+                       global_flags, inner_boundary_flags, outer_boundary_flags,
+                       &Acoef, &C1coef, &C2coef, &Dcoef,
+                       false); // Don't include guard cells in arrays
+        } else {
+          tridagRHS(&bcmplx3D(ind, 0), kz, global_flags, inner_boundary_flags,
+                    outer_boundary_flags, false);
+        }
       }
     }
 
     // Solve tridiagonal systems
-    cr->setCoefs(a3D, b3D, c3D);
-    cr->solve(bcmplx3D, xcmplx3D);
+    solveSystems(assemble, nrhs, a3D, b3D, c3D, bcmplx3D, xcmplx3D);
 
     if (localmesh->periodicX) {
-      // Subtract X average of kz=0 mode
-      BoutReal local[ny + 1];
-      for (int y = 0; y < ny; y++) {
+      // Subtract X average of kz=0 mode, for all RHS in one reduction
+      std::vector<BoutReal> local(nrhs * ny + 1);
+      for (int y = 0; y < nrhs * ny; y++) {
         local[y] = 0.0;
         for (int ix = xs; ix <= xe; ix++) {
           local[y] += xcmplx3D(y * nmode, ix - xs).real();
         }
       }
-      local[ny] = static_cast<BoutReal>(xe - xs + 1);
+      local[nrhs * ny] = static_cast<BoutReal>(xe - xs + 1);
 
       // Global reduce
-      BoutReal global[ny + 1];
-      MPI_Allreduce(local, global, ny + 1, MPI_DOUBLE, MPI_SUM, localmesh->getXcomm());
+      std::vector<BoutReal> global(nrhs * ny + 1);
+      MPI_Allreduce(local.data(), global.data(), nrhs * ny + 1, MPI_DOUBLE, MPI_SUM,
+                    localmesh->getXcomm());
       // Subtract average from kz=0 modes
-      for (int y = 0; y < ny; y++) {
-        BoutReal avg = global[y] / global[ny];
+      for (int y = 0; y < nrhs * ny; y++) {
+        BoutReal avg = global[y] / global[nrhs * ny];
         for (int ix = xs; ix <= xe; ix++) {
           xcmplx3D(y * nmode, ix - xs) -= avg;
         }
@@ -526,40 +614,73 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
     // FFT back to real space
     BOUT_OMP(parallel)
     {
-      /// Create a local thread-scope working array
-      auto k1d = Array<dcomplex>((localmesh->LocalNz) / 2
-                                 + 1); // ZFFT routine expects input of this length
+      /// Create a local thread-scope working array, holding the
+      /// modes at all Y indices for one X index
+      auto k2d = Matrix<dcomplex>(ny, nz_modes);
 
       const bool zero_DC = (global_flags & INVERT_ZERO_DC) != 0;
 
       BOUT_OMP(for nowait)
-      for (int ind = 0; ind < nxny; ++ind) { // Loop over X and Y
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
-        int iy = ys + ind % ny;
-
-        if (zero_DC) {
-          k1d[0] = 0.;
-        }
-
-        for (int kz = static_cast<int>(zero_DC); kz < nmode; kz++) {
-          k1d[kz] = xcmplx3D((iy - ys) * nmode + kz, ix - xs);
+      for (int ind = 0; ind < nrhs * nx; ++ind) { // Loop over RHS and X
+        // ind = r * nx + (ix - xs)
+        int r = ind / nx;
+        int ix = xs + ind % nx;
+
+        for (int iy = 0; iy < ny; iy++) {
+          if (zero_DC) {
+            k2d(iy, 0) = 0.;
+          }
+
+          for (int kz = static_cast<int>(zero_DC); kz < nmode; kz++) {
+            k2d(iy, kz) = xcmplx3D(r * nsys + iy * nmode + kz, ix - xs);
+          }
+
+          for (int kz = nmode; kz < nz_modes; kz++) {
+            k2d(iy, kz) = 0.0; // Filtering out all higher harmonics
+          }
         }
 
-        for (int kz = nmode; kz < localmesh->LocalNz / 2 + 1; kz++) {
-          k1d[kz] = 0.0; // Filtering out all higher harmonics
-        }
-
-        irfft(std::begin(k1d), localmesh->LocalNz, x(ix, iy));
+        // FFT all Y indices at once
+        bout::fft::irfft(&k2d(0, 0), localmesh->LocalNz, x[r](ix, ys), ny, nz_modes,
+                         localmesh->LocalNz);
       }
     }
   }
 
-  checkData(x);
+  for (const auto& f : x) {
+    checkData(f);
+  }
 
   return x;
 }
 
+void LaplaceCyclic::solveSystems(bool assemble, int nrhs, Matrix<dcomplex>& a3D,
+                                 Matrix<dcomplex>& b3D, Matrix<dcomplex>& c3D,
+                                 const Matrix<dcomplex>& bcmplx3D,
+                                 Matrix<dcomplex>& xcmplx3D) {
+  if (assemble) {
+    // Copy the matrices for the first RHS to the others
+    const int nsys_all = std::get<0>(a3D.shape());
+    const int nsys = nsys_all / nrhs;
+    const int nx = std::get<1>(a3D.shape());
+    BOUT_OMP(parallel for)
+    for (int ind = nsys; ind < nsys_all; ind++) {
+      for (int ix = 0; ix < nx; ix++) {
+        a3D(ind, ix) = a3D(ind % nsys, ix);
+        b3D(ind, ix) = b3D(ind % nsys, ix);
+        c3D(ind, ix) = c3D(ind % nsys, ix);
+      }
+    }
+
+    cr->setCoefs(a3D, b3D, c3D);
+    cr_generation = coefficientGeneration();
+    cr_geometry = coords->geometryGeneration();
+    cr_jy = -1;
+    cr_nrhs = nrhs;
+  }
+  cr->solve(bcmplx3D, xcmplx3D);
+}
+
 void LaplaceCyclic ::verify_solution(const Matrix<dcomplex>& a_ver,
                                      const Matrix<dcomplex>& b_ver,
                                      const Matrix<dcomplex>& c_ver,
@@ -68,6 +68,7 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Acoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefC;
   void setCoefC(const Field2D& val) override {
@@ -79,18 +80,21 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C1coef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefC2;
   void setCoefC2(const Field2D& val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C2coef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefD;
   void setCoefD(const Field2D& val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Dcoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefEx;
   void setCoefEx(const Field2D& UNUSED(val)) override {
@@ -107,6 +111,14 @@ public:
 
   Field3D solve(const Field3D& b) override { return solve(b, b); }
   Field3D solve(const Field3D& b, const Field3D& x0) override;
+
+  /// Solve for all the RHS in \p b together, with one set of
+  /// tridiagonal systems and communications
+  std::vector<Field3D> solve(const std::vector<Field3D>& b) override {
+    return solve(b, b);
+  }
+  std::vector<Field3D> solve(const std::vector<Field3D>& b,
+                             const std::vector<Field3D>& x0) override;
   void verify_solution(const Matrix<dcomplex>& a_ver, const Matrix<dcomplex>& b_ver,
                        const Matrix<dcomplex>& c_ver, const Matrix<dcomplex>& r_ver,
                        const Matrix<dcomplex>& x_sol, int nsys);
@@ -121,6 +133,29 @@ private:
   bool dst;
 
   CyclicReduce<dcomplex>* cr; ///< Tridiagonal solver
+
+  /// Reuse the matrices in cr if the coefficients haven't changed
+  bool reuse_matrices;
+  /// Coefficient generation of the matrices in cr, or -1 if none
+  int cr_generation{-1};
+  /// Geometry generation of coords when the matrices in cr were built
+  int cr_geometry{-1};
+  /// Y index of the matrices in cr, or -1 for a Field3D solve
+  int cr_jy{-1};
+  /// Number of RHS the matrices in cr were built for
+  int cr_nrhs{0};
+
+  /// True if the matrices in cr are for the current coefficients and
+  /// metric at \p jy (-1 for a Field3D solve) and \p nrhs right-hand
+  /// sides, so don't need to be built again
+  bool matricesUpToDate(int jy, int nrhs) const;
+
+  /// Solve the Field3D tridiagonal systems for \p nrhs right-hand
+  /// sides. If \p assemble is true, the matrices for the first RHS
+  /// are copied to the others and given to cr
+  void solveSystems(bool assemble, int nrhs, Matrix<dcomplex>& a3D,
+                    Matrix<dcomplex>& b3D, Matrix<dcomplex>& c3D,
+                    const Matrix<dcomplex>& bcmplx3D, Matrix<dcomplex>& xcmplx3D);
 };
 
 #endif // BOUT_USE_METRIC_3D
@@ -72,6 +72,11 @@
  * starting value uof underrelax_factor can be set with the initial_underrelax_factor
  * option.
  *
+ * Alternatively, if the anderson_depth option is positive, Anderson acceleration is
+ * used: the new b is the combination of the last anderson_depth values of
+ * b(phiCur) which minimises the L2 norm of the error, mixed with
+ * initial_underrelax_factor.
+ *
  * The iteration now works as follows:
  *      1. Get the vorticity from
  *         \code{.cpp}
@@ -138,6 +143,7 @@
  */
 // clang-format on
 
+#include <bout/boutcomm.hxx>
 #include <bout/boutexception.hxx>
 #include <bout/coordinates.hxx>
 #include <bout/derivs.hxx>
@@ -145,9 +151,94 @@
 #include <bout/globals.hxx>
 #include <bout/mesh.hxx>
 #include <bout/sys/timer.hxx>
+#include <bout/utils.hxx>
 
 #include "naulin_laplace.hxx"
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <vector>
+
+namespace {
+/// Coefficients gamma which minimise the L2 norm over RGN_NOBNDRY on
+/// all processors of f - sum_i gamma_i * df[i]. There are only a few
+/// vectors in \p df, so this uses the normal equations. Returns an
+/// empty vector if they are singular
+std::vector<BoutReal> andersonCoefficients(const std::deque<Field3D>& df,
+                                           const Field3D& f) {
+  const int m = static_cast<int>(df.size());
+  if (m == 0) {
+    return {};
+  }
+
+  auto dot = [&f](const Field3D& a, const Field3D& b) {
+    BoutReal result = 0.0;
+    BOUT_FOR_OMP(i, f.getRegion("RGN_NOBNDRY"), parallel for reduction(+:result)) {
+      result += a[i] * b[i];
+    }
+    return result;
+  };
+
+  // Lower triangle of the matrix df[i].df[j], followed by df[i].f, so
+  // that all the sums are done in one reduction
+  std::vector<BoutReal> local(m * m + m, 0.0);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      local[i * m + j] = dot(df[i], df[j]);
+    }
+    local[m * m + i] = dot(df[i], f);
+  }
+  std::vector<BoutReal> sums(local.size());
+  MPI_Allreduce(local.data(), sums.data(), static_cast<int>(local.size()), MPI_DOUBLE,
+                MPI_SUM, BoutComm::get());
+
+  Matrix<BoutReal> matrix(m, m);
+  std::vector<BoutReal> gamma(m);
+  BoutReal max_diagonal = 0.0;
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      matrix(i, j) = matrix(j, i) = sums[i * m + j];
+    }
+    gamma[i] = sums[m * m + i];
+    max_diagonal = std::max(max_diagonal, matrix(i, i));
+  }
+
+  // Gaussian elimination with partial pivoting
+  for (int k = 0; k < m; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < m; ++i) {
+      if (std::abs(matrix(i, k)) > std::abs(matrix(pivot, k))) {
+        pivot = i;
+      }
+    }
+    if (std::abs(matrix(pivot, k)) <= 1e-14 * max_diagonal) {
+      return {};
+    }
+    if (pivot != k) {
+      for (int j = 0; j < m; ++j) {
+        std::swap(matrix(k, j), matrix(pivot, j));
+      }
+      std::swap(gamma[k], gamma[pivot]);
+    }
+    for (int i = k + 1; i < m; ++i) {
+      const BoutReal factor = matrix(i, k) / matrix(k, k);
+      for (int j = k; j < m; ++j) {
+        matrix(i, j) -= factor * matrix(k, j);
+      }
+      gamma[i] -= factor * gamma[k];
+    }
+  }
+  for (int k = m - 1; k >= 0; --k) {
+    for (int j = k + 1; j < m; ++j) {
+      gamma[k] -= matrix(k, j) * gamma[j];
+    }
+    gamma[k] /= matrix(k, k);
+  }
+  return gamma;
+}
+} // namespace
+
 LaplaceNaulin::LaplaceNaulin(Options* opt, const CELL_LOC loc, Mesh* mesh_in,
                              Solver* UNUSED(solver))
     : Laplacian(opt, loc, mesh_in), Acoef(0.0), C1coef(1.0), C2coef(0.0), Dcoef(1.0),
@@ -167,6 +258,20 @@ LaplaceNaulin::LaplaceNaulin(Options* opt, const CELL_LOC loc, Mesh* mesh_in,
   OPTION(opt, maxits, 100);
   OPTION(opt, initial_underrelax_factor, 1.);
   ASSERT0(initial_underrelax_factor > 0. and initial_underrelax_factor <= 1.);
+  use_previous_solution =
+      (*opt)["use_previous_solution"]
+          .doc("Start from the previous solution when solve is not given an initial "
+               "guess")
+          .withDefault<bool>(true);
+  anderson_depth = (*opt)["anderson_depth"]
+                       .doc("Number of previous iterations used for Anderson "
+                            "acceleration. 0 uses under-relaxed fixed-point iteration")
+                       .withDefault<int>(0);
+  if (anderson_depth < 0) {
+    throw BoutException("LaplaceNaulin error: anderson_depth must not be negative, got "
+                        "{:d}",
+                        anderson_depth);
+  }
   delp2solver = create(opt->getSection("delp2solver"), location, localmesh);
   std::string delp2type;
   opt->getSection("delp2solver")->get("type", delp2type, "cyclic");
@@ -197,42 +302,9 @@ Field3D LaplaceNaulin::solve(const Field3D& rhs, const Field3D& x0) {
   ASSERT1(Acoef.getLocation() == location);
   ASSERT1(localmesh == rhs.getMesh() && localmesh == x0.getMesh());
 
-  Field3D rhsOverD = rhs / Dcoef;
-
-  Field3D C1TimesD = C1coef * Dcoef; // This is needed several times
-
-  // x-component of 1./(C1*D) * Grad_perp(C2)
-  Field3D coef_x = DDX(C2coef, location, "C2") / C1TimesD;
-
-  // y-component of 1./(C1*D) * Grad_perp(C2)
-  Field3D coef_y = DDY(C2coef, location, "C2") / C1TimesD;
+  splitCoefficients();
 
-  // z-component of 1./(C1*D) * Grad_perp(C2)
-  Field3D coef_z = DDZ(C2coef, location, "FFT") / C1TimesD;
-
-  Field3D AOverD = Acoef / Dcoef;
-
-  // Split coefficients into DC and AC parts so that delp2solver can use DC part.
-  // This allows all-Neumann boundary conditions as long as AOverD_DC is non-zero
-
-  Field2D C1coefTimesD_DC = DC(C1TimesD);
-  Field2D C2coef_DC = DC(C2coef);
-
-  // Our naming is slightly misleading here, as coef_x_AC may actually have a
-  // DC component, as the AC components of C2coef and C1coefTimesD are not
-  // necessarily in phase.
-  // This is the piece that cannot be passed to an FFT-based Laplacian solver
-  // (through our current interface).
-  Field3D coef_x_AC = coef_x - DDX(C2coef_DC, location, "C2") / C1coefTimesD_DC;
-
-  // coef_z is a z-derivative so must already have zero DC component
-
-  Field2D AOverD_DC = DC(AOverD);
-  Field3D AOverD_AC = AOverD - AOverD_DC;
-
-  delp2solver->setCoefA(AOverD_DC);
-  delp2solver->setCoefC1(C1coefTimesD_DC);
-  delp2solver->setCoefC2(C2coef_DC);
+  Field3D rhsOverD = rhs / Dcoef;
 
   // Use this below to normalize error for relative error estimate
   BoutReal RMS_rhsOverD = sqrt(mean(
@@ -276,58 +348,109 @@ Field3D LaplaceNaulin::solve(const Field3D& rhs, const Field3D& x0) {
   auto b_x_pair = calc_b_x_pair(b, x0);
   auto b_x_pair_old = b_x_pair;
 
-  while (true) {
-    Field3D bnew = calc_b_guess(b_x_pair.second);
+  if (anderson_depth > 0) {
+    // Anderson acceleration: the next b is the combination of the last
+    // anderson_depth iterations which minimises the error. Keep the
+    // differences between successive errors and calc_b_guess values.
+    // initial_underrelax_factor is used as the mixing parameter
+    std::deque<Field3D> delta_error, delta_b_guess;
+    Field3D last_error3D, last_b_guess;
 
-    Field3D error3D = b_x_pair.first - bnew;
-    error_abs = max(abs(error3D, "RGN_NOBNDRY"), true, "RGN_NOBNDRY");
-    error_rel = error_abs / RMS_rhsOverD;
+    while (true) {
+      Field3D bnew = calc_b_guess(b_x_pair.second);
 
-    if (error_rel < rtol or error_abs < atol) {
-      break;
-    }
+      Field3D error3D = bnew - b_x_pair.first;
+      error_abs = max(abs(error3D, "RGN_NOBNDRY"), true, "RGN_NOBNDRY");
+      error_rel = error_abs / RMS_rhsOverD;
 
-    ++count;
-    if (count > maxits) {
-      throw BoutException(
-          "LaplaceNaulin error: Not converged within maxits={:d} iterations.", maxits);
-    }
+      if (error_rel < rtol or error_abs < atol) {
+        break;
+      }
 
-    while (error_abs > last_error) {
-      // Iteration seems to be diverging... try underrelaxing and restart
-      underrelax_factor *= .9;
-      ++underrelax_count;
+      ++count;
+      if (count > maxits) {
+        throw BoutException(
+            "LaplaceNaulin error: Not converged within maxits={:d} iterations.", maxits);
+      }
 
-      // Restart from b_x_pair_old - that was our best guess
-      bnew = calc_b_guess(b_x_pair_old.second);
-      b_x_pair = calc_b_x_pair(underrelax_factor * bnew
-                                   + (1. - underrelax_factor) * b_x_pair_old.first,
-                               b_x_pair_old.second);
+      if (last_error3D.isAllocated()) {
+        delta_error.push_back(error3D - last_error3D);
+        delta_b_guess.push_back(bnew - last_b_guess);
+        if (static_cast<int>(delta_error.size()) > anderson_depth) {
+          delta_error.pop_front();
+          delta_b_guess.pop_front();
+        }
+      }
+      last_error3D = error3D;
+      last_b_guess = bnew;
+
+      const auto gamma = andersonCoefficients(delta_error, error3D);
+      if (gamma.empty()) {
+        // Previous iterations are (nearly) linearly dependent, so start again
+        delta_error.clear();
+        delta_b_guess.clear();
+      }
 
-      bnew = calc_b_guess(b_x_pair.second);
+      b = underrelax_factor * bnew + (1. - underrelax_factor) * b_x_pair.first;
+      for (std::size_t i = 0; i < gamma.size(); ++i) {
+        b -= gamma[i] * (delta_b_guess[i] - (1. - underrelax_factor) * delta_error[i]);
+      }
+      b_x_pair = calc_b_x_pair(b, b_x_pair.second);
+    }
+  } else {
+    while (true) {
+      Field3D bnew = calc_b_guess(b_x_pair.second);
 
-      error3D = b_x_pair.first - bnew;
+      Field3D error3D = b_x_pair.first - bnew;
       error_abs = max(abs(error3D, "RGN_NOBNDRY"), true, "RGN_NOBNDRY");
       error_rel = error_abs / RMS_rhsOverD;
 
-      // effectively another iteration, so increment the counter
+      if (error_rel < rtol or error_abs < atol) {
+        break;
+      }
+
       ++count;
       if (count > maxits) {
         throw BoutException(
             "LaplaceNaulin error: Not converged within maxits={:d} iterations.", maxits);
       }
-    }
 
-    // Might have met convergence criterion while in underrelaxation loop
-    if (error_rel < rtol or error_abs < atol) {
-      break;
-    }
+      while (error_abs > last_error) {
+        // Iteration seems to be diverging... try underrelaxing and restart
+        underrelax_factor *= .9;
+        ++underrelax_count;
+
+        // Restart from b_x_pair_old - that was our best guess
+        bnew = calc_b_guess(b_x_pair_old.second);
+        b_x_pair = calc_b_x_pair(underrelax_factor * bnew
+                                     + (1. - underrelax_factor) * b_x_pair_old.first,
+                                 b_x_pair_old.second);
+
+        bnew = calc_b_guess(b_x_pair.second);
 
-    last_error = error_abs;
-    b_x_pair_old = b_x_pair;
-    b_x_pair = calc_b_x_pair(underrelax_factor * bnew
-                                 + (1. - underrelax_factor) * b_x_pair.first,
-                             b_x_pair.second);
+        error3D = b_x_pair.first - bnew;
+        error_abs = max(abs(error3D, "RGN_NOBNDRY"), true, "RGN_NOBNDRY");
+        error_rel = error_abs / RMS_rhsOverD;
+
+        // effectively another iteration, so increment the counter
+        ++count;
+        if (count > maxits) {
+          throw BoutException(
+              "LaplaceNaulin error: Not converged within maxits={:d} iterations.", maxits);
+        }
+      }
+
+      // Might have met convergence criterion while in underrelaxation loop
+      if (error_rel < rtol or error_abs < atol) {
+        break;
+      }
+
+      last_error = error_abs;
+      b_x_pair_old = b_x_pair;
+      b_x_pair = calc_b_x_pair(underrelax_factor * bnew
+                                   + (1. - underrelax_factor) * b_x_pair.first,
+                               b_x_pair.second);
+    }
   }
 
   ++ncalls;
@@ -340,9 +463,66 @@ Field3D LaplaceNaulin::solve(const Field3D& rhs, const Field3D& x0) {
 
   checkData(b_x_pair.second);
 
+  x_previous = b_x_pair.second;
   return b_x_pair.second;
 }
 
+Field3D LaplaceNaulin::solve(const Field3D& b) {
+  if (not use_previous_solution or not x_previous.isAllocated()) {
+    return solve(b, zeroFrom(b));
+  }
+  // With INVERT_SET the boundary guard cells of the initial guess set
+  // the boundary values, so these must be zero as if no guess was given
+  Field3D x0 = x_previous;
+  if (((inner_boundary_flags | outer_boundary_flags) & INVERT_SET) != 0) {
+    copy_x_boundaries(x0, zeroFrom(b), localmesh);
+  }
+  return solve(b, x0);
+}
+
+void LaplaceNaulin::splitCoefficients() {
+  if (split_generation == coefficientGeneration()
+      and split_geometry == coords->geometryGeneration()) {
+    return;
+  }
+
+  Field3D C1TimesD = C1coef * Dcoef; // This is needed several times
+
+  // x-component of 1./(C1*D) * Grad_perp(C2)
+  Field3D coef_x = DDX(C2coef, location, "C2") / C1TimesD;
+
+  // z-component of 1./(C1*D) * Grad_perp(C2)
+  coef_z = DDZ(C2coef, location, "FFT") / C1TimesD;
+
+  Field3D AOverD = Acoef / Dcoef;
+
+  // Split coefficients into DC and AC parts so that delp2solver can use DC part.
+  // This allows all-Neumann boundary conditions as long as AOverD_DC is non-zero
+
+  Field2D C1coefTimesD_DC = DC(C1TimesD);
+  Field2D C2coef_DC = DC(C2coef);
+
+  // Our naming is slightly misleading here, as coef_x_AC may actually have a
+  // DC component, as the AC components of C2coef and C1coefTimesD are not
+  // necessarily in phase.
+  // This is the piece that cannot be passed to an FFT-based Laplacian solver
+  // (through our current interface).
+  coef_x_AC = coef_x - DDX(C2coef_DC, location, "C2") / C1coefTimesD_DC;
+
+  // coef_z is a z-derivative so must already have zero DC component
+
+  Field2D AOverD_DC = DC(AOverD);
+  AOverD_AC = AOverD - AOverD_DC;
+
+  // delp2solver only needs to rebuild its matrices when these change
+  delp2solver->setCoefA(AOverD_DC);
+  delp2solver->setCoefC1(C1coefTimesD_DC);
+  delp2solver->setCoefC2(C2coef_DC);
+
+  split_generation = coefficientGeneration();
+  split_geometry = coords->geometryGeneration();
+}
+
 void LaplaceNaulin::copy_x_boundaries(Field3D& x, const Field3D& x0, Mesh* localmesh) {
   if (localmesh->firstX()) {
     for (int i = localmesh->xstart - 1; i >= 0; --i) {
@@ -60,11 +60,13 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Acoef = val;
+    coefficientsChanged();
   }
   void setCoefA(const Field3D& val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Acoef = val;
+    coefficientsChanged();
   }
   void setCoefC(const Field2D& val) override {
     ASSERT1(val.getLocation() == location);
@@ -82,31 +84,37 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C1coef = val;
+    coefficientsChanged();
   }
   void setCoefC1(const Field2D& val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C1coef = val;
+    coefficientsChanged();
   }
   void setCoefC2(const Field3D& val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C2coef = val;
+    coefficientsChanged();
   }
   void setCoefC2(const Field2D& val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C2coef = val;
+    coefficientsChanged();
   }
   void setCoefD(const Field3D& val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Dcoef = val;
+    coefficientsChanged();
   }
   void setCoefD(const Field2D& val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Dcoef = val;
+    coefficientsChanged();
   }
   void setCoefEx(const Field2D& UNUSED(val)) override {
     throw BoutException("LaplaceNaulin does not have Ex coefficient");
@@ -125,7 +133,9 @@ public:
         "LaplaceNaulin has no solve(FieldPerp), must call solve(Field3D)");
   }
   Field3D solve(const Field3D& b, const Field3D& x0) override;
-  Field3D solve(const Field3D& b) override { return solve(b, zeroFrom(b)); }
+  /// If the `use_previous_solution` option is set, the solution from
+  /// the last call is used as the initial guess
+  Field3D solve(const Field3D& b) override;
 
   // Override flag-setting methods to set delp2solver's flags as well
   void setGlobalFlags(int f) override {
@@ -174,6 +184,31 @@ private:
   /// Counter for the number of times the solver has been called
   int ncalls;
 
+  /// Start from the last solution if no initial guess is given
+  bool use_previous_solution;
+
+  /// Solution from the last call to solve
+  Field3D x_previous;
+
+  /// Number of previous iterations used for Anderson acceleration.
+  /// Zero to use under-relaxed fixed-point iteration
+  int anderson_depth;
+
+  /// Parts of the coefficients which can't be passed to delp2solver.
+  /// These only change when the coefficients or the metric change
+  Field3D coef_x_AC, coef_z, AOverD_AC;
+
+  /// Value of coefficientGeneration() when the coefficients were last
+  /// split between delp2solver and the parts above
+  int split_generation{-1};
+  /// Value of Coordinates::geometryGeneration() at the last split
+  int split_geometry{-1};
+
+  /// Split the coefficients into the DC parts, which are given to
+  /// delp2solver, and the rest. Only done if the coefficients or the
+  /// metric changed since the last call
+  void splitCoefficients();
+
   /// Copy the boundary guard cells from the input 'initial guess' x0 into x.
   /// These may be used to set non-zero-value boundary conditions
   void copy_x_boundaries(Field3D& x, const Field3D& x0, Mesh* mesh);
@@ -132,6 +132,8 @@ LaplacePCR::LaplacePCR(Options* opt, CELL_LOC loc, Mesh* mesh_in, Solver* UNUSED
   myrank = yproc * nprocs + xproc;                  // Global rank for communication
   n_mpi = localmesh->GlobalNxNoBoundaries / nprocs; // Number of internal x
                                                     // grid points per proc
+
+  threaded_comms = BoutComm::threadSupport() >= MPI_THREAD_FUNNELED;
 }
 
 FieldPerp LaplacePCR::solve(const FieldPerp& rhs, const FieldPerp& x0) {
@@ -577,6 +579,7 @@ void LaplacePCR ::cr_pcr_solver(Matrix<dcomplex>& a_mpi, Matrix<dcomplex>& b_mpi
   r.reallocate(nsys, nx + 2);
   x.reallocate(nsys, nx + 2);
 
+  BOUT_OMP(parallel for)
   for (int kz = 0; kz < nsys; kz++) {
     aa(kz, 0) = 0;
     bb(kz, 0) = 1;
@@ -611,6 +614,7 @@ void LaplacePCR ::cr_pcr_solver(Matrix<dcomplex>& a_mpi, Matrix<dcomplex>& b_mpi
 
   // Copy solution back to bout format - this is correct on interior rows, but
   // not boundary rows
+  BOUT_OMP(parallel for)
   for (int kz = 0; kz < nsys; kz++) {
     for (int ix = 0; ix < nx; ix++) {
       x_mpi(kz, ix + xstart - xs) = x(kz, ix + 1);
@@ -630,6 +634,7 @@ void LaplacePCR ::eliminate_boundary_rows(Matrix<dcomplex>& a, Matrix<dcomplex>&
                                           Matrix<dcomplex>& c, Matrix<dcomplex>& r) {
 
   if (localmesh->firstX()) {
+    BOUT_OMP(parallel for)
     for (int kz = 0; kz < nsys; kz++) {
       // Do forward elimination on *all* boundary rows up to xstart
       // This fixes the case where INVERT_BNDRY_ONE is true, but there are more
@@ -642,6 +647,7 @@ void LaplacePCR ::eliminate_boundary_rows(Matrix<dcomplex>& a, Matrix<dcomplex>&
     }
   }
   if (localmesh->lastX()) {
+    BOUT_OMP(parallel for)
     for (int kz = 0; kz < nsys; kz++) {
       // Do forward elimination on *all* boundary rows down to xend
       // This fixes the case where INVERT_BNDRY_ONE is true, but there are more
@@ -665,6 +671,7 @@ void LaplacePCR ::apply_boundary_conditions(const Matrix<dcomplex>& a,
                                             Matrix<dcomplex>& x) {
 
   if (localmesh->firstX()) {
+    BOUT_OMP(parallel for)
     for (int kz = 0; kz < nsys; kz++) {
       for (int ix = localmesh->xstart - 1; ix >= 0; ix--) {
         x(kz, ix) = (r(kz, ix) - c(kz, ix) * x(kz, ix + 1)) / b(kz, ix);
@@ -673,6 +680,7 @@ void LaplacePCR ::apply_boundary_conditions(const Matrix<dcomplex>& a,
   }
   if (localmesh->lastX()) {
     int n = xe - xs + 1; // actual length of array
+    BOUT_OMP(parallel for)
     for (int kz = 0; kz < nsys; kz++) {
       for (int ix = n - localmesh->xstart; ix < n; ix++) {
         x(kz, ix) = (r(kz, ix) - a(kz, ix) * x(kz, ix - 1)) / b(kz, ix);
@@ -690,8 +698,6 @@ void LaplacePCR ::cr_forward_multiple_row(Matrix<dcomplex>& a, Matrix<dcomplex>&
                                           Matrix<dcomplex>& c,
                                           Matrix<dcomplex>& r) const {
   MPI_Comm comm = BoutComm::get();
-  Array<dcomplex> alpha(nsys);
-  Array<dcomplex> gamma(nsys);
   Array<dcomplex> sbuf(4 * nsys);
   Array<dcomplex> rbuf(4 * nsys);
 
@@ -701,56 +707,74 @@ void LaplacePCR ::cr_forward_multiple_row(Matrix<dcomplex>& a, Matrix<dcomplex>&
 
   /// Variable nlevel is used to indicates when single row remains.
   const int nlevel = log2(n_mpi);
-  int dist_row = 1;
-  int dist2_row = 2;
 
-  for (int l = 0; l < nlevel; l++) {
-    const int start = dist2_row;
-    /// Data exchange is performed using MPI send/recv for each succesive reduction
-    if (xproc < nprocs - 1) {
-      MPI_Irecv(&rbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + 1, 0, comm, &request[0]);
-    }
-    if (xproc > 0) {
-      for (int kz = 0; kz < nsys; kz++) {
-        sbuf[0 + 4 * kz] = a(kz, dist_row);
-        sbuf[1 + 4 * kz] = b(kz, dist_row);
-        sbuf[2 + 4 * kz] = c(kz, dist_row);
-        sbuf[3 + 4 * kz] = r(kz, dist_row);
+  /// The systems are shared between threads. Communication is done by
+  /// the master thread only, with the other threads waiting for it. If
+  /// MPI doesn't allow this, only one thread is used
+  BOUT_OMP(parallel if (threaded_comms)) {
+    int dist_row = 1;
+    int dist2_row = 2;
+
+    for (int l = 0; l < nlevel; l++) {
+      const int start = dist2_row;
+      /// Data exchange is performed using MPI send/recv for each succesive reduction
+      if (xproc > 0) {
+        BOUT_OMP(for)
+        for (int kz = 0; kz < nsys; kz++) {
+          sbuf[0 + 4 * kz] = a(kz, dist_row);
+          sbuf[1 + 4 * kz] = b(kz, dist_row);
+          sbuf[2 + 4 * kz] = c(kz, dist_row);
+          sbuf[3 + 4 * kz] = r(kz, dist_row);
+        }
       }
-      MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - 1, 0, comm, &request[1]);
-    }
-    if (xproc < nprocs - 1) {
-      MPI_Wait(&request[0], &status1);
-      for (int kz = 0; kz < nsys; kz++) {
-        a(kz, n_mpi + 1) = rbuf[0 + 4 * kz];
-        b(kz, n_mpi + 1) = rbuf[1 + 4 * kz];
-        c(kz, n_mpi + 1) = rbuf[2 + 4 * kz];
-        r(kz, n_mpi + 1) = rbuf[3 + 4 * kz];
+      BOUT_OMP(master) {
+        if (xproc < nprocs - 1) {
+          MPI_Irecv(&rbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + 1, 0, comm,
+                    &request[0]);
+        }
+        if (xproc > 0) {
+          MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - 1, 0, comm,
+                    &request[1]);
+        }
+        if (xproc < nprocs - 1) {
+          MPI_Wait(&request[0], &status1);
+        }
       }
-    }
+      BOUT_OMP(barrier)
 
-    /// Odd rows of remained rows are reduced to even rows of remained rows in each
-    /// reduction step. Index in of global last row is out of range, but we treat it as a
-    /// = c = r = 0 and b = 1 in main function.
-    for (int i = start; i <= n_mpi; i += dist2_row) {
-      const int ip = i - dist_row;
-      const int in = min(i + dist_row, n_mpi + 1);
+      /// Odd rows of remained rows are reduced to even rows of remained rows in each
+      /// reduction step. Index in of global last row is out of range, but we treat it as
+      /// a = c = r = 0 and b = 1 in main function.
+      BOUT_OMP(for)
       for (int kz = 0; kz < nsys; kz++) {
-        alpha[kz] = -a(kz, i) / b(kz, ip);
-        gamma[kz] = -c(kz, i) / b(kz, in);
-
-        b(kz, i) += (alpha[kz] * c(kz, ip) + gamma[kz] * a(kz, in));
-        a(kz, i) = alpha[kz] * a(kz, ip);
-        c(kz, i) = gamma[kz] * c(kz, in);
-        r(kz, i) += (alpha[kz] * r(kz, ip) + gamma[kz] * r(kz, in));
+        if (xproc < nprocs - 1) {
+          a(kz, n_mpi + 1) = rbuf[0 + 4 * kz];
+          b(kz, n_mpi + 1) = rbuf[1 + 4 * kz];
+          c(kz, n_mpi + 1) = rbuf[2 + 4 * kz];
+          r(kz, n_mpi + 1) = rbuf[3 + 4 * kz];
+        }
+        for (int i = start; i <= n_mpi; i += dist2_row) {
+          const int ip = i - dist_row;
+          const int in = min(i + dist_row, n_mpi + 1);
+          const dcomplex alpha = -a(kz, i) / b(kz, ip);
+          const dcomplex gamma = -c(kz, i) / b(kz, in);
+
+          b(kz, i) += (alpha * c(kz, ip) + gamma * a(kz, in));
+          a(kz, i) = alpha * a(kz, ip);
+          c(kz, i) = gamma * c(kz, in);
+          r(kz, i) += (alpha * r(kz, ip) + gamma * r(kz, in));
+        }
       }
-    }
-    /// As reduction continues, the indices of required coefficients doubles.
-    dist2_row *= 2;
-    dist_row *= 2;
+      /// As reduction continues, the indices of required coefficients doubles.
+      dist2_row *= 2;
+      dist_row *= 2;
 
-    if (xproc > 0) {
-      MPI_Wait(&request[1], &status);
+      if (xproc > 0) {
+        // sbuf can't be refilled until the send is complete
+        BOUT_OMP(master)
+        MPI_Wait(&request[1], &status);
+        BOUT_OMP(barrier)
+      }
     }
   }
 }
@@ -770,35 +794,48 @@ void LaplacePCR ::cr_backward_multiple_row(Matrix<dcomplex>& a, Matrix<dcomplex>
   auto sendvec = Array<dcomplex>(nsys);
 
   const int nlevel = log2(n_mpi);
-  int dist_row = n_mpi / 2;
 
-  /// Each rank requires a solution on last row of previous rank.
-  if (xproc > 0) {
-    MPI_Irecv(&recvvec[0], nsys, MPI_DOUBLE_COMPLEX, myrank - 1, 100, comm, request);
-  }
-  if (xproc < nprocs - 1) {
-    for (int kz = 0; kz < nsys; kz++) {
-      sendvec[kz] = x(kz, n_mpi);
+  BOUT_OMP(parallel if (threaded_comms)) {
+    /// Each rank requires a solution on last row of previous rank.
+    if (xproc < nprocs - 1) {
+      BOUT_OMP(for)
+      for (int kz = 0; kz < nsys; kz++) {
+        sendvec[kz] = x(kz, n_mpi);
+      }
     }
-    MPI_Isend(&sendvec[0], nsys, MPI_DOUBLE_COMPLEX, myrank + 1, 100, comm, request + 1);
-  }
-  if (xproc > 0) {
-    MPI_Wait(request, &status);
-    for (int kz = 0; kz < nsys; kz++) {
-      x(kz, 0) = recvvec[kz];
+    BOUT_OMP(master) {
+      if (xproc > 0) {
+        MPI_Irecv(&recvvec[0], nsys, MPI_DOUBLE_COMPLEX, myrank - 1, 100, comm, request);
+      }
+      if (xproc < nprocs - 1) {
+        MPI_Isend(&sendvec[0], nsys, MPI_DOUBLE_COMPLEX, myrank + 1, 100, comm,
+                  request + 1);
+      }
+      if (xproc > 0) {
+        MPI_Wait(request, &status);
+      }
     }
-  }
-  for (int l = nlevel - 1; l >= 0; l--) {
-    const int dist2_row = dist_row * 2;
-    for (int i = n_mpi - dist_row; i >= 0; i -= dist2_row) {
-      const int ip = i - dist_row;
-      const int in = i + dist_row;
-      for (int kz = 0; kz < nsys; kz++) {
-        x(kz, i) = r(kz, i) - c(kz, i) * x(kz, in) - a(kz, i) * x(kz, ip);
-        x(kz, i) = x(kz, i) / b(kz, i);
+    BOUT_OMP(barrier)
+
+    /// The remaining levels don't need any communication, so each
+    /// system can be finished independently
+    BOUT_OMP(for nowait)
+    for (int kz = 0; kz < nsys; kz++) {
+      if (xproc > 0) {
+        x(kz, 0) = recvvec[kz];
+      }
+      int dist_row = n_mpi / 2;
+      for (int l = nlevel - 1; l >= 0; l--) {
+        const int dist2_row = dist_row * 2;
+        for (int i = n_mpi - dist_row; i >= 0; i -= dist2_row) {
+          const int ip = i - dist_row;
+          const int in = i + dist_row;
+          x(kz, i) = r(kz, i) - c(kz, i) * x(kz, in) - a(kz, i) * x(kz, ip);
+          x(kz, i) = x(kz, i) / b(kz, i);
+        }
+        dist_row = dist_row / 2;
       }
     }
-    dist_row = dist_row / 2;
   }
   if (xproc < nprocs - 1) {
     MPI_Wait(request + 1, &status);
@@ -813,8 +850,6 @@ void LaplacePCR ::pcr_forward_single_row(Matrix<dcomplex>& a, Matrix<dcomplex>&
                                          Matrix<dcomplex>& c, Matrix<dcomplex>& r,
                                          Matrix<dcomplex>& x) const {
 
-  Array<dcomplex> alpha(nsys);
-  Array<dcomplex> gamma(nsys);
   Array<dcomplex> sbuf(4 * nsys);
   Array<dcomplex> rbuf0(4 * nsys);
   Array<dcomplex> rbuf1(4 * nsys);
@@ -825,190 +860,148 @@ void LaplacePCR ::pcr_forward_single_row(Matrix<dcomplex>& a, Matrix<dcomplex>&
 
   const int nlevel = log2(nprocs);
   const int nhprocs = nprocs / 2;
-  int dist_rank = 1;
-  int dist2_rank = 2;
 
-  /// Parallel cyclic reduction continues until 2x2 matrix are made between a pair of
-  /// rank, (myrank, myrank+nhprocs).
-  for (int l = 0; l < nlevel - 1; l++) {
+  /// As in cr_forward_multiple_row, only the master thread communicates
+  BOUT_OMP(parallel if (threaded_comms)) {
+    int dist_rank = 1;
 
-    /// Rank is newly calculated in each level to find communication pair.
-    /// Nprocs is also newly calculated as myrank is changed.
-    const int myrank_level = xproc / dist_rank;
-    const int nprocs_level = nprocs / dist_rank;
+    /// Parallel cyclic reduction continues until 2x2 matrix are made between a pair of
+    /// rank, (myrank, myrank+nhprocs).
+    for (int l = 0; l < nlevel - 1; l++) {
 
-    /// All rows exchange data for reduction and perform reduction successively.
-    /// Coefficients are updated for every rows.
-    for (int kz = 0; kz < nsys; kz++) {
-      sbuf[0 + 4 * kz] = a(kz, n_mpi);
-      sbuf[1 + 4 * kz] = b(kz, n_mpi);
-      sbuf[2 + 4 * kz] = c(kz, n_mpi);
-      sbuf[3 + 4 * kz] = r(kz, n_mpi);
-    }
+      /// Rank is newly calculated in each level to find communication pair.
+      /// Nprocs is also newly calculated as myrank is changed.
+      const int myrank_level = xproc / dist_rank;
+      const int nprocs_level = nprocs / dist_rank;
 
-    if ((myrank_level + 1) % 2 == 0) {
-      if (xproc + dist_rank < nprocs) {
-        MPI_Irecv(&rbuf1[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + dist_rank, 202, comm,
-                  &request[0]);
-        MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + dist_rank, 203, comm,
-                  &request[1]);
-      }
-      if (xproc - dist_rank >= 0) {
-        MPI_Irecv(&rbuf0[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - dist_rank, 200, comm,
-                  &request[2]);
-        MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - dist_rank, 201, comm,
-                  &request[3]);
+      /// All rows exchange data for reduction and perform reduction successively.
+      /// Coefficients are updated for every rows.
+      BOUT_OMP(for)
+      for (int kz = 0; kz < nsys; kz++) {
+        sbuf[0 + 4 * kz] = a(kz, n_mpi);
+        sbuf[1 + 4 * kz] = b(kz, n_mpi);
+        sbuf[2 + 4 * kz] = c(kz, n_mpi);
+        sbuf[3 + 4 * kz] = r(kz, n_mpi);
       }
-      if (xproc + dist_rank < nprocs) {
-        MPI_Wait(&request[0], &status);
-        for (int kz = 0; kz < nsys; kz++) {
-          a(kz, n_mpi + 1) = rbuf1[0 + 4 * kz];
-          b(kz, n_mpi + 1) = rbuf1[1 + 4 * kz];
-          c(kz, n_mpi + 1) = rbuf1[2 + 4 * kz];
-          r(kz, n_mpi + 1) = rbuf1[3 + 4 * kz];
+
+      BOUT_OMP(master) {
+        const bool even = (myrank_level + 1) % 2 == 0;
+        if (xproc + dist_rank < nprocs) {
+          MPI_Irecv(&rbuf1[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + dist_rank,
+                    even ? 202 : 201, comm, &request[0]);
+          MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + dist_rank,
+                    even ? 203 : 200, comm, &request[1]);
         }
-        MPI_Wait(&request[1], &status);
-      }
-      if (xproc - dist_rank >= 0) {
-        MPI_Wait(&request[2], &status);
-        for (int kz = 0; kz < nsys; kz++) {
-          a(kz, 0) = rbuf0[0 + 4 * kz];
-          b(kz, 0) = rbuf0[1 + 4 * kz];
-          c(kz, 0) = rbuf0[2 + 4 * kz];
-          r(kz, 0) = rbuf0[3 + 4 * kz];
+        if (xproc - dist_rank >= 0) {
+          MPI_Irecv(&rbuf0[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - dist_rank,
+                    even ? 200 : 203, comm, &request[2]);
+          MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - dist_rank,
+                    even ? 201 : 202, comm, &request[3]);
+        }
+        if (xproc + dist_rank < nprocs) {
+          MPI_Wait(&request[0], &status);
+          MPI_Wait(&request[1], &status);
+        }
+        if (xproc - dist_rank >= 0) {
+          MPI_Wait(&request[2], &status);
+          MPI_Wait(&request[3], &status);
         }
-        MPI_Wait(&request[3], &status);
-      }
-    } else if ((myrank_level + 1) % 2 == 1) {
-      if (xproc + dist_rank < nprocs) {
-        MPI_Irecv(&rbuf1[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + dist_rank, 201, comm,
-                  &request[0]);
-        MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + dist_rank, 200, comm,
-                  &request[1]);
-      }
-      if (xproc - dist_rank >= 0) {
-        MPI_Irecv(&rbuf0[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - dist_rank, 203, comm,
-                  &request[2]);
-        MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - dist_rank, 202, comm,
-                  &request[3]);
       }
-      if (xproc + dist_rank < nprocs) {
-        MPI_Wait(&request[0], &status);
-        for (int kz = 0; kz < nsys; kz++) {
+      BOUT_OMP(barrier)
+
+      const int i = n_mpi;
+      const int ip = 0;
+      const int in = i + 1;
+      BOUT_OMP(for)
+      for (int kz = 0; kz < nsys; kz++) {
+        if (xproc + dist_rank < nprocs) {
           a(kz, n_mpi + 1) = rbuf1[0 + 4 * kz];
           b(kz, n_mpi + 1) = rbuf1[1 + 4 * kz];
           c(kz, n_mpi + 1) = rbuf1[2 + 4 * kz];
           r(kz, n_mpi + 1) = rbuf1[3 + 4 * kz];
         }
-        MPI_Wait(&request[1], &status);
-      }
-      if (xproc - dist_rank >= 0) {
-        MPI_Wait(&request[2], &status);
-        for (int kz = 0; kz < nsys; kz++) {
+        if (xproc - dist_rank >= 0) {
           a(kz, 0) = rbuf0[0 + 4 * kz];
           b(kz, 0) = rbuf0[1 + 4 * kz];
           c(kz, 0) = rbuf0[2 + 4 * kz];
           r(kz, 0) = rbuf0[3 + 4 * kz];
         }
-        MPI_Wait(&request[3], &status);
-      }
-    }
 
-    const int i = n_mpi;
-    const int ip = 0;
-    const int in = i + 1;
-    if (myrank_level == 0) {
-      for (int kz = 0; kz < nsys; kz++) {
-        alpha[kz] = 0.0;
-      }
-    } else {
-      for (int kz = 0; kz < nsys; kz++) {
-        alpha[kz] = -a(kz, i) / b(kz, ip);
-      }
-    }
-    if (myrank_level == nprocs_level - 1) {
-      for (int kz = 0; kz < nsys; kz++) {
-        gamma[kz] = 0.0;
-      }
-    } else {
-      for (int kz = 0; kz < nsys; kz++) {
-        gamma[kz] = -c(kz, i) / b(kz, in);
+        const dcomplex alpha = (myrank_level == 0) ? 0.0 : -a(kz, i) / b(kz, ip);
+        const dcomplex gamma =
+            (myrank_level == nprocs_level - 1) ? 0.0 : -c(kz, i) / b(kz, in);
+
+        b(kz, i) += (alpha * c(kz, ip) + gamma * a(kz, in));
+        a(kz, i) = alpha * a(kz, ip);
+        c(kz, i) = gamma * c(kz, in);
+        r(kz, i) += (alpha * r(kz, ip) + gamma * r(kz, in));
       }
-    }
 
-    for (int kz = 0; kz < nsys; kz++) {
-      b(kz, i) += (alpha[kz] * c(kz, ip) + gamma[kz] * a(kz, in));
-      a(kz, i) = alpha[kz] * a(kz, ip);
-      c(kz, i) = gamma[kz] * c(kz, in);
-      r(kz, i) += (alpha[kz] * r(kz, ip) + gamma[kz] * r(kz, in));
+      dist_rank *= 2;
     }
 
-    dist_rank *= 2;
-    dist2_rank *= 2;
-  }
-
-  /// Solving 2x2 matrix. All pair of ranks, myrank and myrank+nhprocs, solves it
-  /// simultaneously.
-  for (int kz = 0; kz < nsys; kz++) {
-    sbuf[0 + 4 * kz] = a(kz, n_mpi);
-    sbuf[1 + 4 * kz] = b(kz, n_mpi);
-    sbuf[2 + 4 * kz] = c(kz, n_mpi);
-    sbuf[3 + 4 * kz] = r(kz, n_mpi);
-  }
-  if (xproc < nhprocs) {
-    MPI_Irecv(&rbuf1[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + nhprocs, 300, comm,
-              &request[0]);
-    MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + nhprocs, 301, comm,
-              &request[1]);
-
-    MPI_Wait(&request[0], &status);
+    /// Solving 2x2 matrix. All pair of ranks, myrank and myrank+nhprocs, solves it
+    /// simultaneously.
+    BOUT_OMP(for)
     for (int kz = 0; kz < nsys; kz++) {
-      a(kz, n_mpi + 1) = rbuf1[0 + 4 * kz];
-      b(kz, n_mpi + 1) = rbuf1[1 + 4 * kz];
-      c(kz, n_mpi + 1) = rbuf1[2 + 4 * kz];
-      r(kz, n_mpi + 1) = rbuf1[3 + 4 * kz];
+      sbuf[0 + 4 * kz] = a(kz, n_mpi);
+      sbuf[1 + 4 * kz] = b(kz, n_mpi);
+      sbuf[2 + 4 * kz] = c(kz, n_mpi);
+      sbuf[3 + 4 * kz] = r(kz, n_mpi);
     }
-
-    const int i = n_mpi;
-    const int in = n_mpi + 1;
-
-    for (int kz = 0; kz < nsys; kz++) {
-      const dcomplex det = b(kz, i) * b(kz, in) - c(kz, i) * a(kz, in);
-      x(kz, i) = (r(kz, i) * b(kz, in) - r(kz, in) * c(kz, i)) / det;
-      x(kz, in) = (r(kz, in) * b(kz, i) - r(kz, i) * a(kz, in)) / det;
+    BOUT_OMP(master) {
+      if (xproc < nhprocs) {
+        MPI_Irecv(&rbuf1[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + nhprocs, 300, comm,
+                  &request[0]);
+        MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + nhprocs, 301, comm,
+                  &request[1]);
+        MPI_Wait(&request[0], &status);
+        MPI_Wait(&request[1], &status);
+      } else if (nhprocs > 0) {
+        // nhprocs=0 if and only if NXPE=1. This check skips communication and
+        // allows the serial case to work
+        MPI_Irecv(&rbuf0[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - nhprocs, 301, comm,
+                  &request[2]);
+        MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - nhprocs, 300, comm,
+                  &request[3]);
+        MPI_Wait(&request[2], &status);
+        MPI_Wait(&request[3], &status);
+      }
     }
-    MPI_Wait(&request[1], &status);
-
-  } else if (xproc >= nhprocs) {
+    BOUT_OMP(barrier)
 
-    // nhprocs=0 if and only if NXPE=1. This check skips communication and
-    // allows the serial case to work:
-    if (nhprocs > 0) {
-      MPI_Irecv(&rbuf0[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - nhprocs, 301, comm,
-                &request[2]);
-      MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - nhprocs, 300, comm,
-                &request[3]);
+    if (xproc < nhprocs) {
+      const int i = n_mpi;
+      const int in = n_mpi + 1;
 
-      MPI_Wait(&request[2], &status);
+      BOUT_OMP(for nowait)
       for (int kz = 0; kz < nsys; kz++) {
-        a(kz, 0) = rbuf0[0 + 4 * kz];
-        b(kz, 0) = rbuf0[1 + 4 * kz];
-        c(kz, 0) = rbuf0[2 + 4 * kz];
-        r(kz, 0) = rbuf0[3 + 4 * kz];
+        a(kz, in) = rbuf1[0 + 4 * kz];
+        b(kz, in) = rbuf1[1 + 4 * kz];
+        c(kz, in) = rbuf1[2 + 4 * kz];
+        r(kz, in) = rbuf1[3 + 4 * kz];
+
+        const dcomplex det = b(kz, i) * b(kz, in) - c(kz, i) * a(kz, in);
+        x(kz, i) = (r(kz, i) * b(kz, in) - r(kz, in) * c(kz, i)) / det;
+        x(kz, in) = (r(kz, in) * b(kz, i) - r(kz, i) * a(kz, in)) / det;
       }
-    }
-
-    const int ip = 0;
-    const int i = n_mpi;
+    } else {
+      const int ip = 0;
+      const int i = n_mpi;
 
-    for (int kz = 0; kz < nsys; kz++) {
-      const dcomplex det = b(kz, ip) * b(kz, i) - c(kz, ip) * a(kz, i);
-      x(kz, ip) = (r(kz, ip) * b(kz, i) - r(kz, i) * c(kz, ip)) / det;
-      x(kz, i) = (r(kz, i) * b(kz, ip) - r(kz, ip) * a(kz, i)) / det;
-    }
+      BOUT_OMP(for nowait)
+      for (int kz = 0; kz < nsys; kz++) {
+        if (nhprocs > 0) {
+          a(kz, ip) = rbuf0[0 + 4 * kz];
+          b(kz, ip) = rbuf0[1 + 4 * kz];
+          c(kz, ip) = rbuf0[2 + 4 * kz];
+          r(kz, ip) = rbuf0[3 + 4 * kz];
+        }
 
-    if (nhprocs > 0) {
-      MPI_Wait(&request[3], &status);
+        const dcomplex det = b(kz, ip) * b(kz, i) - c(kz, ip) * a(kz, i);
+        x(kz, ip) = (r(kz, ip) * b(kz, i) - r(kz, i) * c(kz, ip)) / det;
+        x(kz, i) = (r(kz, i) * b(kz, ip) - r(kz, ip) * a(kz, i)) / det;
+      }
     }
   }
 }
@@ -118,6 +118,10 @@ private:
   /// MPI process x ID
   int xproc;
 
+  /// Can the master thread make MPI calls inside OpenMP parallel
+  /// regions? If not, the stages which communicate use one thread
+  bool threaded_comms;
+
   /// Number of inner boundary cells
   int inbndry;
   /// Number of outer boundary cells
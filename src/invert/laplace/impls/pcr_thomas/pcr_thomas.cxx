@@ -128,6 +128,8 @@ LaplacePCR_THOMAS::LaplacePCR_THOMAS(Options* opt, CELL_LOC loc, Mesh* mesh_in,
   myrank = yproc * nprocs + xproc;                  // Global rank for communication
   n_mpi = localmesh->GlobalNxNoBoundaries / nprocs; // Number of internal x
                                                     // grid points per proc
+
+  threaded_comms = BoutComm::threadSupport() >= MPI_THREAD_FUNNELED;
 }
 
 FieldPerp LaplacePCR_THOMAS::solve(const FieldPerp& rhs, const FieldPerp& x0) {
@@ -577,6 +579,7 @@ void LaplacePCR_THOMAS ::pcr_thomas_solver(Matrix<dcomplex>& a_mpi,
   r.reallocate(nsys, nx + 2);
   x.reallocate(nsys, nx + 2);
 
+  BOUT_OMP(parallel for)
   for (int kz = 0; kz < nsys; kz++) {
     aa(kz, 0) = 0;
     bb(kz, 0) = 1;
@@ -609,6 +612,7 @@ void LaplacePCR_THOMAS ::pcr_thomas_solver(Matrix<dcomplex>& a_mpi,
 
   // Copy solution back to bout format - this is correct on interior rows, but
   // not boundary rows
+  BOUT_OMP(parallel for)
   for (int kz = 0; kz < nsys; kz++) {
     for (int ix = 0; ix < nx; ix++) {
       x_mpi(kz, ix + xstart - xs) = x(kz, ix + 1);
@@ -632,6 +636,7 @@ void LaplacePCR_THOMAS ::eliminate_boundary_rows(const Matrix<dcomplex>& a,
   if (localmesh->firstX()) {
     // x index is first interior row
     const int xstart = localmesh->xstart;
+    BOUT_OMP(parallel for)
     for (int kz = 0; kz < nsys; kz++) {
       b(kz, xstart) =
           b(kz, xstart) - c(kz, xstart - 1) * a(kz, xstart) / b(kz, xstart - 1);
@@ -644,6 +649,7 @@ void LaplacePCR_THOMAS ::eliminate_boundary_rows(const Matrix<dcomplex>& a,
   if (localmesh->lastX()) {
     int n = xe - xs + 1; // actual length of array
     int xind = n - localmesh->xstart - 1;
+    BOUT_OMP(parallel for)
     for (int kz = 0; kz < nsys; kz++) {
       // x index is last interior row
       b(kz, xind) = b(kz, xind) - c(kz, xind) * a(kz, xind + 1) / b(kz, xind + 1);
@@ -664,6 +670,7 @@ void LaplacePCR_THOMAS ::apply_boundary_conditions(const Matrix<dcomplex>& a,
                                                    Matrix<dcomplex>& x) {
 
   if (localmesh->firstX()) {
+    BOUT_OMP(parallel for)
     for (int kz = 0; kz < nsys; kz++) {
       for (int ix = localmesh->xstart - 1; ix >= 0; ix--) {
         x(kz, ix) = (r(kz, ix) - c(kz, ix) * x(kz, ix + 1)) / b(kz, ix);
@@ -672,6 +679,7 @@ void LaplacePCR_THOMAS ::apply_boundary_conditions(const Matrix<dcomplex>& a,
   }
   if (localmesh->lastX()) {
     int n = xe - xs + 1; // actual length of array
+    BOUT_OMP(parallel for)
     for (int kz = 0; kz < nsys; kz++) {
       for (int ix = n - localmesh->xstart; ix < n; ix++) {
         x(kz, ix) = (r(kz, ix) - a(kz, ix) * x(kz, ix - 1)) / b(kz, ix);
@@ -814,8 +822,6 @@ void LaplacePCR_THOMAS ::pcr_forward_single_row(Matrix<dcomplex>& a, Matrix<dcom
                                                 Matrix<dcomplex>& c, Matrix<dcomplex>& r,
                                                 Matrix<dcomplex>& x) const {
 
-  Array<dcomplex> alpha(nsys);
-  Array<dcomplex> gamma(nsys);
   Array<dcomplex> sbuf(4 * nsys);
   Array<dcomplex> rbuf0(4 * nsys);
   Array<dcomplex> rbuf1(4 * nsys);
@@ -826,158 +832,154 @@ void LaplacePCR_THOMAS ::pcr_forward_single_row(Matrix<dcomplex>& a, Matrix<dcom
 
   const int nlevel = static_cast<int>(std::log2(nprocs));
   const int nhprocs = nprocs / 2;
-  int dist_rank = 1;
-
-  /// Parallel cyclic reduction continues until 2x2 matrix are made between a pair of
-  /// rank, (myrank, myrank+nhprocs).
-  for (int level = 0; level < nlevel - 1; level++) {
 
-    /// Rank is newly calculated in each level to find communication pair.
-    /// Nprocs is also newly calculated as myrank is changed.
-    const int myrank_level = xproc / dist_rank;
-    const int nprocs_level = nprocs / dist_rank;
+  /// The systems are shared between threads, but only the master
+  /// thread communicates. If MPI doesn't allow this, only one thread
+  /// is used
+  BOUT_OMP(parallel if (threaded_comms)) {
+    int dist_rank = 1;
 
-    /// All rows exchange data for reduction and perform reduction successively.
-    /// Coefficients are updated for every rows.
-    for (int kz = 0; kz < nsys; kz++) {
-      sbuf[0 + 4 * kz] = a(kz, n_mpi);
-      sbuf[1 + 4 * kz] = b(kz, n_mpi);
-      sbuf[2 + 4 * kz] = c(kz, n_mpi);
-      sbuf[3 + 4 * kz] = r(kz, n_mpi);
-    }
+    /// Parallel cyclic reduction continues until 2x2 matrix are made between a pair of
+    /// rank, (myrank, myrank+nhprocs).
+    for (int level = 0; level < nlevel - 1; level++) {
 
-    const int tag_recv_in = 200;
-    const int tag_recv_out = 201;
-    const int tag_send_in = 201;
-    const int tag_send_out = 200;
+      /// Rank is newly calculated in each level to find communication pair.
+      /// Nprocs is also newly calculated as myrank is changed.
+      const int myrank_level = xproc / dist_rank;
+      const int nprocs_level = nprocs / dist_rank;
 
-    if (xproc + dist_rank < nprocs) {
-      MPI_Irecv(&rbuf1[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + dist_rank, tag_recv_out,
-                comm, &request[0]);
-      MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + dist_rank, tag_send_out,
-                comm, &request[1]);
-    }
-    if (xproc - dist_rank >= 0) {
-      MPI_Irecv(&rbuf0[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - dist_rank, tag_recv_in,
-                comm, &request[2]);
-      MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - dist_rank, tag_send_in,
-                comm, &request[3]);
-    }
-    if (xproc + dist_rank < nprocs) {
-      MPI_Wait(&request[0], &status);
-      for (int kz = 0; kz < nsys; kz++) {
-        a(kz, n_mpi + 1) = rbuf1[0 + 4 * kz];
-        b(kz, n_mpi + 1) = rbuf1[1 + 4 * kz];
-        c(kz, n_mpi + 1) = rbuf1[2 + 4 * kz];
-        r(kz, n_mpi + 1) = rbuf1[3 + 4 * kz];
-      }
-      MPI_Wait(&request[1], &status);
-    }
-    if (xproc - dist_rank >= 0) {
-      MPI_Wait(&request[2], &status);
+      /// All rows exchange data for reduction and perform reduction successively.
+      /// Coefficients are updated for every rows.
+      BOUT_OMP(for)
       for (int kz = 0; kz < nsys; kz++) {
-        a(kz, 0) = rbuf0[0 + 4 * kz];
-        b(kz, 0) = rbuf0[1 + 4 * kz];
-        c(kz, 0) = rbuf0[2 + 4 * kz];
-        r(kz, 0) = rbuf0[3 + 4 * kz];
+        sbuf[0 + 4 * kz] = a(kz, n_mpi);
+        sbuf[1 + 4 * kz] = b(kz, n_mpi);
+        sbuf[2 + 4 * kz] = c(kz, n_mpi);
+        sbuf[3 + 4 * kz] = r(kz, n_mpi);
       }
-      MPI_Wait(&request[3], &status);
-    }
 
-    const int i = n_mpi;
-    const int ip = 0;
-    const int in = i + 1;
-    if (myrank_level == 0) {
-      for (int kz = 0; kz < nsys; kz++) {
-        alpha[kz] = 0.0;
-      }
-    } else {
-      for (int kz = 0; kz < nsys; kz++) {
-        alpha[kz] = -a(kz, i) / b(kz, ip);
-      }
-    }
-    if (myrank_level == nprocs_level - 1) {
-      for (int kz = 0; kz < nsys; kz++) {
-        gamma[kz] = 0.0;
-      }
-    } else {
-      for (int kz = 0; kz < nsys; kz++) {
-        gamma[kz] = -c(kz, i) / b(kz, in);
+      BOUT_OMP(master) {
+        const int tag_recv_in = 200;
+        const int tag_recv_out = 201;
+        const int tag_send_in = 201;
+        const int tag_send_out = 200;
+
+        if (xproc + dist_rank < nprocs) {
+          MPI_Irecv(&rbuf1[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + dist_rank,
+                    tag_recv_out, comm, &request[0]);
+          MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + dist_rank,
+                    tag_send_out, comm, &request[1]);
+        }
+        if (xproc - dist_rank >= 0) {
+          MPI_Irecv(&rbuf0[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - dist_rank,
+                    tag_recv_in, comm, &request[2]);
+          MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - dist_rank,
+                    tag_send_in, comm, &request[3]);
+        }
+        if (xproc + dist_rank < nprocs) {
+          MPI_Wait(&request[0], &status);
+          MPI_Wait(&request[1], &status);
+        }
+        if (xproc - dist_rank >= 0) {
+          MPI_Wait(&request[2], &status);
+          MPI_Wait(&request[3], &status);
+        }
       }
-    }
+      BOUT_OMP(barrier)
 
-    for (int kz = 0; kz < nsys; kz++) {
-      b(kz, i) += (alpha[kz] * c(kz, ip) + gamma[kz] * a(kz, in));
-      a(kz, i) = alpha[kz] * a(kz, ip);
-      c(kz, i) = gamma[kz] * c(kz, in);
-      r(kz, i) += (alpha[kz] * r(kz, ip) + gamma[kz] * r(kz, in));
-    }
+      const int i = n_mpi;
+      const int ip = 0;
+      const int in = i + 1;
+      BOUT_OMP(for)
+      for (int kz = 0; kz < nsys; kz++) {
+        if (xproc + dist_rank < nprocs) {
+          a(kz, n_mpi + 1) = rbuf1[0 + 4 * kz];
+          b(kz, n_mpi + 1) = rbuf1[1 + 4 * kz];
+          c(kz, n_mpi + 1) = rbuf1[2 + 4 * kz];
+          r(kz, n_mpi + 1) = rbuf1[3 + 4 * kz];
+        }
+        if (xproc - dist_rank >= 0) {
+          a(kz, 0) = rbuf0[0 + 4 * kz];
+          b(kz, 0) = rbuf0[1 + 4 * kz];
+          c(kz, 0) = rbuf0[2 + 4 * kz];
+          r(kz, 0) = rbuf0[3 + 4 * kz];
+        }
 
-    dist_rank *= 2;
-  }
+        const dcomplex alpha = (myrank_level == 0) ? 0.0 : -a(kz, i) / b(kz, ip);
+        const dcomplex gamma =
+            (myrank_level == nprocs_level - 1) ? 0.0 : -c(kz, i) / b(kz, in);
 
-  /// Solving 2x2 matrix. All pair of ranks, myrank and myrank+nhprocs, solves it
-  /// simultaneously.
-  for (int kz = 0; kz < nsys; kz++) {
-    sbuf[0 + 4 * kz] = a(kz, n_mpi);
-    sbuf[1 + 4 * kz] = b(kz, n_mpi);
-    sbuf[2 + 4 * kz] = c(kz, n_mpi);
-    sbuf[3 + 4 * kz] = r(kz, n_mpi);
-  }
-  if (xproc < nhprocs) {
-    MPI_Irecv(&rbuf1[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + nhprocs, 300, comm,
-              &request[0]);
-    MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + nhprocs, 301, comm,
-              &request[1]);
+        b(kz, i) += (alpha * c(kz, ip) + gamma * a(kz, in));
+        a(kz, i) = alpha * a(kz, ip);
+        c(kz, i) = gamma * c(kz, in);
+        r(kz, i) += (alpha * r(kz, ip) + gamma * r(kz, in));
+      }
 
-    MPI_Wait(&request[0], &status);
-    for (int kz = 0; kz < nsys; kz++) {
-      a(kz, n_mpi + 1) = rbuf1[0 + 4 * kz];
-      b(kz, n_mpi + 1) = rbuf1[1 + 4 * kz];
-      c(kz, n_mpi + 1) = rbuf1[2 + 4 * kz];
-      r(kz, n_mpi + 1) = rbuf1[3 + 4 * kz];
+      dist_rank *= 2;
     }
 
-    const int i = n_mpi;
-    const int in = n_mpi + 1;
-
+    /// Solving 2x2 matrix. All pair of ranks, myrank and myrank+nhprocs, solves it
+    /// simultaneously.
+    BOUT_OMP(for)
     for (int kz = 0; kz < nsys; kz++) {
-      const dcomplex det = b(kz, i) * b(kz, in) - c(kz, i) * a(kz, in);
-      x(kz, i) = (r(kz, i) * b(kz, in) - r(kz, in) * c(kz, i)) / det;
-      x(kz, in) = (r(kz, in) * b(kz, i) - r(kz, i) * a(kz, in)) / det;
+      sbuf[0 + 4 * kz] = a(kz, n_mpi);
+      sbuf[1 + 4 * kz] = b(kz, n_mpi);
+      sbuf[2 + 4 * kz] = c(kz, n_mpi);
+      sbuf[3 + 4 * kz] = r(kz, n_mpi);
     }
-    MPI_Wait(&request[1], &status);
-
-  } else if (xproc >= nhprocs) {
+    BOUT_OMP(master) {
+      if (xproc < nhprocs) {
+        MPI_Irecv(&rbuf1[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + nhprocs, 300, comm,
+                  &request[0]);
+        MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + nhprocs, 301, comm,
+                  &request[1]);
+        MPI_Wait(&request[0], &status);
+        MPI_Wait(&request[1], &status);
+      } else if (nhprocs > 0) {
+        // nhprocs=0 if and only if NXPE=1. This check skips communication and
+        // allows the serial case to work
+        MPI_Irecv(&rbuf0[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - nhprocs, 301, comm,
+                  &request[2]);
+        MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - nhprocs, 300, comm,
+                  &request[3]);
+        MPI_Wait(&request[2], &status);
+        MPI_Wait(&request[3], &status);
+      }
+    }
+    BOUT_OMP(barrier)
 
-    // nhprocs=0 if and only if NXPE=1. This check skips communication and
-    // allows the serial case to work:
-    if (nhprocs > 0) {
-      MPI_Irecv(&rbuf0[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - nhprocs, 301, comm,
-                &request[2]);
-      MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - nhprocs, 300, comm,
-                &request[3]);
+    if (xproc < nhprocs) {
+      const int i = n_mpi;
+      const int in = n_mpi + 1;
 
-      MPI_Wait(&request[2], &status);
+      BOUT_OMP(for nowait)
       for (int kz = 0; kz < nsys; kz++) {
-        a(kz, 0) = rbuf0[0 + 4 * kz];
-        b(kz, 0) = rbuf0[1 + 4 * kz];
-        c(kz, 0) = rbuf0[2 + 4 * kz];
-        r(kz, 0) = rbuf0[3 + 4 * kz];
+        a(kz, in) = rbuf1[0 + 4 * kz];
+        b(kz, in) = rbuf1[1 + 4 * kz];
+        c(kz, in) = rbuf1[2 + 4 * kz];
+        r(kz, in) = rbuf1[3 + 4 * kz];
+
+        const dcomplex det = b(kz, i) * b(kz, in) - c(kz, i) * a(kz, in);
+        x(kz, i) = (r(kz, i) * b(kz, in) - r(kz, in) * c(kz, i)) / det;
+        x(kz, in) = (r(kz, in) * b(kz, i) - r(kz, i) * a(kz, in)) / det;
       }
-    }
-
-    const int ip = 0;
-    const int i = n_mpi;
+    } else {
+      const int ip = 0;
+      const int i = n_mpi;
 
-    for (int kz = 0; kz < nsys; kz++) {
-      const dcomplex det = b(kz, ip) * b(kz, i) - c(kz, ip) * a(kz, i);
-      x(kz, ip) = (r(kz, ip) * b(kz, i) - r(kz, i) * c(kz, ip)) / det;
-      x(kz, i) = (r(kz, i) * b(kz, ip) - r(kz, ip) * a(kz, i)) / det;
-    }
+      BOUT_OMP(for nowait)
+      for (int kz = 0; kz < nsys; kz++) {
+        if (nhprocs > 0) {
+          a(kz, ip) = rbuf0[0 + 4 * kz];
+          b(kz, ip) = rbuf0[1 + 4 * kz];
+          c(kz, ip) = rbuf0[2 + 4 * kz];
+          r(kz, ip) = rbuf0[3 + 4 * kz];
+        }
 
-    if (nhprocs > 0) {
-      MPI_Wait(&request[3], &status);
+        const dcomplex det = b(kz, ip) * b(kz, i) - c(kz, ip) * a(kz, i);
+        x(kz, ip) = (r(kz, ip) * b(kz, i) - r(kz, i) * c(kz, ip)) / det;
+        x(kz, i) = (r(kz, i) * b(kz, ip) - r(kz, ip) * a(kz, i)) / det;
+      }
     }
   }
 }
@@ -991,6 +993,7 @@ void LaplacePCR_THOMAS ::pThomas_forward_multiple_row(Matrix<dcomplex>& a,
                                                       Matrix<dcomplex>& b,
                                                       Matrix<dcomplex>& c,
                                                       Matrix<dcomplex>& r) const {
+  BOUT_OMP(parallel for)
   for (int kz = 0; kz < nsys; kz++) {
     for (int i = 3; i <= n_mpi; i++) {
       const dcomplex alpha = -a(kz, i) / b(kz, i - 1);
@@ -1022,8 +1025,6 @@ void LaplacePCR_THOMAS ::pcr_double_row_substitution(Matrix<dcomplex>& a,
                                                      Matrix<dcomplex>& c,
                                                      Matrix<dcomplex>& r,
                                                      Matrix<dcomplex>& x) {
-  Array<dcomplex> alpha(nsys);
-  Array<dcomplex> gamma(nsys);
   Array<dcomplex> sbuf(4 * nsys);
   Array<dcomplex> rbuf(4 * nsys);
   auto recvvec = Array<dcomplex>(nsys);
@@ -1036,39 +1037,52 @@ void LaplacePCR_THOMAS ::pcr_double_row_substitution(Matrix<dcomplex>& a,
 
   /// Cyclic reduction until single row remains per MPI process.
   /// First row of next rank is sent to current rank at the row of n_mpi+1 for reduction.
-  if (xproc < nprocs - 1) {
-    MPI_Irecv(&rbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + 1, 0, comm, &request[0]);
-  }
-  if (xproc > 0) {
-    for (int kz = 0; kz < nsys; kz++) {
-      sbuf[0 + 4 * kz] = a(kz, 1);
-      sbuf[1 + 4 * kz] = b(kz, 1);
-      sbuf[2 + 4 * kz] = c(kz, 1);
-      sbuf[3 + 4 * kz] = r(kz, 1);
+  /// Only the master thread communicates
+  BOUT_OMP(parallel if (threaded_comms)) {
+    if (xproc > 0) {
+      BOUT_OMP(for)
+      for (int kz = 0; kz < nsys; kz++) {
+        sbuf[0 + 4 * kz] = a(kz, 1);
+        sbuf[1 + 4 * kz] = b(kz, 1);
+        sbuf[2 + 4 * kz] = c(kz, 1);
+        sbuf[3 + 4 * kz] = r(kz, 1);
+      }
     }
-    MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - 1, 0, comm, &request[1]);
-  }
-  if (xproc < nprocs - 1) {
-    MPI_Wait(&request[0], &status1);
-    for (int kz = 0; kz < nsys; kz++) {
-      a(kz, n_mpi + 1) = rbuf[0 + 4 * kz];
-      b(kz, n_mpi + 1) = rbuf[1 + 4 * kz];
-      c(kz, n_mpi + 1) = rbuf[2 + 4 * kz];
-      r(kz, n_mpi + 1) = rbuf[3 + 4 * kz];
+    BOUT_OMP(master) {
+      if (xproc < nprocs - 1) {
+        MPI_Irecv(&rbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank + 1, 0, comm,
+                  &request[0]);
+      }
+      if (xproc > 0) {
+        MPI_Isend(&sbuf[0], 4 * nsys, MPI_DOUBLE_COMPLEX, myrank - 1, 0, comm,
+                  &request[1]);
+      }
+      if (xproc < nprocs - 1) {
+        MPI_Wait(&request[0], &status1);
+      }
     }
-  }
+    BOUT_OMP(barrier)
 
-  /// Every first row are reduced to the last row (n_mpi) in each MPI rank.
-  const int ip = 1;
-  const int in = n_mpi + 1;
-  for (int kz = 0; kz < nsys; kz++) {
-    alpha[kz] = -a(kz, n_mpi) / b(kz, ip);
-    gamma[kz] = -c(kz, n_mpi) / b(kz, in);
+    /// Every first row are reduced to the last row (n_mpi) in each MPI rank.
+    const int ip = 1;
+    const int in = n_mpi + 1;
+    BOUT_OMP(for nowait)
+    for (int kz = 0; kz < nsys; kz++) {
+      if (xproc < nprocs - 1) {
+        a(kz, n_mpi + 1) = rbuf[0 + 4 * kz];
+        b(kz, n_mpi + 1) = rbuf[1 + 4 * kz];
+        c(kz, n_mpi + 1) = rbuf[2 + 4 * kz];
+        r(kz, n_mpi + 1) = rbuf[3 + 4 * kz];
+      }
+
+      const dcomplex alpha = -a(kz, n_mpi) / b(kz, ip);
+      const dcomplex gamma = -c(kz, n_mpi) / b(kz, in);
 
-    b(kz, n_mpi) += (alpha[kz] * c(kz, ip) + gamma[kz] * a(kz, in));
-    a(kz, n_mpi) = alpha[kz] * a(kz, ip);
-    c(kz, n_mpi) = gamma[kz] * c(kz, in);
-    r(kz, n_mpi) += (alpha[kz] * r(kz, ip) + gamma[kz] * r(kz, in));
+      b(kz, n_mpi) += (alpha * c(kz, ip) + gamma * a(kz, in));
+      a(kz, n_mpi) = alpha * a(kz, ip);
+      c(kz, n_mpi) = gamma * c(kz, in);
+      r(kz, n_mpi) += (alpha * r(kz, ip) + gamma * r(kz, in));
+    }
   }
 
   if (xproc > 0) {
@@ -1079,37 +1093,47 @@ void LaplacePCR_THOMAS ::pcr_double_row_substitution(Matrix<dcomplex>& a,
   pcr_forward_single_row(a, b, c, r, x);
 
   /// Solution of first row in each MPI rank.
-  if (xproc > 0) {
-    MPI_Irecv(&recvvec[0], nsys, MPI_DOUBLE_COMPLEX, myrank - 1, 100, comm, &request[0]);
-  }
-  if (xproc < nprocs - 1) {
-    for (int kz = 0; kz < nsys; kz++) {
-      sendvec[kz] = x(kz, n_mpi);
+  BOUT_OMP(parallel if (threaded_comms)) {
+    if (xproc < nprocs - 1) {
+      BOUT_OMP(for)
+      for (int kz = 0; kz < nsys; kz++) {
+        sendvec[kz] = x(kz, n_mpi);
+      }
     }
-    MPI_Isend(&sendvec[0], nsys, MPI_DOUBLE_COMPLEX, myrank + 1, 100, comm, &request[1]);
-  }
-  if (xproc > 0) {
-    MPI_Wait(&request[0], &status);
-    for (int kz = 0; kz < nsys; kz++) {
-      x(kz, 0) = recvvec[kz];
+    BOUT_OMP(master) {
+      if (xproc > 0) {
+        MPI_Irecv(&recvvec[0], nsys, MPI_DOUBLE_COMPLEX, myrank - 1, 100, comm,
+                  &request[0]);
+      }
+      if (xproc < nprocs - 1) {
+        MPI_Isend(&sendvec[0], nsys, MPI_DOUBLE_COMPLEX, myrank + 1, 100, comm,
+                  &request[1]);
+      }
+      if (xproc > 0) {
+        MPI_Wait(&request[0], &status);
+      }
     }
-  }
+    BOUT_OMP(barrier)
 
-  for (int kz = 0; kz < nsys; kz++) {
-    x(kz, 1) = r(kz, 1) - c(kz, 1) * x(kz, n_mpi) - a(kz, 1) * x(kz, 0);
-    x(kz, 1) = x(kz, 1) / b(kz, 1);
+    /// Solution of other rows in each MPI rank.
+    BOUT_OMP(for nowait)
+    for (int kz = 0; kz < nsys; kz++) {
+      if (xproc > 0) {
+        x(kz, 0) = recvvec[kz];
+      }
+      x(kz, 1) = r(kz, 1) - c(kz, 1) * x(kz, n_mpi) - a(kz, 1) * x(kz, 0);
+      x(kz, 1) = x(kz, 1) / b(kz, 1);
+
+      for (int i = 2; i < n_mpi; i++) {
+        x(kz, i) = r(kz, i) - c(kz, i) * x(kz, n_mpi) - a(kz, i) * x(kz, 1);
+        x(kz, i) = x(kz, i) / b(kz, i);
+      }
+    }
   }
 
   if (xproc < nprocs - 1) {
     MPI_Wait(&request[1], &status);
   }
-  /// Solution of other rows in each MPI rank.
-  for (int kz = 0; kz < nsys; kz++) {
-    for (int i = 2; i < n_mpi; i++) {
-      x(kz, i) = r(kz, i) - c(kz, i) * x(kz, n_mpi) - a(kz, i) * x(kz, 1);
-      x(kz, i) = x(kz, i) / b(kz, i);
-    }
-  }
 }
 
 /**
@@ -121,6 +121,10 @@ private:
   /// MPI process x ID
   int xproc;
 
+  /// Can the master thread make MPI calls inside OpenMP parallel
+  /// regions? If not, the stages which communicate use one thread
+  bool threaded_comms;
+
   /// Local private pointer for coefficient maxtix a
   Matrix<dcomplex> a, aa;
   /// Local private pointer for coefficient maxtix b
@@ -256,6 +256,27 @@ Field2D Laplacian::solve(const Field2D& b, const Field2D& x0) {
   return DC(f);
 }
 
+std::vector<Field3D> Laplacian::solve(const std::vector<Field3D>& b) {
+  std::vector<Field3D> x;
+  x.reserve(b.size());
+  for (const auto& f : b) {
+    x.push_back(solve(f));
+  }
+  return x;
+}
+
+std::vector<Field3D> Laplacian::solve(const std::vector<Field3D>& b,
+                                      const std::vector<Field3D>& x0) {
+  ASSERT1(b.size() == x0.size());
+
+  std::vector<Field3D> x;
+  x.reserve(b.size());
+  for (std::size_t i = 0; i < b.size(); ++i) {
+    x.push_back(solve(b[i], x0[i]));
+  }
+  return x;
+}
+
 /**********************************************************************************
  *                              MATRIX ELEMENTS
  **********************************************************************************/
@@ -495,14 +516,6 @@ void Laplacian::tridagMatrix(dcomplex* avec, dcomplex* bvec, dcomplex* cvec, dco
     if (localmesh->firstX()) {
       // INNER BOUNDARY ON THIS PROCESSOR
 
-      // If no user specified value is set on inner boundary, set the first
-      // element in b (in the equation AX=b) to 0
-      if (!(inner_boundary_flags & (INVERT_RHS | INVERT_SET))) {
-        for (int ix = 0; ix < inbndry; ix++) {
-          bk[ix] = 0.;
-        }
-      }
-
       // DC i.e. kz = 0 (the offset mode)
       if (kz == 0) {
 
@@ -653,14 +666,6 @@ void Laplacian::tridagMatrix(dcomplex* avec, dcomplex* bvec, dcomplex* cvec, dco
     if (localmesh->lastX()) {
       // OUTER BOUNDARY ON THIS PROCESSOR
 
-      // If no user specified value is set on outer boundary, set the last
-      // element in b (in the equation AX=b) to 0
-      if (!(outer_boundary_flags & (INVERT_RHS | INVERT_SET))) {
-        for (int ix = 0; ix < outbndry; ix++) {
-          bk[ncx - ix] = 0.;
-        }
-      }
-
       // DC i.e. kz = 0 (the offset mode)
       if (kz == 0) {
 
@@ -765,12 +770,58 @@ void Laplacian::tridagMatrix(dcomplex* avec, dcomplex* bvec, dcomplex* cvec, dco
     avec[0] = 0.0;
     bvec[0] = 1.0;
     cvec[0] = 0.0;
-    // RHS vector is also modified, setting this component to zero
-    bk[0] = 0.0;
   }
+
+  tridagRHS(bk, kz, global_flags, inner_boundary_flags, outer_boundary_flags,
+            includeguards, zperiodic);
 }
 #endif
 
+void Laplacian::tridagRHS(dcomplex* bk, int kz, int global_flags,
+                          int inner_boundary_flags, int outer_boundary_flags,
+                          bool includeguards, bool zperiodic) {
+  int xs = 0;
+  int xe = localmesh->LocalNx - 1;
+  if (!includeguards) {
+    if (!localmesh->firstX() || localmesh->periodicX) {
+      xs = localmesh->xstart;
+    }
+    if (!localmesh->lastX() || localmesh->periodicX) {
+      xe = localmesh->xend;
+    }
+  }
+  const int ncx = xe - xs;
+
+  int inbndry = localmesh->xstart, outbndry = localmesh->xstart;
+  if ((global_flags & INVERT_BOTH_BNDRY_ONE) || (localmesh->xstart < 2)) {
+    inbndry = outbndry = 1;
+  }
+  if (inner_boundary_flags & INVERT_BNDRY_ONE) {
+    inbndry = 1;
+  }
+  if (outer_boundary_flags & INVERT_BNDRY_ONE) {
+    outbndry = 1;
+  }
+
+  if (!localmesh->periodicX) {
+    // If no user specified value is set on a boundary, set the
+    // boundary elements in b (in the equation AX=b) to 0
+    if (localmesh->firstX() && !(inner_boundary_flags & (INVERT_RHS | INVERT_SET))) {
+      for (int ix = 0; ix < inbndry; ix++) {
+        bk[ix] = 0.;
+      }
+    }
+    if (localmesh->lastX() && !(outer_boundary_flags & (INVERT_RHS | INVERT_SET))) {
+      for (int ix = 0; ix < outbndry; ix++) {
+        bk[ncx - ix] = 0.;
+      }
+    }
+  } else if (zperiodic and (kz == 0) and localmesh->firstX()) {
+    // Doubly-periodic domains pin the kz=0 mode to zero at one location
+    bk[0] = 0.0;
+  }
+}
+
 void Laplacian::savePerformance(Solver& solver, const std::string& name) {
   // add values to be saved to the output
   if (not name.empty()) {
@@ -11,6 +11,7 @@
 #include <bout/utils.hxx>
 
 using bout::generator::Context;
+using bout::generator::Program;
 
 // #define BOUNDARY_CONDITIONS_UPGRADE_EXTRAPOLATE_FOR_2ND_ORDER
 
@@ -118,6 +119,86 @@ void verifyNumPoints(BoundaryRegion*, int) {}
 
 ///////////////////////////////////////////////////////////////
 
+void BoundaryGeneratorValues::update(const std::shared_ptr<FieldGenerator>& gen,
+                                     BoundaryRegion* bndry, CELL_LOC loc, BoutReal t,
+                                     int nz_in) {
+  ASSERT1(gen != nullptr);
+  Mesh* mesh = bndry->localmesh;
+
+  if (gen != generator) {
+    generator = gen;
+    program = std::make_unique<Program>(gen);
+    saved = {};
+    calculated = false;
+    contexts.clear();
+  }
+
+  if ((bndry != region) or (loc != location) or (nz_in != nz)) {
+    region = bndry;
+    location = loc;
+    nz = nz_in;
+    saved = {};
+    calculated = false;
+    contexts.clear();
+
+    x_index.clear();
+    y_index.clear();
+    x.clear();
+    y.clear();
+    z.clear();
+    for (bndry->first(); !bndry->isDone(); bndry->next1d()) {
+      x_index.push_back(bndry->x);
+      y_index.push_back(bndry->y);
+      for (int zk = 0; zk < nz; ++zk) {
+        const Context ctx(bndry, zk, loc, t, mesh);
+        x.push_back(ctx.x());
+        y.push_back(ctx.y());
+        z.push_back(ctx.z());
+      }
+    }
+    values.resize(x.size());
+  }
+
+  time = t;
+  bndry->first();
+
+  if (calculated and not program->dependsOnTime()) {
+    return;
+  }
+
+  if (program->usesContext() and contexts.empty()) {
+    for (bndry->first(); !bndry->isDone(); bndry->next1d()) {
+      for (int zk = 0; zk < nz; ++zk) {
+        contexts.emplace_back(bndry, zk, loc, t, mesh);
+      }
+    }
+    bndry->first();
+  }
+
+  program->evaluate(
+      static_cast<int>(values.size()), x.data(), y.data(), z.data(), t, values.data(),
+      [this, t](int i) { return Context(contexts[i]).set("t", t); }, &saved);
+  calculated = true;
+}
+
+BoutReal BoundaryGeneratorValues::operator()(int zk) const {
+  ASSERT2(calculated);
+  ASSERT2(zk >= 0 and zk < nz);
+
+  // Points are visited along y for x boundaries, and along x for y boundaries
+  if (not x_index.empty()) {
+    const int point =
+        (region->bx != 0) ? region->y - y_index.front() : region->x - x_index.front();
+    if ((point >= 0) and (point < static_cast<int>(x_index.size()))
+        and (x_index[point] == region->x) and (y_index[point] == region->y)) {
+      return values[point * nz + zk];
+    }
+  }
+  return generator->generate(Context(region, zk, location, time, region->localmesh));
+}
+
+///////////////////////////////////////////////////////////////
+
 BoundaryOp* BoundaryDirichlet::clone(BoundaryRegion* region,
                                      const std::list<std::string>& args) {
   verifyNumPoints(region, 1);
@@ -145,6 +226,9 @@ void BoundaryDirichlet::apply(Field2D& f, BoutReal t) {
   if (!fg) {
     fg = f.getBndryGenerator(bndry->location);
   }
+  if (fg) {
+    bndry_values.update(fg, bndry, f.getLocation(), t, 1);
+  }
 
   BoutReal val = 0.0;
 
@@ -162,7 +246,7 @@ void BoundaryDirichlet::apply(Field2D& f, BoutReal t) {
 
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y) = val;
@@ -181,7 +265,7 @@ void BoundaryDirichlet::apply(Field2D& f, BoutReal t) {
         // Inner x boundary. Set one point inwards
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x - bndry->bx, bndry->y) = val;
@@ -200,7 +284,7 @@ void BoundaryDirichlet::apply(Field2D& f, BoutReal t) {
         // y boundaries
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
           f(bndry->x, bndry->y) = 2 * val - f(bndry->x - bndry->bx, bndry->y - bndry->by);
 
@@ -221,7 +305,7 @@ void BoundaryDirichlet::apply(Field2D& f, BoutReal t) {
 
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y) = val;
@@ -239,7 +323,7 @@ void BoundaryDirichlet::apply(Field2D& f, BoutReal t) {
         // Lower y boundary. Set one point inwards
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y - bndry->by) = val;
@@ -258,7 +342,7 @@ void BoundaryDirichlet::apply(Field2D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
 
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
           f(bndry->x, bndry->y) = 2 * val - f(bndry->x - bndry->bx, bndry->y - bndry->by);
 
@@ -277,7 +361,7 @@ void BoundaryDirichlet::apply(Field2D& f, BoutReal t) {
     for (; !bndry->isDone(); bndry->next1d()) {
 
       if (fg) {
-        val = fg->generate(Context(bndry, loc, t, mesh));
+        val = bndry_values();
       }
 
       f(bndry->x, bndry->y) = 2 * val - f(bndry->x - bndry->bx, bndry->y - bndry->by);
@@ -308,6 +392,9 @@ void BoundaryDirichlet::apply(Field3D& f, BoutReal t) {
   if (!fg) {
     fg = f.getBndryGenerator(bndry->location);
   }
+  if (fg) {
+    bndry_values.update(fg, bndry, f.getLocation(), t, mesh->LocalNz);
+  }
 
   BoutReal val = 0.0;
 
@@ -326,7 +413,7 @@ void BoundaryDirichlet::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x, bndry->y, zk) = val;
 
@@ -347,7 +434,7 @@ void BoundaryDirichlet::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x - bndry->bx, bndry->y, zk) = val;
             f(bndry->x, bndry->y, zk) = f(bndry->x - bndry->bx, bndry->y, zk);
@@ -369,7 +456,7 @@ void BoundaryDirichlet::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x, bndry->y, zk) =
                 2 * val - f(bndry->x - bndry->bx, bndry->y - bndry->by, zk);
@@ -395,7 +482,7 @@ void BoundaryDirichlet::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x, bndry->y, zk) = val;
 
@@ -416,7 +503,7 @@ void BoundaryDirichlet::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x, bndry->y - bndry->by, zk) = val;
 
@@ -437,7 +524,7 @@ void BoundaryDirichlet::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
 
             f(bndry->x, bndry->y, zk) =
@@ -529,7 +616,7 @@ void BoundaryDirichlet::apply(Field3D& f, BoutReal t) {
     for (; !bndry->isDone(); bndry->next1d()) {
       for (int zk = 0; zk < mesh->LocalNz; zk++) {
         if (fg) {
-          val = fg->generate(Context(bndry, zk, loc, t, mesh));
+          val = bndry_values(zk);
         }
         f(bndry->x, bndry->y, zk) =
             2 * val - f(bndry->x - bndry->bx, bndry->y - bndry->by, zk);
@@ -573,7 +660,7 @@ void BoundaryDirichlet::apply(Field3D& f, BoutReal t) {
         int yi = bndry->y + i * bndry->by;
         for (int zk = 0; zk < mesh->LocalNz; zk++) {
           if (fg) {
-            val = fg->generate(Context(bndry, zk, loc, t, mesh));
+            val = bndry_values(zk);
           }
           f(xi, yi, zk) = val;
         }
@@ -630,6 +717,9 @@ void BoundaryDirichlet_O3::apply(Field2D& f, BoutReal t) {
   if (!fg) {
     fg = f.getBndryGenerator(bndry->location);
   }
+  if (fg) {
+    bndry_values.update(fg, bndry, f.getLocation(), t, 1);
+  }
 
   BoutReal val = 0.0;
 
@@ -646,7 +736,7 @@ void BoundaryDirichlet_O3::apply(Field2D& f, BoutReal t) {
         // Outer x boundary
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y) = val;
@@ -666,7 +756,7 @@ void BoundaryDirichlet_O3::apply(Field2D& f, BoutReal t) {
         // Inner x boundary. Set one point inwards
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
           f(bndry->x - bndry->bx, bndry->y) = val;
 
@@ -684,7 +774,7 @@ void BoundaryDirichlet_O3::apply(Field2D& f, BoutReal t) {
       if (bndry->by != 0) {
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y) =
@@ -710,7 +800,7 @@ void BoundaryDirichlet_O3::apply(Field2D& f, BoutReal t) {
 
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y) = val;
@@ -730,7 +820,7 @@ void BoundaryDirichlet_O3::apply(Field2D& f, BoutReal t) {
         // Lower y boundary. Set one point inwards
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y - bndry->by) = val;
@@ -750,7 +840,7 @@ void BoundaryDirichlet_O3::apply(Field2D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
 
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y) =
@@ -775,7 +865,7 @@ void BoundaryDirichlet_O3::apply(Field2D& f, BoutReal t) {
     for (; !bndry->isDone(); bndry->next1d()) {
 
       if (fg) {
-        val = fg->generate(Context(bndry, loc, t, mesh));
+        val = bndry_values();
       }
 
       f(bndry->x, bndry->y) =
@@ -810,6 +900,9 @@ void BoundaryDirichlet_O3::apply(Field3D& f, BoutReal t) {
   if (!fg) {
     fg = f.getBndryGenerator(bndry->location);
   }
+  if (fg) {
+    bndry_values.update(fg, bndry, f.getLocation(), t, mesh->LocalNz);
+  }
 
   BoutReal val = 0.0;
 
@@ -828,7 +921,7 @@ void BoundaryDirichlet_O3::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x, bndry->y, zk) = val;
 
@@ -849,7 +942,7 @@ void BoundaryDirichlet_O3::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x - bndry->bx, bndry->y, zk) = val;
 
@@ -871,7 +964,7 @@ void BoundaryDirichlet_O3::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
 
             f(bndry->x, bndry->y, zk) =
@@ -899,7 +992,7 @@ void BoundaryDirichlet_O3::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x, bndry->y, zk) = val;
 
@@ -920,7 +1013,7 @@ void BoundaryDirichlet_O3::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x, bndry->y - bndry->by, zk) = val;
 
@@ -941,7 +1034,7 @@ void BoundaryDirichlet_O3::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
 
             f(bndry->x, bndry->y, zk) =
@@ -1001,7 +1094,7 @@ void BoundaryDirichlet_O3::apply(Field3D& f, BoutReal t) {
     for (; !bndry->isDone(); bndry->next1d()) {
       for (int zk = 0; zk < mesh->LocalNz; zk++) {
         if (fg) {
-          val = fg->generate(Context(bndry, zk, loc, t, mesh));
+          val = bndry_values(zk);
         }
 
         f(bndry->x, bndry->y, zk) =
@@ -1072,6 +1165,9 @@ void BoundaryDirichlet_O4::apply(Field2D& f, BoutReal t) {
   if (!fg) {
     fg = f.getBndryGenerator(bndry->location);
   }
+  if (fg) {
+    bndry_values.update(fg, bndry, f.getLocation(), t, 1);
+  }
 
   BoutReal val = 0.0;
 
@@ -1089,7 +1185,7 @@ void BoundaryDirichlet_O4::apply(Field2D& f, BoutReal t) {
 
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
           f(bndry->x, bndry->y) = val;
 
@@ -1110,7 +1206,7 @@ void BoundaryDirichlet_O4::apply(Field2D& f, BoutReal t) {
         // Inner boundary. Set one point inwards
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x - bndry->bx, bndry->y) = val;
@@ -1132,7 +1228,7 @@ void BoundaryDirichlet_O4::apply(Field2D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
 
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y) =
@@ -1160,7 +1256,7 @@ void BoundaryDirichlet_O4::apply(Field2D& f, BoutReal t) {
 
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
           f(bndry->x, bndry->y) = val;
 
@@ -1180,7 +1276,7 @@ void BoundaryDirichlet_O4::apply(Field2D& f, BoutReal t) {
         // Inner y boundary. Set one point inwards
         for (; !bndry->isDone(); bndry->next1d()) {
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y - bndry->by) = val;
@@ -1203,7 +1299,7 @@ void BoundaryDirichlet_O4::apply(Field2D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
 
           if (fg) {
-            val = fg->generate(Context(bndry, loc, t, mesh));
+            val = bndry_values();
           }
 
           f(bndry->x, bndry->y) =
@@ -1230,7 +1326,7 @@ void BoundaryDirichlet_O4::apply(Field2D& f, BoutReal t) {
     for (; !bndry->isDone(); bndry->next1d()) {
 
       if (fg) {
-        val = fg->generate(Context(bndry, loc, t, mesh));
+        val = bndry_values();
       }
 
       f(bndry->x, bndry->y) =
@@ -1267,6 +1363,9 @@ void BoundaryDirichlet_O4::apply(Field3D& f, BoutReal t) {
   if (!fg) {
     fg = f.getBndryGenerator(bndry->location);
   }
+  if (fg) {
+    bndry_values.update(fg, bndry, f.getLocation(), t, mesh->LocalNz);
+  }
 
   BoutReal val = 0.0;
 
@@ -1285,7 +1384,7 @@ void BoundaryDirichlet_O4::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x, bndry->y, zk) = val;
 
@@ -1307,7 +1406,7 @@ void BoundaryDirichlet_O4::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x - bndry->bx, bndry->y, zk) = val;
 
@@ -1330,7 +1429,7 @@ void BoundaryDirichlet_O4::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
             f(bndry->x, bndry->y, zk) =
                 (16. / 5) * val - 3. * f(bndry->x - bndry->bx, bndry->y - bndry->by, zk)
@@ -1359,7 +1458,7 @@ void BoundaryDirichlet_O4::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
 
             f(bndry->x, bndry->y, zk) = val;
@@ -1382,7 +1481,7 @@ void BoundaryDirichlet_O4::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
 
             f(bndry->x, bndry->y - bndry->by, zk) = val;
@@ -1406,7 +1505,7 @@ void BoundaryDirichlet_O4::apply(Field3D& f, BoutReal t) {
         for (; !bndry->isDone(); bndry->next1d()) {
           for (int zk = 0; zk < mesh->LocalNz; zk++) {
             if (fg) {
-              val = fg->generate(Context(bndry, zk, loc, t, mesh));
+              val = bndry_values(zk);
             }
 
             f(bndry->x, bndry->y, zk) =
@@ -1469,7 +1568,7 @@ void BoundaryDirichlet_O4::apply(Field3D& f, BoutReal t) {
     for (; !bndry->isDone(); bndry->next1d()) {
       for (int zk = 0; zk < mesh->LocalNz; zk++) {
         if (fg) {
-          val = fg->generate(Context(bndry, zk, loc, t, mesh));
+          val = bndry_values(zk);
         }
 
         f(bndry->x, bndry->y, zk) =
@@ -1746,6 +1845,9 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
     if (!fg) {
       fg = f.getBndryGenerator(bndry->location);
     }
+    if (fg) {
+      bndry_values.update(fg, bndry, f.getLocation(), t, 1);
+    }
 
     BoutReal val = 0.0;
 
@@ -1766,7 +1868,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
           for (; !bndry->isDone(); bndry->next1d()) {
 
             if (fg) {
-              val = fg->generate(Context(bndry, loc, t, mesh))
+              val = bndry_values()
                     * metric->dx(bndry->x, bndry->y);
             }
 
@@ -1792,7 +1894,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
           for (; !bndry->isDone(); bndry->next1d()) {
 
             if (fg) {
-              val = fg->generate(Context(bndry, loc, t, mesh))
+              val = bndry_values()
                     * metric->dx(bndry->x, bndry->y);
             }
 
@@ -1823,7 +1925,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
                              + bndry->by * metric->dy(bndry->x, bndry->y);
 
             if (fg) {
-              val = fg->generate(Context(bndry, loc, t, mesh));
+              val = bndry_values();
             }
 
             f(bndry->x, bndry->y) =
@@ -1843,7 +1945,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
 
           for (; !bndry->isDone(); bndry->next1d()) {
             if (fg) {
-              val = fg->generate(Context(bndry, loc, t, mesh))
+              val = bndry_values()
                     * metric->dy(bndry->x, bndry->y);
             }
             f(bndry->x, bndry->y) = (4. * f(bndry->x, bndry->y - bndry->by)
@@ -1869,7 +1971,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
           for (; !bndry->isDone(); bndry->next1d()) {
 
             if (fg) {
-              val = fg->generate(Context(bndry, loc, t, mesh))
+              val = bndry_values()
                     * metric->dy(bndry->x, bndry->y - bndry->by);
             }
             f(bndry->x, bndry->y - bndry->by) =
@@ -1898,7 +2000,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
                              + bndry->by * metric->dy(bndry->x, bndry->y);
 
             if (fg) {
-              val = fg->generate(Context(bndry, loc, t, mesh));
+              val = bndry_values();
             }
 
             f(bndry->x, bndry->y) =
@@ -1919,7 +2021,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
                          + bndry->by * metric->dy(bndry->x, bndry->y);
 
         if (fg) {
-          val = fg->generate(Context(bndry, loc, t, mesh));
+          val = bndry_values();
         }
 
         f(bndry->x, bndry->y) =
@@ -1950,6 +2052,9 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
     if (!fg) {
       fg = f.getBndryGenerator(bndry->location);
     }
+    if (fg) {
+      bndry_values.update(fg, bndry, f.getLocation(), t, mesh->LocalNz);
+    }
 
     BoutReal val = 0.0;
 
@@ -1969,7 +2074,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
           for (; !bndry->isDone(); bndry->next1d()) {
             for (int zk = 0; zk < mesh->LocalNz; zk++) {
               if (fg) {
-                val = fg->generate(Context(bndry, zk, loc, t, mesh))
+                val = bndry_values(zk)
                       * metric->dx(bndry->x, bndry->y, zk);
               }
 
@@ -1998,7 +2103,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
           for (; !bndry->isDone(); bndry->next1d()) {
             for (int zk = 0; zk < mesh->LocalNz; zk++) {
               if (fg) {
-                val = fg->generate(Context(bndry, zk, loc, t, mesh))
+                val = bndry_values(zk)
                       * metric->dx(bndry->x - bndry->bx, bndry->y, zk);
               }
 
@@ -2034,7 +2139,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
                                + bndry->by * metric->dy(bndry->x, bndry->y, zk);
 #endif
               if (fg) {
-                val = fg->generate(Context(bndry, zk, loc, t, mesh));
+                val = bndry_values(zk);
               }
               f(bndry->x, bndry->y, zk) =
                   f(bndry->x - bndry->bx, bndry->y - bndry->by, zk) + delta * val;
@@ -2054,7 +2159,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
           for (; !bndry->isDone(); bndry->next1d()) {
             for (int zk = 0; zk < mesh->LocalNz; zk++) {
               if (fg) {
-                val = fg->generate(Context(bndry, zk, loc, t, mesh))
+                val = bndry_values(zk)
                       * metric->dy(bndry->x, bndry->y, zk);
               }
               f(bndry->x, bndry->y, zk) =
@@ -2082,7 +2187,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
           for (; !bndry->isDone(); bndry->next1d()) {
             for (int zk = 0; zk < mesh->LocalNz; zk++) {
               if (fg) {
-                val = fg->generate(Context(bndry, zk, loc, t, mesh))
+                val = bndry_values(zk)
                       * metric->dy(bndry->x, bndry->y - bndry->by, zk);
               }
 
@@ -2120,7 +2225,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
                                + bndry->by * metric->dy(bndry->x, bndry->y, zk);
 #endif
               if (fg) {
-                val = fg->generate(Context(bndry, zk, loc, t, mesh));
+                val = bndry_values(zk);
               }
               f(bndry->x, bndry->y, zk) =
                   f(bndry->x - bndry->bx, bndry->y - bndry->by, zk) + delta * val;
@@ -2176,7 +2281,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
       for (int zk = 0; zk < mesh->LocalNz; zk++) {
 #endif
           if (fg) {
-            val = fg->generate(Context(bndry, zk, loc, t, mesh));
+            val = bndry_values(zk);
           }
           f(bndry->x, bndry->y, zk) =
               f(bndry->x - bndry->bx, bndry->y - bndry->by, zk) + delta * val;
@@ -2237,6 +2342,9 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
     if (!fg) {
       fg = f.getBndryGenerator(bndry->location);
     }
+    if (fg) {
+      bndry_values.update(fg, bndry, f.getLocation(), t, 1);
+    }
 
     BoutReal val = 0.0;
 
@@ -2254,7 +2362,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
                          + bndry->by * coords->dy(bndry->x, bndry->y);
 
         if (fg) {
-          val = fg->generate(Context(bndry, loc, t, mesh));
+          val = bndry_values();
         }
 
         f(bndry->x, bndry->y) =
@@ -2289,6 +2397,9 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
     if (!fg) {
       fg = f.getBndryGenerator(bndry->location);
     }
+    if (fg) {
+      bndry_values.update(fg, bndry, f.getLocation(), t, mesh->LocalNz);
+    }
 
     BoutReal val = 0.0;
 
@@ -2303,7 +2414,7 @@ void BoundaryNeumann_NonOrthogonal::apply(Field3D& f) {
           BoutReal delta = bndry->bx * coords->dx(bndry->x, bndry->y, zk)
                            + bndry->by * coords->dy(bndry->x, bndry->y, zk);
           if (fg) {
-            val = fg->generate(Context(bndry, zk, loc, t, mesh));
+            val = bndry_values(zk);
           }
 
           f(bndry->x, bndry->y, zk) =
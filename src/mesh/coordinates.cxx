@@ -1205,6 +1205,8 @@ int Coordinates::geometry(bool recalculate_staggered,
   zlength_cache.reset();
   Grad2_par2_DDY_invSgCache.clear();
   invSgCache.reset();
+  delp2_coefs_cache.reset();
+  ++geometry_generation;
 
   return 0;
 }
@@ -1672,43 +1674,30 @@ Field3D Coordinates::Delp2(const Field3D& f, CELL_LOC outloc, bool useFFT) {
   Field3D result{emptyFrom(f).setLocation(outloc)};
 
   if (useFFT and not bout::build::use_metric_3d) {
-    int ncz = localmesh->LocalNz;
+    const auto& coefs = delp2Coefficients();
+    const int nkz = (localmesh->LocalNz / 2) + 1;
 
-    // Allocate memory
-    auto ft = Matrix<dcomplex>(localmesh->LocalNx, ncz / 2 + 1);
-    auto delft = Matrix<dcomplex>(localmesh->LocalNx, ncz / 2 + 1);
-
-    // Loop over y indices
+    // Take forward FFT of every column needed at once
     // Note: should not include y-guard or y-boundary points here as that would
     // use values from corner cells in dx, which may not be initialised.
-    for (int jy = localmesh->ystart; jy <= localmesh->yend; jy++) {
-
-      // Take forward FFT
-
-      for (int jx = 0; jx < localmesh->LocalNx; jx++) {
-        rfft(&f(jx, jy, 0), ncz, &ft(jx, 0));
-      }
-
-      // Loop over kz
-      for (int jz = 0; jz <= ncz / 2; jz++) {
-
-        // No smoothing in the x direction
-        for (int jx = localmesh->xstart; jx <= localmesh->xend; jx++) {
-          // Perform x derivative
-
-          dcomplex a, b, c;
-          laplace_tridag_coefs(jx, jy, jz, a, b, c, nullptr, nullptr, outloc);
-
-          delft(jx, jz) = a * ft(jx - 1, jz) + b * ft(jx, jz) + c * ft(jx + 1, jz);
-        }
-      }
-
-      // Reverse FFT
-      for (int jx = localmesh->xstart; jx <= localmesh->xend; jx++) {
-
-        irfft(&delft(jx, 0), ncz, &result(jx, jy, 0));
+    const auto ft = bout::fft::rfft(f, coefs.fft_region);
+
+    // The fft_region has an extra x row on each side of the
+    // result_region, so row i of the result is at row i + ny of ft
+    const int ny = coefs.ny;
+    const int npoints = static_cast<int>(coefs.result_region.size());
+    auto delft = Matrix<dcomplex>(npoints, nkz);
+
+    BOUT_OMP(parallel for)
+    for (int i = 0; i < npoints; i++) {
+      for (int jz = 0; jz < nkz; jz++) {
+        delft(i, jz) = coefs.a(i, jz) * ft(i, jz) + coefs.b(i, jz) * ft(i + ny, jz)
+                       + coefs.c(i, jz) * ft(i + 2 * ny, jz);
       }
     }
+
+    // Reverse FFT
+    bout::fft::irfft(delft, coefs.result_region, result);
   } else {
     result = G1 * ::DDX(f, outloc) + G3 * ::DDZ(f, outloc) + g11 * ::D2DX2(f, outloc)
              + g33 * ::D2DZ2(f, outloc) + 2 * g13 * ::D2DXDZ(f, outloc);
@@ -1719,6 +1708,43 @@ Field3D Coordinates::Delp2(const Field3D& f, CELL_LOC outloc, bool useFFT) {
   return result;
 }
 
+const Coordinates::Delp2Coefficients& Coordinates::delp2Coefficients() const {
+  if (delp2_coefs_cache != nullptr) {
+    return *delp2_coefs_cache;
+  }
+
+  const int xstart = localmesh->xstart;
+  const int xend = localmesh->xend;
+  const int ystart = localmesh->ystart;
+  const int yend = localmesh->yend;
+  const int nkz = (localmesh->LocalNz / 2) + 1;
+
+  auto coefs = std::make_unique<Delp2Coefficients>();
+  coefs->fft_region =
+      Region<Ind2D>(xstart - 1, xend + 1, ystart, yend, 0, 0, localmesh->LocalNy, 1);
+  coefs->result_region =
+      Region<Ind2D>(xstart, xend, ystart, yend, 0, 0, localmesh->LocalNy, 1);
+  coefs->ny = yend - ystart + 1;
+
+  const int npoints = static_cast<int>(coefs->result_region.size());
+  coefs->a = Matrix<dcomplex>(npoints, nkz);
+  coefs->b = Matrix<dcomplex>(npoints, nkz);
+  coefs->c = Matrix<dcomplex>(npoints, nkz);
+
+  const auto& indices = coefs->result_region.getIndices();
+  for (int i = 0; i < npoints; i++) {
+    const int jx = indices[i].x();
+    const int jy = indices[i].y();
+    for (int jz = 0; jz < nkz; jz++) {
+      laplace_tridag_coefs(jx, jy, jz, coefs->a(i, jz), coefs->b(i, jz), coefs->c(i, jz),
+                           nullptr, nullptr, location);
+    }
+  }
+
+  delp2_coefs_cache = std::move(coefs);
+  return *delp2_coefs_cache;
+}
+
 FieldPerp Coordinates::Delp2(const FieldPerp& f, CELL_LOC outloc, bool useFFT) {
   TRACE("Coordinates::Delp2( FieldPerp )");
 
@@ -1748,9 +1774,7 @@ FieldPerp Coordinates::Delp2(const FieldPerp& f, CELL_LOC outloc, bool useFFT) {
     auto delft = Matrix<dcomplex>(localmesh->LocalNx, ncz / 2 + 1);
 
     // Take forward FFT
-    for (int jx = 0; jx < localmesh->LocalNx; jx++) {
-      rfft(&f(jx, 0), ncz, &ft(jx, 0));
-    }
+    bout::fft::rfft(&f(0, 0), ncz, &ft(0, 0), localmesh->LocalNx, ncz, ncz / 2 + 1);
 
     // Loop over kz
     for (int jz = 0; jz <= ncz / 2; jz++) {
@@ -1767,9 +1791,8 @@ FieldPerp Coordinates::Delp2(const FieldPerp& f, CELL_LOC outloc, bool useFFT) {
     }
 
     // Reverse FFT
-    for (int jx = localmesh->xstart; jx <= localmesh->xend; jx++) {
-      irfft(&delft(jx, 0), ncz, &result(jx, 0));
-    }
+    bout::fft::irfft(&delft(localmesh->xstart, 0), ncz, &result(localmesh->xstart, 0),
+                     localmesh->xend - localmesh->xstart + 1, ncz / 2 + 1, ncz);
 
   } else {
     throw BoutException("Non-fourier Delp2 not currently implented for FieldPerp.");
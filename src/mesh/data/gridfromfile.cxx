@@ -13,8 +13,10 @@
 #include <bout/utils.hxx>
 #include <utility>
 
-GridFile::GridFile(std::string gridfilename)
-    : GridDataSource(true), data(bout::OptionsNetCDF(gridfilename).read()),
+GridFile::GridFile(std::string gridfilename, bool parallel)
+    : GridDataSource(true),
+      file(gridfilename, bout::OptionsNetCDF::FileMode::replace, parallel),
+      data(file.readMetadata()), shapes(file.variableShapes()),
       filename(std::move(gridfilename)) {
   TRACE("GridFile constructor");
 
@@ -30,7 +32,17 @@ GridFile::GridFile(std::string gridfilename)
  * Tests whether a variable exists in the file
  *
  */
-bool GridFile::hasVar(const std::string& name) { return data.isSet(name); }
+bool GridFile::hasVar(const std::string& name) {
+  return data.isSet(name) or shapes.count(name) > 0;
+}
+
+std::vector<int> GridFile::getShape(const std::string& name) const {
+  const auto shape = shapes.find(name);
+  if (shape == shapes.end() or shape->second.empty()) {
+    return {1};
+  }
+  return shape->second;
+}
 
 /*!
  * Read a string from file. If the string is not
@@ -131,28 +143,6 @@ bool GridFile::get(Mesh* m, Field3D& var, const std::string& name, BoutReal def,
   return getField(m, var, name, def, location);
 }
 
-namespace {
-/// Visitor that returns the shape of its argument
-struct GetDimensions {
-  std::vector<int> operator()(MAYBE_UNUSED(bool value)) { return {1}; }
-  std::vector<int> operator()(MAYBE_UNUSED(int value)) { return {1}; }
-  std::vector<int> operator()(MAYBE_UNUSED(BoutReal value)) { return {1}; }
-  std::vector<int> operator()(MAYBE_UNUSED(const std::string& value)) { return {1}; }
-  std::vector<int> operator()(const Array<BoutReal>& array) { return {array.size()}; }
-  std::vector<int> operator()(const Matrix<BoutReal>& array) {
-    const auto shape = array.shape();
-    return {std::get<0>(shape), std::get<1>(shape)};
-  }
-  std::vector<int> operator()(const Tensor<BoutReal>& array) {
-    const auto shape = array.shape();
-    return {std::get<0>(shape), std::get<1>(shape), std::get<2>(shape)};
-  }
-  std::vector<int> operator()(const Field& array) {
-    return {array.getNx(), array.getNy(), array.getNz()};
-  }
-};
-} // namespace
-
 template <typename T>
 bool GridFile::getField(Mesh* m, T& var, const std::string& name, BoutReal def,
                         CELL_LOC location) {
@@ -163,7 +153,7 @@ bool GridFile::getField(Mesh* m, T& var, const std::string& name, BoutReal def,
   Timer timer("io");
   AUTO_TRACE();
 
-  if (not data.isSet(name)) {
+  if (shapes.count(name) == 0) {
     // Variable not found
     output_warn.write("\tWARNING: Could not read '{:s}' from grid. Setting to {:e}\n",
                       name, def);
@@ -172,10 +162,8 @@ bool GridFile::getField(Mesh* m, T& var, const std::string& name, BoutReal def,
     return false;
   }
 
-  Options option = data[name];
-
   // Global (x, y, z) dimensions of field
-  const std::vector<int> size = bout::utils::visit(GetDimensions{}, option.value);
+  const std::vector<int> size = getShape(name);
 
   switch (size.size()) {
   case 1: {
@@ -185,7 +173,7 @@ bool GridFile::getField(Mesh* m, T& var, const std::string& name, BoutReal def,
           "Expecting a 2D variable, but '{:s}' is 1D with {:d} elements\n", name,
           size[0]);
     }
-    var = option.as<BoutReal>();
+    var = data[name].as<BoutReal>();
     var.setLocation(location);
     return true;
   }
@@ -375,11 +363,13 @@ void GridFile::readField(Mesh* UNUSED(m), const std::string& name, int ys, int y
 
   var.allocate();
 
-  const auto full_var = data[name].as<Matrix<BoutReal>>();
+  // Only read the part of the variable on this processor
+  const auto local_var =
+      file.readSlab(name, {xs, ys}, {nx_to_read, ny_to_read}).as<Matrix<BoutReal>>();
 
-  for (int x = xs; x < xs + nx_to_read; ++x) {
-    for (int y = ys; y < ys + ny_to_read; ++y) {
-      var(x - xs + xd, y - ys + yd) = full_var(x, y);
+  for (int x = 0; x < nx_to_read; ++x) {
+    for (int y = 0; y < ny_to_read; ++y) {
+      var(x + xd, y + yd) = local_var(x, y);
     }
   }
 }
@@ -499,8 +489,7 @@ bool GridFile::get(Mesh* UNUSED(m), std::vector<BoutReal>& var, const std::strin
 bool GridFile::hasXBoundaryGuards(Mesh* m) {
   // Global (x,y) dimensions of some field
   // a grid file should always contain "dx"
-  Options option = data["dx"];
-  const std::vector<int> size = bout::utils::visit(GetDimensions{}, option.value);
+  const std::vector<int> size = getShape("dx");
 
   if (size.empty()) {
     // handle case where "dx" is not present - non-standard grid file
@@ -535,8 +524,7 @@ bool GridFile::readgrid_3dvar_fft(Mesh* m, const std::string& name, int yread, i
   }
 
   /// Check the size of the data
-  Options option = data[name];
-  const std::vector<int> size = bout::utils::visit(GetDimensions{}, option.value);
+  const std::vector<int> size = getShape(name);
 
   if (size.size() != 3) {
     output_warn.write("\tWARNING: Number of dimensions of {:s} incorrect\n", name);
@@ -579,14 +567,16 @@ bool GridFile::readgrid_3dvar_fft(Mesh* m, const std::string& name, int yread, i
   Array<dcomplex> fdata(ncz / 2 + 1);
   Array<BoutReal> zdata(size[2]);
 
-  const auto full_var = data[name].as<Tensor<BoutReal>>();
+  const auto local_var =
+      file.readSlab(name, {xread, yread, 0}, {xsize, ysize, size[2]})
+          .as<Tensor<BoutReal>>();
 
   for (int jx = xread; jx < xread + xsize; jx++) {
     // jx is global x-index to start from
     for (int jy = yread; jy < yread + ysize; jy++) {
       // jy is global y-index to start from
       for (int jz = 0; jz < size[2]; ++jz) {
-        zdata[jz] = full_var(jx, jy, jz);
+        zdata[jz] = local_var(jx - xread, jy - yread, jz);
       }
 
       /// Load into dcomplex array
@@ -622,24 +612,22 @@ bool GridFile::readgrid_3dvar_real(const std::string& name, int yread, int ydest
     return false;
   }
 
-  Options option = data[name];
-
   /// Check the size of the data
-  const std::vector<int> size = bout::utils::visit(GetDimensions{}, option.value);
+  const std::vector<int> size = getShape(name);
 
   if (size.size() != 3) {
     output_warn.write("\tWARNING: Number of dimensions of {:s} incorrect\n", name);
     return false;
   }
 
-  const auto full_var = option.as<Tensor<BoutReal>>();
+  const auto local_var =
+      file.readSlab(name, {xread, yread, 0}, {xsize, ysize, size[2]})
+          .as<Tensor<BoutReal>>();
 
-  for (int jx = xread; jx < xread + xsize; jx++) {
-    // jx is global x-index to start from
-    for (int jy = yread; jy < yread + ysize; jy++) {
-      // jy is global y-index to start from
+  for (int jx = 0; jx < xsize; jx++) {
+    for (int jy = 0; jy < ysize; jy++) {
       for (int jz = 0; jz < size[2]; ++jz) {
-        var(jx - xread + xdest, jy - yread + ydest, jz) = full_var(jx, jy, jz);
+        var(jx + xdest, jy + ydest, jz) = local_var(jx, jy, jz);
       }
     }
   }
@@ -665,8 +653,7 @@ bool GridFile::readgrid_perpvar_fft(Mesh* m, const std::string& name, int xread,
   }
 
   /// Check the size of the data
-  Options option = data[name];
-  const std::vector<int> size = bout::utils::visit(GetDimensions{}, option.value);
+  const std::vector<int> size = getShape(name);
 
   if (size.size() != 2) {
     output_warn.write("\tWARNING: Number of dimensions of {:s} incorrect\n", name);
@@ -709,12 +696,13 @@ bool GridFile::readgrid_perpvar_fft(Mesh* m, const std::string& name, int xread,
   Array<dcomplex> fdata(ncz / 2 + 1);
   Array<BoutReal> zdata(size[1]);
 
-  const auto full_var = option.as<Matrix<BoutReal>>();
+  const auto local_var =
+      file.readSlab(name, {xread, 0}, {xsize, size[1]}).as<Matrix<BoutReal>>();
 
   for (int jx = xread; jx < xread + xsize; jx++) {
     // jx is global x-index to start from
     for (int jz = 0; jz < size[1]; ++jz) {
-      zdata[jz] = full_var(jx, jz);
+      zdata[jz] = local_var(jx - xread, jz);
     }
 
     /// Load into dcomplex array
@@ -748,20 +736,19 @@ bool GridFile::readgrid_perpvar_real(const std::string& name, int xread, int xde
   }
 
   /// Check the size of the data
-  Options option = data[name];
-  const std::vector<int> size = bout::utils::visit(GetDimensions{}, option.value);
+  const std::vector<int> size = getShape(name);
 
   if (size.size() != 2) {
     output_warn.write("\tWARNING: Number of dimensions of {:s} incorrect\n", name);
     return false;
   }
 
-  const auto full_var = option.as<Matrix<BoutReal>>();
+  const auto local_var =
+      file.readSlab(name, {xread, 0}, {xsize, size[1]}).as<Matrix<BoutReal>>();
 
-  for (int jx = xread; jx < xread + xsize; jx++) {
-    // jx is global x-index to start from
+  for (int jx = 0; jx < xsize; jx++) {
     for (int jz = 0; jz < size[1]; ++jz) {
-      var(jx - xread + xdest, jz) = full_var(jx, jz);
+      var(jx + xdest, jz) = local_var(jx, jz);
     }
   }
 
@@ -611,6 +611,44 @@ Field3D b0xGrad_dot_Grad(const Field3D& phi, const Field3D& A, CELL_LOC outloc)
  * Terms of form b0 x Grad(f) dot Grad(g) / B = [f, g]
  *******************************************************************************/
 
+namespace {
+/// Arakawa bracket for one row in z at a given (x, y). \p point(jz,
+/// jzm, jzp) gives the bracket at jz without the 1 / (12 dx dz)
+/// factor, which is given by \p spacing(jz).
+///
+/// The first and last points wrap around in z, so are done
+/// separately. The loop over the rest then uses contiguous values
+/// with no index wrapping, so can be vectorised. With 2D metrics the
+/// spacing is the same for the whole row.
+template <typename Point, typename Spacing>
+void arakawaRow(int ncz, const Point& point, const Spacing& spacing, BoutReal* result) {
+  result[0] = point(0, ncz - 1, 1) * spacing(0);
+
+  BOUT_OMP(simd)
+  for (int jz = 1; jz < ncz - 1; jz++) {
+    result[jz] = point(jz, jz - 1, jz + 1) * spacing(jz);
+  }
+
+  result[ncz - 1] = point(ncz - 1, ncz - 2, 0) * spacing(ncz - 1);
+}
+
+/// The 1 / (12 dx dz) factor in the Arakawa bracket, as a function of
+/// z at (\p jx, \p jy). With 3D metrics this reads dx and dz at each
+/// point rather than making temporary fields
+#if BOUT_USE_METRIC_3D
+auto arakawaSpacing(Coordinates* metric, int jx, int jy) {
+  const BoutReal* dx = metric->dx(jx, jy);
+  const BoutReal* dz = metric->dz(jx, jy);
+  return [=](int jz) { return 1.0 / (12 * dz[jz] * dx[jz]); };
+}
+#else
+auto arakawaSpacing(Coordinates* metric, int jx, int jy) {
+  const BoutReal spacingFactor = 1.0 / (12 * metric->dz(jx, jy) * metric->dx(jx, jy));
+  return [=](int) { return spacingFactor; };
+}
+#endif
+} // namespace
+
 Coordinates::FieldMetric bracket(const Field2D& f, const Field2D& g,
                                  BRACKET_METHOD method, CELL_LOC outloc,
                                  Solver* UNUSED(solver)) {
@@ -660,7 +698,6 @@ Field3D bracket(const Field3D& f, const Field2D& g, BRACKET_METHOD method,
       throw BoutException("CTU method requires access to the solver");
     }
 
-#if not(BOUT_USE_METRIC_3D)
     const int ncz = mesh->LocalNz;
 
     for (int x = mesh->xstart; x <= mesh->xend; x++) {
@@ -693,20 +730,14 @@ Field3D bracket(const Field3D& f, const Field2D& g, BRACKET_METHOD method,
         }
       }
     }
-#else
-    throw BoutException("BRACKET_CTU not valid with 3D metrics yet.");
-#endif
     break;
   }
   case BRACKET_ARAKAWA: {
     // Arakawa scheme for perpendicular flow. Here as a test
-
-#if not(BOUT_USE_METRIC_3D)
     const int ncz = mesh->LocalNz;
 
     BOUT_FOR(j2D, result.getRegion2D("RGN_NOBNDRY")) {
       // Get constants for this iteration
-      const BoutReal spacingFactor = 1.0 / (12 * metric->dz[j2D] * metric->dx[j2D]);
       const int jy = j2D.y(), jx = j2D.x();
       const int xm = jx - 1, xp = jx + 1;
 
@@ -716,59 +747,19 @@ Field3D bracket(const Field3D& f, const Field2D& g, BRACKET_METHOD method,
       // Index Field3D as 2D to get start of z data block
       const auto fxm = f(xm, jy), fc = f(jx, jy), fxp = f(xp, jy);
 
-      // Here we split the loop over z into three parts; the first value, the middle block
-      // and the last value
-      // this is to allow the loop used in the middle block to vectorise.
-
-      // The first value
-      {
-        const int jzp = 1;
-        const int jzm = ncz - 1;
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = 2 * (fc[jzp] - fc[jzm]) * (gxp - gxm);
-
-        // J+x
-        const BoutReal Jpx = gxp * (fxp[jzp] - fxp[jzm]) - gxm * (fxm[jzp] - fxm[jzm])
-                             + gc * (fxp[jzm] - fxp[jzp] - fxm[jzm] + fxm[jzp]);
-
-        result(jx, jy, 0) = (Jpp + Jpx) * spacingFactor;
-      }
-
-      // The middle block
-      for (int jz = 1; jz < mesh->LocalNz - 1; jz++) {
-        const int jzp = jz + 1;
-        const int jzm = jz - 1;
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = 2 * (fc[jzp] - fc[jzm]) * (gxp - gxm);
-
-        // J+x
-        const BoutReal Jpx = gxp * (fxp[jzp] - fxp[jzm]) - gxm * (fxm[jzp] - fxm[jzm])
-                             + gc * (fxp[jzm] - fxp[jzp] - fxm[jzm] + fxm[jzp]);
-
-        result(jx, jy, jz) = (Jpp + Jpx) * spacingFactor;
-      }
-
-      // The last value
-      {
-        const int jzp = 0;
-        const int jzm = ncz - 2;
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = 2 * (fc[jzp] - fc[jzm]) * (gxp - gxm);
-
-        // J+x
-        const BoutReal Jpx = gxp * (fxp[jzp] - fxp[jzm]) - gxm * (fxm[jzp] - fxm[jzm])
-                             + gc * (fxp[jzm] - fxp[jzp] - fxm[jzm] + fxm[jzp]);
-
-        result(jx, jy, ncz - 1) = (Jpp + Jpx) * spacingFactor;
-      }
+      arakawaRow(
+          ncz,
+          [=](int /*jz*/, int jzm, int jzp) {
+            // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
+            const BoutReal Jpp = 2 * (fc[jzp] - fc[jzm]) * (gxp - gxm);
+
+            // J+x
+            const BoutReal Jpx = gxp * (fxp[jzp] - fxp[jzm]) - gxm * (fxm[jzp] - fxm[jzm])
+                                 + gc * (fxp[jzm] - fxp[jzp] - fxm[jzm] + fxm[jzp]);
+            return Jpp + Jpx;
+          },
+          arakawaSpacing(metric, jx, jy), result(jx, jy));
     }
-#else
-    throw BoutException("BRACKET_ARAKAWA not valid with 3D metrics yet.");
-#endif
-
     break;
   }
   case BRACKET_ARAKAWA_OLD: {
@@ -887,7 +878,6 @@ Field3D bracket(const Field3D& f, const Field3D& g, BRACKET_METHOD method,
   case BRACKET_CTU: {
     // First order Corner Transport Upwind method
     // P.Collela JCP 87, 171-200 (1990)
-#if not(BOUT_USE_METRIC_3D)
     if (!solver) {
       throw BoutException("CTU method requires access to the solver");
     }
@@ -912,12 +902,12 @@ Field3D bracket(const Field3D& f, const Field3D& g, BRACKET_METHOD method,
           vx(x, z) = (f(x, y, zp) - f(x, y, zm)) / (2. * metric->dz(x, y, z));
           // Vz = -DDX(f)
           vz(x, z) = (f(x - 1, y, z) - f(x + 1, y, z))
-                     / (0.5 * metric->dx(x - 1, y) + metric->dx(x, y)
-                        + 0.5 * metric->dx(x + 1, y));
+                     / (0.5 * metric->dx(x - 1, y, z) + metric->dx(x, y, z)
+                        + 0.5 * metric->dx(x + 1, y, z));
 
           // Set stability condition
-          solver->setMaxTimestep(fabs(metric->dx(x, y)) / (fabs(vx(x, z)) + 1e-16));
-          solver->setMaxTimestep(metric->dz(x, y) / (fabs(vz(x, z)) + 1e-16));
+          solver->setMaxTimestep(fabs(metric->dx(x, y, z)) / (fabs(vx(x, z)) + 1e-16));
+          solver->setMaxTimestep(metric->dz(x, y, z) / (fabs(vz(x, z)) + 1e-16));
         }
       }
 
@@ -933,59 +923,56 @@ Field3D bracket(const Field3D& f, const Field3D& g, BRACKET_METHOD method,
           // X differencing
           if (vx(x, z) > 0.0) {
             gp = g(x, y, z)
-                 + (0.5 * dt / metric->dz(x, y))
+                 + (0.5 * dt / metric->dz(x, y, z))
                        * ((vz(x, z) > 0) ? vz(x, z) * (g(x, y, zm) - g(x, y, z))
                                          : vz(x, z) * (g(x, y, z) - g(x, y, zp)));
 
             gm = g(x - 1, y, z)
-                 + (0.5 * dt / metric->dz(x, y))
+                 + (0.5 * dt / metric->dz(x, y, z))
                        * ((vz(x, z) > 0) ? vz(x, z) * (g(x - 1, y, zm) - g(x - 1, y, z))
                                          : vz(x, z) * (g(x - 1, y, z) - g(x - 1, y, zp)));
 
           } else {
             gp = g(x + 1, y, z)
-                 + (0.5 * dt / metric->dz(x, y))
+                 + (0.5 * dt / metric->dz(x, y, z))
                        * ((vz(x, z) > 0) ? vz(x, z) * (g(x + 1, y, zm) - g(x + 1, y, z))
                                          : vz[x][z] * (g(x + 1, y, z) - g(x + 1, y, zp)));
 
             gm = g(x, y, z)
-                 + (0.5 * dt / metric->dz(x, y))
+                 + (0.5 * dt / metric->dz(x, y, z))
                        * ((vz(x, z) > 0) ? vz(x, z) * (g(x, y, zm) - g(x, y, z))
                                          : vz(x, z) * (g(x, y, z) - g(x, y, zp)));
           }
 
-          result(x, y, z) = vx(x, z) * (gp - gm) / metric->dx(x, y);
+          result(x, y, z) = vx(x, z) * (gp - gm) / metric->dx(x, y, z);
 
           // Z differencing
           if (vz(x, z) > 0.0) {
             gp = g(x, y, z)
-                 + (0.5 * dt / metric->dx(x, y))
+                 + (0.5 * dt / metric->dx(x, y, z))
                        * ((vx[x][z] > 0) ? vx[x][z] * (g(x - 1, y, z) - g(x, y, z))
                                          : vx[x][z] * (g(x, y, z) - g(x + 1, y, z)));
 
             gm = g(x, y, zm)
-                 + (0.5 * dt / metric->dx(x, y))
+                 + (0.5 * dt / metric->dx(x, y, z))
                        * ((vx(x, z) > 0) ? vx(x, z) * (g(x - 1, y, zm) - g(x, y, zm))
                                          : vx(x, z) * (g(x, y, zm) - g(x + 1, y, zm)));
           } else {
             gp = g(x, y, zp)
-                 + (0.5 * dt / metric->dx(x, y))
+                 + (0.5 * dt / metric->dx(x, y, z))
                        * ((vx(x, z) > 0) ? vx(x, z) * (g(x - 1, y, zp) - g(x, y, zp))
                                          : vx(x, z) * (g(x, y, zp) - g(x + 1, y, zp)));
 
             gm = g(x, y, z)
-                 + (0.5 * dt / metric->dx(x, y))
+                 + (0.5 * dt / metric->dx(x, y, z))
                        * ((vx(x, z) > 0) ? vx(x, z) * (g(x - 1, y, z) - g(x, y, z))
                                          : vx(x, z) * (g(x, y, z) - g(x + 1, y, z)));
           }
 
-          result(x, y, z) += vz(x, z) * (gp - gm) / metric->dz(x, y);
+          result(x, y, z) += vz(x, z) * (gp - gm) / metric->dz(x, y, z);
         }
       }
     }
-#else
-    throw BoutException("BRACKET_CTU not valid with 3D metrics yet.");
-#endif
     break;
   }
   case BRACKET_ARAKAWA: {
@@ -998,95 +985,36 @@ Field3D bracket(const Field3D& f, const Field3D& g, BRACKET_METHOD method,
     Field3D g_temp = g;
 
     BOUT_FOR(j2D, result.getRegion2D("RGN_NOBNDRY")) {
-#if not(BOUT_USE_METRIC_3D)
-      const BoutReal spacingFactor = 1.0 / (12 * metric->dz[j2D] * metric->dx[j2D]);
-#endif
       const int jy = j2D.y(), jx = j2D.x();
       const int xm = jx - 1, xp = jx + 1;
 
-      const auto Fxm = f_temp(xm, jy), Fx = f_temp(jx, jy), Fxp = f_temp(xp, jy);
-      const auto Gxm = g_temp(xm, jy), Gx = g_temp(jx, jy), Gxp = g_temp(xp, jy);
-
-      // Here we split the loop over z into three parts; the first value, the middle block
-      // and the last value
-      // this is to allow the loop used in the middle block to vectorise.
-
-      {
-        const int jz = 0;
-        const int jzp = 1;
-        const int jzm = ncz - 1;
-#if BOUT_USE_METRIC_3D
-        const BoutReal spacingFactor =
-            1.0 / (12 * metric->dz(jx, jy, jz) * metric->dx(jx, jy, jz));
-#endif
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = ((Fx[jzp] - Fx[jzm]) * (Gxp[jz] - Gxm[jz])
-                              - (Fxp[jz] - Fxm[jz]) * (Gx[jzp] - Gx[jzm]));
-
-        // J+x
-        const BoutReal Jpx =
-            (Gxp[jz] * (Fxp[jzp] - Fxp[jzm]) - Gxm[jz] * (Fxm[jzp] - Fxm[jzm])
-             - Gx[jzp] * (Fxp[jzp] - Fxm[jzp]) + Gx[jzm] * (Fxp[jzm] - Fxm[jzm]));
-
-        // Jx+
-        const BoutReal Jxp =
-            (Gxp[jzp] * (Fx[jzp] - Fxp[jz]) - Gxm[jzm] * (Fxm[jz] - Fx[jzm])
-             - Gxm[jzp] * (Fx[jzp] - Fxm[jz]) + Gxp[jzm] * (Fxp[jz] - Fx[jzm]));
-
-        result(jx, jy, jz) = (Jpp + Jpx + Jxp) * spacingFactor;
-      }
-
-      for (int jz = 1; jz < mesh->LocalNz - 1; jz++) {
-#if BOUT_USE_METRIC_3D
-        const BoutReal spacingFactor =
-            1.0 / (12 * metric->dz(jx, jy, jz) * metric->dx(jx, jy, jz));
-#endif
-        const int jzp = jz + 1;
-        const int jzm = jz - 1;
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = ((Fx[jzp] - Fx[jzm]) * (Gxp[jz] - Gxm[jz])
-                              - (Fxp[jz] - Fxm[jz]) * (Gx[jzp] - Gx[jzm]));
-
-        // J+x
-        const BoutReal Jpx =
-            (Gxp[jz] * (Fxp[jzp] - Fxp[jzm]) - Gxm[jz] * (Fxm[jzp] - Fxm[jzm])
-             - Gx[jzp] * (Fxp[jzp] - Fxm[jzp]) + Gx[jzm] * (Fxp[jzm] - Fxm[jzm]));
-
-        // Jx+
-        const BoutReal Jxp =
-            (Gxp[jzp] * (Fx[jzp] - Fxp[jz]) - Gxm[jzm] * (Fxm[jz] - Fx[jzm])
-             - Gxm[jzp] * (Fx[jzp] - Fxm[jz]) + Gxp[jzm] * (Fxp[jz] - Fx[jzm]));
-
-        result(jx, jy, jz) = (Jpp + Jpx + Jxp) * spacingFactor;
-      }
-
-      {
-        const int jz = ncz - 1;
-        const int jzp = 0;
-        const int jzm = ncz - 2;
-#if BOUT_USE_METRIC_3D
-        const BoutReal spacingFactor =
-            1.0 / (12 * metric->dz(jx, jy, jz) * metric->dx(jx, jy, jz));
-#endif
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = ((Fx[jzp] - Fx[jzm]) * (Gxp[jz] - Gxm[jz])
-                              - (Fxp[jz] - Fxm[jz]) * (Gx[jzp] - Gx[jzm]));
-
-        // J+x
-        const BoutReal Jpx =
-            (Gxp[jz] * (Fxp[jzp] - Fxp[jzm]) - Gxm[jz] * (Fxm[jzp] - Fxm[jzm])
-             - Gx[jzp] * (Fxp[jzp] - Fxm[jzp]) + Gx[jzm] * (Fxp[jzm] - Fxm[jzm]));
-
-        // Jx+
-        const BoutReal Jxp =
-            (Gxp[jzp] * (Fx[jzp] - Fxp[jz]) - Gxm[jzm] * (Fxm[jz] - Fx[jzm])
-             - Gxm[jzp] * (Fx[jzp] - Fxm[jz]) + Gxp[jzm] * (Fxp[jz] - Fx[jzm]));
-
-        result(jx, jy, jz) = (Jpp + Jpx + Jxp) * spacingFactor;
-      }
+      const BoutReal* Fxm = f_temp(xm, jy);
+      const BoutReal* Fx = f_temp(jx, jy);
+      const BoutReal* Fxp = f_temp(xp, jy);
+      const BoutReal* Gxm = g_temp(xm, jy);
+      const BoutReal* Gx = g_temp(jx, jy);
+      const BoutReal* Gxp = g_temp(xp, jy);
+
+      arakawaRow(
+          ncz,
+          [=](int jz, int jzm, int jzp) {
+            // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
+            const BoutReal Jpp = ((Fx[jzp] - Fx[jzm]) * (Gxp[jz] - Gxm[jz])
+                                  - (Fxp[jz] - Fxm[jz]) * (Gx[jzp] - Gx[jzm]));
+
+            // J+x
+            const BoutReal Jpx =
+                (Gxp[jz] * (Fxp[jzp] - Fxp[jzm]) - Gxm[jz] * (Fxm[jzp] - Fxm[jzm])
+                 - Gx[jzp] * (Fxp[jzp] - Fxm[jzp]) + Gx[jzm] * (Fxp[jzm] - Fxm[jzm]));
+
+            // Jx+
+            const BoutReal Jxp =
+                (Gxp[jzp] * (Fx[jzp] - Fxp[jz]) - Gxm[jzm] * (Fxm[jz] - Fx[jzm])
+                 - Gxm[jzp] * (Fx[jzp] - Fxm[jz]) + Gxp[jzm] * (Fxp[jz] - Fx[jzm]));
+
+            return Jpp + Jpx + Jxp;
+          },
+          arakawaSpacing(metric, jx, jy), result(jx, jy));
     }
     break;
   }
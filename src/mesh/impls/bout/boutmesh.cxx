@@ -93,6 +93,11 @@ BoutMesh::~BoutMesh() {
   if (comm_outer != MPI_COMM_NULL) {
     MPI_Comm_free(&comm_outer);
   }
+
+  clear_halo_types();
+  for (auto& type : subarray_types) {
+    mpi->MPI_Type_free(&type.second);
+  }
 }
 
 BoutMesh::YDecompositionIndices
@@ -496,6 +501,11 @@ int BoutMesh::load() {
                    .doc("Whether to use asyncronous MPI sends")
                    .withDefault(false);
 
+  derived_datatypes = options["derived_datatypes"]
+                          .doc("Send guard cells directly from field data using MPI "
+                               "derived datatypes, rather than copying through buffers")
+                          .withDefault(false);
+
   if (options.isSet("zperiod")) {
     OPTION(options, zperiod, 1);
     ZMIN = 0.0;
@@ -1075,27 +1085,26 @@ const int IN_SENT_OUT = 4; ///< Data going in positive X direction (in to out)
 const int OUT_SENT_IN = 5; ///< Data going in negative X direction (out to in)
 
 void BoutMesh::post_receiveX(CommHandle& ch) {
+  const int yge = ch.include_x_corners ? 0 : MYG;
+  const int ylt = ch.include_x_corners ? LocalNy : MYG + MYSUB;
+
   /// Post receive data from left (x-1)
 
   if (IDATA_DEST != -1) {
-    mpi->MPI_Irecv(
-        std::begin(ch.imsg_recvbuff),
-        msg_len(ch.var_list.get(), 0, MXG, 0, ch.include_x_corners ? LocalNy : MYSUB),
-        PVEC_REAL_MPI_TYPE, IDATA_DEST, OUT_SENT_IN, BoutComm::get(), &ch.request[4]);
+    post_receive(ch, 0, MXG, yge, ylt, std::begin(ch.imsg_recvbuff), IDATA_DEST,
+                 OUT_SENT_IN, &ch.request[4]);
   }
 
   // Post receive data from right (x+1)
 
   if (ODATA_DEST != -1) {
-    mpi->MPI_Irecv(
-        std::begin(ch.omsg_recvbuff),
-        msg_len(ch.var_list.get(), 0, MXG, 0, ch.include_x_corners ? LocalNy : MYSUB),
-        PVEC_REAL_MPI_TYPE, ODATA_DEST, IN_SENT_OUT, BoutComm::get(), &ch.request[5]);
+    post_receive(ch, MXSUB + MXG, MXSUB + 2 * MXG, yge, ylt,
+                 std::begin(ch.omsg_recvbuff), ODATA_DEST, IN_SENT_OUT,
+                 &ch.request[5]);
   }
 }
 
 void BoutMesh::post_receiveY(CommHandle& ch) {
-  BoutReal* inbuff;
   int len;
 
   /// Post receive data from above (y+1)
@@ -1103,14 +1112,14 @@ void BoutMesh::post_receiveY(CommHandle& ch) {
   len = 0;
   if (UDATA_INDEST != -1) {
     len = msg_len(ch.var_list.get(), 0, UDATA_XSPLIT, 0, MYG);
-    mpi->MPI_Irecv(std::begin(ch.umsg_recvbuff), len, PVEC_REAL_MPI_TYPE, UDATA_INDEST,
-                   IN_SENT_DOWN, BoutComm::get(), &ch.request[0]);
+    post_receive(ch, 0, UDATA_XSPLIT, MYSUB + MYG, MYSUB + 2 * MYG,
+                 std::begin(ch.umsg_recvbuff), UDATA_INDEST, IN_SENT_DOWN,
+                 &ch.request[0]);
   }
   if (UDATA_OUTDEST != -1) {
-    inbuff = &ch.umsg_recvbuff[len]; // pointer to second half of the buffer
-    mpi->MPI_Irecv(inbuff, msg_len(ch.var_list.get(), UDATA_XSPLIT, LocalNx, 0, MYG),
-                   PVEC_REAL_MPI_TYPE, UDATA_OUTDEST, OUT_SENT_DOWN, BoutComm::get(),
-                   &ch.request[1]);
+    // Second half of the buffer
+    post_receive(ch, UDATA_XSPLIT, LocalNx, MYSUB + MYG, MYSUB + 2 * MYG,
+                 &ch.umsg_recvbuff[len], UDATA_OUTDEST, OUT_SENT_DOWN, &ch.request[1]);
   }
 
   /// Post receive data from below (y-1)
@@ -1119,14 +1128,12 @@ void BoutMesh::post_receiveY(CommHandle& ch) {
 
   if (DDATA_INDEST != -1) { // If sending & recieving data from a processor
     len = msg_len(ch.var_list.get(), 0, DDATA_XSPLIT, 0, MYG);
-    mpi->MPI_Irecv(std::begin(ch.dmsg_recvbuff), len, PVEC_REAL_MPI_TYPE, DDATA_INDEST,
-                   IN_SENT_UP, BoutComm::get(), &ch.request[2]);
+    post_receive(ch, 0, DDATA_XSPLIT, 0, MYG, std::begin(ch.dmsg_recvbuff),
+                 DDATA_INDEST, IN_SENT_UP, &ch.request[2]);
   }
   if (DDATA_OUTDEST != -1) {
-    inbuff = &ch.dmsg_recvbuff[len];
-    mpi->MPI_Irecv(inbuff, msg_len(ch.var_list.get(), DDATA_XSPLIT, LocalNx, 0, MYG),
-                   PVEC_REAL_MPI_TYPE, DDATA_OUTDEST, OUT_SENT_UP, BoutComm::get(),
-                   &ch.request[3]);
+    post_receive(ch, DDATA_XSPLIT, LocalNx, 0, MYG, &ch.dmsg_recvbuff[len],
+                 DDATA_OUTDEST, OUT_SENT_UP, &ch.request[3]);
   }
 }
 
@@ -1181,32 +1188,19 @@ comm_handle BoutMesh::sendX(FieldGroup& g, comm_handle handle, bool disable_corn
 
   /// Send to the left (x-1)
 
+  const int yge = ch->include_x_corners ? 0 : MYG;
+  const int ylt = ch->include_x_corners ? LocalNy : MYG + MYSUB;
+
   if (IDATA_DEST != -1) {
-    int len = pack_data(ch->var_list.get(), MXG, 2 * MXG, ch->include_x_corners ? 0 : MYG,
-                        ch->include_x_corners ? LocalNy : MYG + MYSUB,
-                        std::begin(ch->imsg_sendbuff));
-    if (async_send) {
-      mpi->MPI_Isend(std::begin(ch->imsg_sendbuff), len, PVEC_REAL_MPI_TYPE, IDATA_DEST,
-                     IN_SENT_OUT, BoutComm::get(), &(ch->sendreq[4]));
-    } else {
-      mpi->MPI_Send(std::begin(ch->imsg_sendbuff), len, PVEC_REAL_MPI_TYPE, IDATA_DEST,
-                    IN_SENT_OUT, BoutComm::get());
-    }
+    send_data(*ch, MXG, 2 * MXG, yge, ylt, std::begin(ch->imsg_sendbuff), IDATA_DEST,
+              IN_SENT_OUT, &(ch->sendreq[4]));
   }
 
   /// Send to the right (x+1)
 
   if (ODATA_DEST != -1) {
-    int len = pack_data(
-        ch->var_list.get(), MXSUB, MXSUB + MXG, ch->include_x_corners ? 0 : MYG,
-        ch->include_x_corners ? LocalNy : MYG + MYSUB, std::begin(ch->omsg_sendbuff));
-    if (async_send) {
-      mpi->MPI_Isend(std::begin(ch->omsg_sendbuff), len, PVEC_REAL_MPI_TYPE, ODATA_DEST,
-                     OUT_SENT_IN, BoutComm::get(), &(ch->sendreq[5]));
-    } else {
-      mpi->MPI_Send(std::begin(ch->omsg_sendbuff), len, PVEC_REAL_MPI_TYPE, ODATA_DEST,
-                    OUT_SENT_IN, BoutComm::get());
-    }
+    send_data(*ch, MXSUB, MXSUB + MXG, yge, ylt, std::begin(ch->omsg_sendbuff),
+              ODATA_DEST, OUT_SENT_IN, &(ch->sendreq[5]));
   }
 
   /// Mark communication handle as in progress
@@ -1239,68 +1233,29 @@ comm_handle BoutMesh::sendY(FieldGroup& g, comm_handle handle) {
   /// Send data going up (y+1)
 
   int len = 0;
-  BoutReal* outbuff = nullptr;
 
   if (UDATA_INDEST != -1) { // If there is a destination for inner x data
-    len = pack_data(ch->var_list.get(), 0, UDATA_XSPLIT, MYSUB, MYSUB + MYG,
-                    std::begin(ch->umsg_sendbuff));
-    // Send the data to processor UDATA_INDEST
-
-    if (async_send) {
-      mpi->MPI_Isend(std::begin(ch->umsg_sendbuff), // Buffer to send
-                     len,                           // Length of buffer in BoutReals
-                     PVEC_REAL_MPI_TYPE,            // Real variable type
-                     UDATA_INDEST,                  // Destination processor
-                     IN_SENT_UP,                    // Label (tag) for the message
-                     BoutComm::get(), &(ch->sendreq[0]));
-    } else {
-      mpi->MPI_Send(std::begin(ch->umsg_sendbuff), len, PVEC_REAL_MPI_TYPE, UDATA_INDEST,
-                    IN_SENT_UP, BoutComm::get());
-    }
+    len = send_data(*ch, 0, UDATA_XSPLIT, MYSUB, MYSUB + MYG,
+                    std::begin(ch->umsg_sendbuff), UDATA_INDEST, IN_SENT_UP,
+                    &(ch->sendreq[0]));
   }
-  if (UDATA_OUTDEST != -1) {             // if destination for outer x data
-    outbuff = &(ch->umsg_sendbuff[len]); // A pointer to the start of the second part
-                                         // of the buffer
-    len =
-        pack_data(ch->var_list.get(), UDATA_XSPLIT, LocalNx, MYSUB, MYSUB + MYG, outbuff);
-    // Send the data to processor UDATA_OUTDEST
-    if (async_send) {
-      mpi->MPI_Isend(outbuff, len, PVEC_REAL_MPI_TYPE, UDATA_OUTDEST, OUT_SENT_UP,
-                     BoutComm::get(), &(ch->sendreq[1]));
-    } else {
-      mpi->MPI_Send(outbuff, len, PVEC_REAL_MPI_TYPE, UDATA_OUTDEST, OUT_SENT_UP,
-                    BoutComm::get());
-    }
+  if (UDATA_OUTDEST != -1) { // if destination for outer x data
+    // Use the second part of the buffer
+    send_data(*ch, UDATA_XSPLIT, LocalNx, MYSUB, MYSUB + MYG, &(ch->umsg_sendbuff[len]),
+              UDATA_OUTDEST, OUT_SENT_UP, &(ch->sendreq[1]));
   }
 
   /// Send data going down (y-1)
 
   len = 0;
   if (DDATA_INDEST != -1) { // If there is a destination for inner x data
-    len = pack_data(ch->var_list.get(), 0, DDATA_XSPLIT, MYG, 2 * MYG,
-                    std::begin(ch->dmsg_sendbuff));
-    // Send the data to processor DDATA_INDEST
-    if (async_send) {
-      mpi->MPI_Isend(std::begin(ch->dmsg_sendbuff), len, PVEC_REAL_MPI_TYPE, DDATA_INDEST,
-                     IN_SENT_DOWN, BoutComm::get(), &(ch->sendreq[2]));
-    } else {
-      mpi->MPI_Send(std::begin(ch->dmsg_sendbuff), len, PVEC_REAL_MPI_TYPE, DDATA_INDEST,
-                    IN_SENT_DOWN, BoutComm::get());
-    }
+    len = send_data(*ch, 0, DDATA_XSPLIT, MYG, 2 * MYG, std::begin(ch->dmsg_sendbuff),
+                    DDATA_INDEST, IN_SENT_DOWN, &(ch->sendreq[2]));
   }
-  if (DDATA_OUTDEST != -1) {             // if destination for outer x data
-    outbuff = &(ch->dmsg_sendbuff[len]); // A pointer to the start of the second part
-                                         // of the buffer
-    len = pack_data(ch->var_list.get(), DDATA_XSPLIT, LocalNx, MYG, 2 * MYG, outbuff);
-    // Send the data to processor DDATA_OUTDEST
-
-    if (async_send) {
-      mpi->MPI_Isend(outbuff, len, PVEC_REAL_MPI_TYPE, DDATA_OUTDEST, OUT_SENT_DOWN,
-                     BoutComm::get(), &(ch->sendreq[3]));
-    } else {
-      mpi->MPI_Send(outbuff, len, PVEC_REAL_MPI_TYPE, DDATA_OUTDEST, OUT_SENT_DOWN,
-                    BoutComm::get());
-    }
+  if (DDATA_OUTDEST != -1) { // if destination for outer x data
+    // Use the second part of the buffer
+    send_data(*ch, DDATA_XSPLIT, LocalNx, MYG, 2 * MYG, &(ch->dmsg_sendbuff[len]),
+              DDATA_OUTDEST, OUT_SENT_DOWN, &(ch->sendreq[3]));
   }
 
   /// Mark communication handle as in progress
@@ -1330,7 +1285,7 @@ int BoutMesh::wait(comm_handle handle) {
 
   ///////////// WAIT FOR DATA //////////////
 
-  int ind, len;
+  int ind;
   MPI_Status status;
 
   if (ch->var_list.empty()) {
@@ -1344,44 +1299,8 @@ int BoutMesh::wait(comm_handle handle) {
 
   do {
     mpi->MPI_Waitany(6, ch->request, &ind, &status);
-    switch (ind) {
-    case 0: { // Up, inner
-      unpack_data(ch->var_list.get(), 0, UDATA_XSPLIT, MYSUB + MYG, MYSUB + 2 * MYG,
-                  std::begin(ch->umsg_recvbuff));
-      break;
-    }
-    case 1: { // Up, outer
-      len = msg_len(ch->var_list.get(), 0, UDATA_XSPLIT, 0, MYG);
-      unpack_data(ch->var_list.get(), UDATA_XSPLIT, LocalNx, MYSUB + MYG, MYSUB + 2 * MYG,
-                  &(ch->umsg_recvbuff[len]));
-      break;
-    }
-    case 2: { // Down, inner
-      unpack_data(ch->var_list.get(), 0, DDATA_XSPLIT, 0, MYG,
-                  std::begin(ch->dmsg_recvbuff));
-      break;
-    }
-    case 3: { // Down, outer
-      len = msg_len(ch->var_list.get(), 0, DDATA_XSPLIT, 0, MYG);
-      unpack_data(ch->var_list.get(), DDATA_XSPLIT, LocalNx, 0, MYG,
-                  &(ch->dmsg_recvbuff[len]));
-      break;
-    }
-    case 4: { // inner
-      unpack_data(ch->var_list.get(), 0, MXG, ch->include_x_corners ? 0 : MYG,
-                  ch->include_x_corners ? LocalNy : MYG + MYSUB,
-                  std::begin(ch->imsg_recvbuff));
-      break;
-    }
-    case 5: { // outer
-      unpack_data(ch->var_list.get(), MXSUB + MXG, MXSUB + 2 * MXG,
-                  ch->include_x_corners ? 0 : MYG,
-                  ch->include_x_corners ? LocalNy : MYG + MYSUB,
-                  std::begin(ch->omsg_recvbuff));
-      break;
-    }
-    }
     if (ind != MPI_UNDEFINED) {
+      unpack_received(*ch, ind);
       ch->request[ind] = MPI_REQUEST_NULL;
     }
   } while (ind != MPI_UNDEFINED);
@@ -1410,10 +1329,69 @@ int BoutMesh::wait(comm_handle handle) {
     }
   }
 
-  if (ch->has_y_communication) {
+  apply_twist_shift(*ch);
+
+#if CHECK > 0
+  // Keeping track of whether communications have been done
+  for (const auto& var : ch->var_list) {
+    var->doneComms();
+  }
+#endif
+
+  free_handle(ch);
+
+  return 0;
+}
+
+void BoutMesh::unpack_received(CommHandle& ch, int ind) {
+  // With derived datatypes the data may have been received directly into
+  // the fields, otherwise it has to be copied out of the buffers
+  if (not ch.direct_receive) {
+    switch (ind) {
+    case 0: { // Up, inner
+      unpack_data(ch.var_list.get(), 0, UDATA_XSPLIT, MYSUB + MYG, MYSUB + 2 * MYG,
+                  std::begin(ch.umsg_recvbuff));
+      break;
+    }
+    case 1: { // Up, outer
+      const int len = msg_len(ch.var_list.get(), 0, UDATA_XSPLIT, 0, MYG);
+      unpack_data(ch.var_list.get(), UDATA_XSPLIT, LocalNx, MYSUB + MYG,
+                  MYSUB + 2 * MYG, &(ch.umsg_recvbuff[len]));
+      break;
+    }
+    case 2: { // Down, inner
+      unpack_data(ch.var_list.get(), 0, DDATA_XSPLIT, 0, MYG,
+                  std::begin(ch.dmsg_recvbuff));
+      break;
+    }
+    case 3: { // Down, outer
+      const int len = msg_len(ch.var_list.get(), 0, DDATA_XSPLIT, 0, MYG);
+      unpack_data(ch.var_list.get(), DDATA_XSPLIT, LocalNx, 0, MYG,
+                  &(ch.dmsg_recvbuff[len]));
+      break;
+    }
+    case 4: { // inner
+      unpack_data(ch.var_list.get(), 0, MXG, ch.include_x_corners ? 0 : MYG,
+                  ch.include_x_corners ? LocalNy : MYG + MYSUB,
+                  std::begin(ch.imsg_recvbuff));
+      break;
+    }
+    case 5: { // outer
+      unpack_data(ch.var_list.get(), MXSUB + MXG, MXSUB + 2 * MXG,
+                  ch.include_x_corners ? 0 : MYG,
+                  ch.include_x_corners ? LocalNy : MYG + MYSUB,
+                  std::begin(ch.omsg_recvbuff));
+      break;
+    }
+    }
+  }
+}
+
+void BoutMesh::apply_twist_shift(CommHandle& ch) {
+  if (ch.has_y_communication) {
     // TWIST-SHIFT CONDITION
     // Loop over 3D fields
-    for (const auto& var : ch->var_list.field3d()) {
+    for (const auto& var : ch.var_list.field3d()) {
       if (var->requiresTwistShift(TwistShift)) {
         // Twist-shift only needed for field-aligned fields
         int jx = 0;
@@ -1454,6 +1432,74 @@ int BoutMesh::wait(comm_handle handle) {
       }
     }
   }
+}
+
+comm_handle BoutMesh::createCommPlan(FieldGroup& g) {
+  TRACE("BoutMesh::createCommPlan(FieldGroup&)");
+
+  /// Start timer
+  Timer timer("comms");
+
+  /// Work out length of buffer needed
+  int xlen = msg_len(g.get(), 0, MXG, 0, include_corner_cells ? LocalNy : MYSUB);
+  int ylen = msg_len(g.get(), 0, LocalNx, 0, MYG);
+
+  CommHandle* ch = get_handle(xlen, ylen);
+  ch->var_list = g;
+  ch->persistent = true;
+  for (auto& i : ch->sendreq) {
+    i = MPI_REQUEST_NULL;
+  }
+
+  // With a persistent handle these create the MPI requests, with the
+  // same buffers and tags as a normal communication, but don't start them
+  sendY(g, ch);
+  sendX(g, ch);
+
+  ch->in_progress = false;
+
+  return static_cast<comm_handle>(ch);
+}
+
+void BoutMesh::startCommPlan(comm_handle plan) {
+  TRACE("BoutMesh::startCommPlan(comm_handle)");
+
+  /// Start timer
+  Timer timer("comms");
+
+  auto* ch = static_cast<CommHandle*>(plan);
+
+  // With corner cells the x-communication has to wait until the y guard
+  // cells have arrived, so is started in finishCommPlan
+  start_persistent(*ch, 0, ch->include_x_corners ? 4 : 6);
+
+  ch->in_progress = true;
+}
+
+void BoutMesh::finishCommPlan(comm_handle plan) {
+  TRACE("BoutMesh::finishCommPlan(comm_handle)");
+
+  auto* ch = static_cast<CommHandle*>(plan);
+
+  if (!ch->in_progress) {
+    return;
+  }
+
+  {
+    /// Start timer
+    Timer timer("comms");
+
+    wait_persistent(*ch);
+    apply_twist_shift(*ch);
+
+    if (ch->include_x_corners) {
+      // Send the x guard cells, including the y guard cells just received
+      start_persistent(*ch, 4, 6);
+      wait_persistent(*ch);
+    }
+  }
+
+  ch->in_progress = false;
 
 #if CHECK > 0
   // Keeping track of whether communications have been done
@@ -1462,9 +1508,70 @@ int BoutMesh::wait(comm_handle handle) {
   }
 #endif
 
+  // Calculate yup and ydown fields for 3D fields
+  if (calcParallelSlices_on_communicate) {
+    for (const auto& fptr : ch->var_list.field3d()) {
+      fptr->calcParallelSlices();
+    }
+  }
+}
+
+void BoutMesh::freeCommPlan(comm_handle plan) {
+  auto* ch = static_cast<CommHandle*>(plan);
+
+  if (ch->in_progress) {
+    finishCommPlan(plan);
+  }
+
+  for (auto& i : ch->request) {
+    if (i != MPI_REQUEST_NULL) {
+      mpi->MPI_Request_free(&i);
+    }
+  }
+  for (auto& i : ch->sendreq) {
+    if (i != MPI_REQUEST_NULL) {
+      mpi->MPI_Request_free(&i);
+    }
+  }
+
+  ch->persistent = false;
   free_handle(ch);
+}
 
-  return 0;
+void BoutMesh::start_persistent(CommHandle& ch, int first, int last) {
+  // Post the receives before sending
+  for (int i = first; i < last; ++i) {
+    if (ch.request[i] != MPI_REQUEST_NULL) {
+      mpi->MPI_Start(&ch.request[i]);
+    }
+  }
+
+  for (int i = first; i < last; ++i) {
+    if (ch.sendreq[i] != MPI_REQUEST_NULL) {
+      const auto& region = ch.send_region[i];
+      pack_data(ch.var_list.get(), region[0], region[1], region[2], region[3],
+                ch.send_buffer[i]);
+      mpi->MPI_Start(&ch.sendreq[i]);
+    }
+  }
+}
+
+void BoutMesh::wait_persistent(CommHandle& ch) {
+  int ind;
+  MPI_Status status;
+
+  // Completed persistent requests become inactive rather than
+  // MPI_REQUEST_NULL, and are ignored by MPI_Waitany, so this returns
+  // MPI_UNDEFINED once all the started receives have arrived
+  do {
+    mpi->MPI_Waitany(6, ch.request, &ind, &status);
+    if (ind != MPI_UNDEFINED) {
+      unpack_received(ch, ind);
+    }
+  } while (ind != MPI_UNDEFINED);
+
+  // The send buffers are packed again on the next start
+  mpi->MPI_Waitall(6, ch.sendreq, MPI_STATUSES_IGNORE);
 }
 
 /***************************************************************
@@ -2141,6 +2248,8 @@ BoutMesh::CommHandle* BoutMesh::get_handle(int xlen, int ylen) {
     ch->ybufflen = ylen;
 
     ch->in_progress = false;
+    ch->persistent = false;
+    ch->direct_receive = false;
 
     return ch;
   }
@@ -2170,6 +2279,8 @@ BoutMesh::CommHandle* BoutMesh::get_handle(int xlen, int ylen) {
   ch->in_progress = false;
   ch->include_x_corners = false;
   ch->has_y_communication = false;
+  ch->persistent = false;
+  ch->direct_receive = false;
 
   ch->var_list.clear();
 
@@ -2307,6 +2418,156 @@ int BoutMesh::unpack_data(const std::vector<FieldData*>& var_list, int xge, int
   return (len);
 }
 
+void BoutMesh::post_receive(CommHandle& ch, int xge, int xlt, int yge, int ylt,
+                            BoutReal* buffer, int source, int tag,
+                            MPI_Request* request) {
+  if (ch.persistent) {
+    mpi->MPI_Recv_init(buffer, msg_len(ch.var_list.get(), xge, xlt, yge, ylt),
+                       PVEC_REAL_MPI_TYPE, source, tag, BoutComm::get(), request);
+    return;
+  }
+
+  // The same for every receive of this handle, as the fields don't change
+  ch.direct_receive = derived_datatypes and can_receive_direct(ch.var_list.get());
+  if (ch.direct_receive) {
+    MPI_Datatype type = halo_datatype(ch.var_list.get(), xge, xlt, yge, ylt);
+    mpi->MPI_Irecv(MPI_BOTTOM, 1, type, source, tag, BoutComm::get(), request);
+    return;
+  }
+
+  mpi->MPI_Irecv(buffer, msg_len(ch.var_list.get(), xge, xlt, yge, ylt),
+                 PVEC_REAL_MPI_TYPE, source, tag, BoutComm::get(), request);
+}
+
+int BoutMesh::send_data(CommHandle& ch, int xge, int xlt, int yge, int ylt,
+                        BoutReal* buffer, int dest, int tag, MPI_Request* request) {
+  if (ch.persistent) {
+    // Remember what to pack into the buffer when the request is started
+    const auto ind = request - std::begin(ch.sendreq);
+    ch.send_region[ind] = {xge, xlt, yge, ylt};
+    ch.send_buffer[ind] = buffer;
+
+    const int len = msg_len(ch.var_list.get(), xge, xlt, yge, ylt);
+    mpi->MPI_Send_init(buffer, len, PVEC_REAL_MPI_TYPE, dest, tag, BoutComm::get(),
+                       request);
+    return len;
+  }
+
+  // Fields which share data can still be sent directly, as only the
+  // receive datatype must not overlap. The message is the same either way
+  if (derived_datatypes) {
+    MPI_Datatype type = halo_datatype(ch.var_list.get(), xge, xlt, yge, ylt);
+    if (async_send) {
+      mpi->MPI_Isend(MPI_BOTTOM, 1, type, dest, tag, BoutComm::get(), request);
+    } else {
+      mpi->MPI_Send(MPI_BOTTOM, 1, type, dest, tag, BoutComm::get());
+    }
+    return 0;
+  }
+
+  const int len = pack_data(ch.var_list.get(), xge, xlt, yge, ylt, buffer);
+  if (async_send) {
+    mpi->MPI_Isend(buffer, len, PVEC_REAL_MPI_TYPE, dest, tag, BoutComm::get(), request);
+  } else {
+    mpi->MPI_Send(buffer, len, PVEC_REAL_MPI_TYPE, dest, tag, BoutComm::get());
+  }
+  return len;
+}
+
+namespace {
+/// Address of the start of the data of \p var, which must be allocated
+const BoutReal* fieldDataAddress(FieldData* var) {
+  if (var->is3D()) {
+    auto& var3d_ref = *dynamic_cast<Field3D*>(var);
+    ASSERT2(var3d_ref.isAllocated());
+    return &var3d_ref(0, 0, 0);
+  }
+  auto& var2d_ref = *dynamic_cast<Field2D*>(var);
+  ASSERT2(var2d_ref.isAllocated());
+  return &var2d_ref(0, 0);
+}
+} // namespace
+
+bool BoutMesh::can_receive_direct(const std::vector<FieldData*>& var_list) const {
+  // Fields can share data if the same field is added twice, or
+  // through copy-on-write
+  std::set<const BoutReal*> addresses;
+  for (const auto& var : var_list) {
+    if (not addresses.insert(fieldDataAddress(var)).second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+MPI_Datatype BoutMesh::halo_datatype(const std::vector<FieldData*>& var_list, int xge,
+                                     int xlt, int yge, int ylt) {
+  const bool empty = (xlt <= xge) or (ylt <= yge);
+
+  HaloTypeKey key{{xge, xlt, yge, ylt}, {}};
+  if (not empty) {
+    for (const auto& var : var_list) {
+      key.second.emplace_back(fieldDataAddress(var), var->is3D());
+    }
+  }
+
+  const auto cached = halo_types.find(key);
+  if (cached != halo_types.end()) {
+    return cached->second;
+  }
+
+  const auto nvars = static_cast<int>(key.second.size());
+
+  std::vector<int> blocklengths(nvars, 1);
+  std::vector<MPI_Aint> displacements(nvars);
+  std::vector<MPI_Datatype> types(nvars);
+
+  for (int i = 0; i < nvars; ++i) {
+    const bool is3D = key.second[i].second;
+
+    // Get the datatype for this region of a single field, creating
+    // it if this is the first time this region has been used
+    const std::array<int, 5> subarray_key{is3D ? 1 : 0, xge, xlt, yge, ylt};
+    auto it = subarray_types.find(subarray_key);
+    if (it == subarray_types.end()) {
+      const std::array<int, 3> sizes{LocalNx, LocalNy, LocalNz};
+      const std::array<int, 3> subsizes{xlt - xge, ylt - yge, LocalNz};
+      const std::array<int, 3> starts{xge, yge, 0};
+      MPI_Datatype type;
+      mpi->MPI_Type_create_subarray(is3D ? 3 : 2, sizes.data(), subsizes.data(),
+                                    starts.data(), MPI_ORDER_C, PVEC_REAL_MPI_TYPE,
+                                    &type);
+      mpi->MPI_Type_commit(&type);
+      it = subarray_types.emplace(subarray_key, type).first;
+    }
+    types[i] = it->second;
+
+    // Absolute address of the start of the field data
+    mpi->MPI_Get_address(key.second[i].first, &displacements[i]);
+  }
+
+  MPI_Datatype result;
+  mpi->MPI_Type_create_struct(nvars, blocklengths.data(), displacements.data(),
+                              types.data(), &result);
+  mpi->MPI_Type_commit(&result);
+
+  // Fields which are reallocated get new addresses, so limit how many
+  // types are kept
+  if (halo_types.size() >= max_halo_types) {
+    clear_halo_types();
+  }
+  halo_types.emplace(std::move(key), result);
+  return result;
+}
+
+void BoutMesh::clear_halo_types() {
+  // Communications still using these types complete normally
+  for (auto& type : halo_types) {
+    mpi->MPI_Type_free(&type.second);
+  }
+  halo_types.clear();
+}
+
 /****************************************************************
  *                 SURFACE ITERATION
  ****************************************************************/
@@ -7,10 +7,13 @@
 #include "bout/unused.hxx"
 #include <bout/mesh.hxx>
 
+#include <array>
 #include <cmath>
 #include <list>
+#include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 /// Implementation of Mesh (mostly) compatible with BOUT
@@ -55,6 +58,24 @@ public:
   /// @param[in] handle  The handle returned by send()
   int wait(comm_handle handle) override;
 
+  /// Create a plan which communicates the fields in \p g using
+  /// persistent MPI requests, so that the requests are created once
+  /// and then reused by each startCommPlan()
+  ///
+  /// Persistent communications always copy the guard cells through
+  /// buffers, even if derived_datatypes is set, as the data of the
+  /// fields may be reallocated between communications
+  comm_handle createCommPlan(FieldGroup& g) override;
+
+  /// Pack the send buffers and start the persistent requests
+  void startCommPlan(comm_handle plan) override;
+
+  /// Wait for the persistent requests to complete, and unpack the data
+  void finishCommPlan(comm_handle plan) override;
+
+  /// Free the persistent requests
+  void freeCommPlan(comm_handle plan) override;
+
   /////////////////////////////////////////////
   // non-local communications
 
@@ -401,6 +422,10 @@ private:
 
   bool async_send{false}; ///< Switch to asyncronous sends (ISend, not Send)
 
+  /// Send and receive guard cells directly from field data using MPI
+  /// derived datatypes, rather than copying through buffers
+  bool derived_datatypes{false};
+
   /// Communication handle
   /// Used to keep track of communications between send and receive
   struct CommHandle {
@@ -422,6 +447,16 @@ private:
     bool include_x_corners;
     /// Is there a y-communication
     bool has_y_communication;
+    /// Are the requests persistent (see createCommPlan)?
+    bool persistent;
+    /// Are the guard cells received directly into the fields, rather
+    /// than through the receive buffers?
+    bool direct_receive;
+    /// For persistent requests, the region {xge, xlt, yge, ylt} to pack
+    /// into the send buffers before each send is started
+    std::array<int, 4> send_region[6];
+    /// For persistent requests, the buffer used by each send
+    BoutReal* send_buffer[6];
     /// List of fields being communicated
     FieldGroup var_list;
   };
@@ -455,6 +490,32 @@ private:
   /// Create the MPI requests to receive data in the y-direction. Non-blocking call.
   void post_receiveY(CommHandle& ch);
 
+  /// Start the persistent requests with indices [\p first, \p last),
+  /// packing the send buffers
+  void start_persistent(CommHandle& ch, int first, int last);
+
+  /// Wait for all the started persistent requests in \p ch to finish
+  void wait_persistent(CommHandle& ch);
+
+  /// Copy data out of the receive buffer for request \p ind into the fields
+  void unpack_received(CommHandle& ch, int ind);
+
+  /// Apply the twist-shift condition to y guard cells received
+  void apply_twist_shift(CommHandle& ch);
+
+  /// Post a receive for the region [xge, xlt) x [yge, ylt) of the fields in
+  /// \p ch, either into \p buffer or, if derived_datatypes is set, directly
+  /// into the fields. For a persistent \p ch, only creates the request
+  void post_receive(CommHandle& ch, int xge, int xlt, int yge, int ylt,
+                    BoutReal* buffer, int source, int tag, MPI_Request* request);
+
+  /// Send the region [xge, xlt) x [yge, ylt) of the fields in \p ch,
+  /// either packed into \p buffer or, if derived_datatypes is set,
+  /// directly from the fields. Returns the number of BoutReals used in
+  /// \p buffer. For a persistent \p ch, only creates the request
+  int send_data(CommHandle& ch, int xge, int xlt, int yge, int ylt, BoutReal* buffer,
+                int dest, int tag, MPI_Request* request);
+
   /// Take data from objects and put into a buffer
   int pack_data(const std::vector<FieldData*>& var_list, int xge, int xlt, int yge,
                 int ylt, BoutReal* buffer);
@@ -462,6 +523,31 @@ private:
 
   int unpack_data(const std::vector<FieldData*>& var_list, int xge, int xlt, int yge,
                   int ylt, BoutReal* buffer);
+
+  /// Can the guard cells of \p var_list be received directly into the
+  /// fields? Not if two of the fields share their data, as the
+  /// receive datatype would then overlap itself
+  bool can_receive_direct(const std::vector<FieldData*>& var_list) const;
+
+  /// Get an MPI datatype describing the region [xge, xlt) x [yge, ylt)
+  /// of all the fields in \p var_list, relative to MPI_BOTTOM. The
+  /// returned type is committed and cached, so must not be freed
+  MPI_Datatype halo_datatype(const std::vector<FieldData*>& var_list, int xge, int xlt,
+                             int yge, int ylt);
+
+  /// Datatypes for a region of a single field, keyed on {is3D, xge,
+  /// xlt, yge, ylt}. These are created once and reused by halo_datatype
+  std::map<std::array<int, 5>, MPI_Datatype> subarray_types;
+
+  /// Key of a halo datatype: the region {xge, xlt, yge, ylt}, and the
+  /// data address and dimension of each field
+  using HaloTypeKey =
+      std::pair<std::array<int, 4>, std::vector<std::pair<const BoutReal*, bool>>>;
+  /// Datatypes for a region of a group of fields, created by
+  /// halo_datatype. Cleared if it grows beyond max_halo_types
+  std::map<HaloTypeKey, MPI_Datatype> halo_types;
+  static constexpr std::size_t max_halo_types = 256;
+  void clear_halo_types();
 };
 
 namespace {
@@ -28,6 +28,10 @@
 #include <bout/msg_stack.hxx>
 #include <bout/unused.hxx>
 
+#include <array>
+#include <string>
+#include <vector>
+
 /*******************************************************************************
  * Helper routines
  *******************************************************************************/
@@ -68,6 +72,49 @@ STAGGER Mesh::getStagger(const CELL_LOC vloc, MAYBE_UNUSED(const CELL_LOC inloc)
   return getStagger(vloc, outloc, allowedStaggerLoc);
 }
 
+namespace bout {
+namespace derivatives {
+namespace index {
+
+bool canFusedYDerivative(const Field3D& f, DERIV derivType, CELL_LOC outloc,
+                         const std::string& method, const std::string& region) {
+  const CELL_LOC inloc = f.getLocation();
+  if (outloc != CELL_DEFAULT and outloc != inloc) {
+    return false;
+  }
+  if (f.getMesh()->getNpoints(DIRECTION::Y) == 1) {
+    return false;
+  }
+  const auto realMethod = DerivativeStore<Field3D>::getInstance().resolveMethodName(
+      method, DIRECTION::Y, STAGGER::None, derivType);
+  return f.getCoordinates()->getParallelTransform().canFusedYDerivative(
+      derivType, uppercase(realMethod), region);
+}
+
+Field3D fusedYDerivative(const Field3D& f, DERIV derivType, const std::string& method,
+                         const std::string& region) {
+  AUTO_TRACE();
+  {
+    TRACE("Checking input");
+    checkData(f);
+  }
+
+  const auto realMethod = DerivativeStore<Field3D>::getInstance().resolveMethodName(
+      method, DIRECTION::Y, STAGGER::None, derivType);
+  Field3D result = f.getCoordinates()->getParallelTransform().fusedYDerivative(
+      f, derivType, uppercase(realMethod), region);
+
+  {
+    TRACE("Checking result");
+    checkData(result);
+  }
+  return result;
+}
+
+} // namespace index
+} // namespace derivatives
+} // namespace bout
+
 ////////////////////// FIRST DERIVATIVES /////////////////////
 
 /// central, 2nd order
@@ -129,6 +176,62 @@ REGISTER_STANDARD_DERIVATIVE(D2DX2_C4, "C4", 2, DERIV::StandardSecond) {
   return (-f.pp + 16. * f.p - 30. * f.c + 16. * f.m - f.mm) / 12.;
 }
 
+namespace {
+/// The central second and first derivatives are often needed together,
+/// for example by D2DX2 on non-uniform grids, so compile those pairs
+/// into a single loop for `fusedDerivatives`
+produceCombinations<Set<WRAP_ENUM(DIRECTION, X), WRAP_ENUM(DIRECTION, Y),
+                        WRAP_ENUM(DIRECTION, YOrthogonal), WRAP_ENUM(DIRECTION, Z)>,
+                    Set<TypeContainer<Field3D>, TypeContainer<Field2D>>,
+                    Set<D2DX2_C2, D2DX2_C4>, Set<DDX_C2, DDX_C4>>
+    registerCentralFusedPairs(registerFusedPair{});
+} // namespace
+
+namespace {
+/// Weights of the points in the central stencil \p Kernel, found by
+/// applying it to one non-zero point at a time
+template <typename Kernel>
+std::vector<BoutReal> stencilWeights() {
+  constexpr int width = Kernel::meta.nGuards;
+  constexpr std::array<BoutReal stencil::*, 5> points{&stencil::mm, &stencil::m,
+                                                      &stencil::c, &stencil::p,
+                                                      &stencil::pp};
+  std::vector<BoutReal> weights;
+  for (int offset = -width; offset <= width; ++offset) {
+    stencil f{0., 0., 0., 0., 0.};
+    f.*points[2 + offset] = 1.;
+    weights.push_back(Kernel{}(f));
+  }
+  return weights;
+}
+} // namespace
+
+namespace bout {
+namespace derivatives {
+namespace index {
+std::vector<BoutReal> centralDifferenceWeights(DERIV derivType,
+                                               const std::string& method) {
+  if (method == "C2") {
+    if (derivType == DERIV::Standard) {
+      return stencilWeights<DDX_C2>();
+    }
+    if (derivType == DERIV::StandardSecond) {
+      return stencilWeights<D2DX2_C2>();
+    }
+  } else if (method == "C4") {
+    if (derivType == DERIV::Standard) {
+      return stencilWeights<DDX_C4>();
+    }
+    if (derivType == DERIV::StandardSecond) {
+      return stencilWeights<D2DX2_C4>();
+    }
+  }
+  return {};
+}
+} // namespace index
+} // namespace derivatives
+} // namespace bout
+
 //////////////////////////////
 //--- Fourth order derivatives
 //////////////////////////////
@@ -5,7 +5,11 @@
 #include <bout/msg_stack.hxx>
 #include <bout/utils.hxx>
 
+#include <chrono>
 #include <cmath>
+#include <limits>
+#include <set>
+#include <vector>
 
 #include <bout/boutcomm.hxx>
 #include <bout/output.hxx>
@@ -37,8 +41,14 @@ MeshFactory::ReturnType MeshFactory::create(const std::string& type, Options* op
     const auto grid_ext =
         (*options)["format"].withDefault(Options::root()["format"].withDefault(""));
 
+    const bool parallel_read =
+        (*options)["parallel_read"]
+            .doc("Open the grid file collectively on all processors, using parallel "
+                 "NetCDF?")
+            .withDefault(false);
+
     // Create a grid file
-    source = static_cast<GridDataSource*>(new GridFile(grid_name));
+    source = static_cast<GridDataSource*>(new GridFile(grid_name, parallel_read));
   } else {
     output << "\nGetting grid data from options\n";
     source = static_cast<GridDataSource*>(new GridFromOptions(options));
@@ -82,6 +92,36 @@ Mesh::Mesh(GridDataSource* s, Options* opt)
   }
 
   derivs_init(options); // in index_derivs.cxx for now
+
+  region_tiling = (*options)["region_tiling"]
+                      .doc("(Advanced) Iterate over the default 3D regions in tiles, to "
+                           "improve cache reuse for x and y stencils")
+                      .withDefault(false);
+  if (region_tiling) {
+    // Zero sizes are chosen in createDefaultRegions from the cache size
+    region_tile_shape.x = (*options)["tile_x"]
+                              .doc("Number of x points in each region tile. "
+                                   "0 chooses automatically")
+                              .withDefault(0);
+    region_tile_shape.y = (*options)["tile_y"]
+                              .doc("Number of y points in each region tile. "
+                                   "0 chooses automatically")
+                              .withDefault(0);
+    region_tile_shape.z = (*options)["tile_z"]
+                              .doc("Number of z points in each region tile. "
+                                   "0 chooses automatically")
+                              .withDefault(0);
+  }
+
+  autotune_regions = (*options)["autotune_regions"]
+                         .doc("(Advanced) Choose the block size of each 3D region, and "
+                              "the OpenMP schedule if possible, by timing loops at "
+                              "startup")
+                         .withDefault(false);
+  autotune_repeats = (*options)["autotune_repeats"]
+                         .doc("Number of times each loop is timed when autotuning. The "
+                              "fastest is used")
+                         .withDefault(3);
 }
 
 Mesh::~Mesh() { delete source; }
@@ -316,21 +356,29 @@ void Mesh::communicateYZ(FieldGroup& g) {
 void Mesh::communicate(FieldGroup& g) {
   TRACE("Mesh::communicate(FieldGroup&)");
 
+  finishCommunicate(startCommunicate(g), g);
+}
+
+comm_handle Mesh::startCommunicate(FieldGroup& g) {
+  TRACE("Mesh::startCommunicate(FieldGroup&)");
+
   if (include_corner_cells) {
-    // Send data in y-direction
-    comm_handle h = sendY(g);
+    // Send data in y-direction. The x-direction has to wait for this
+    // to finish, so that the corner cells are filled
+    return sendY(g);
+  }
+  return send(g);
+}
 
-    // Wait for data from other processors
-    wait(h);
+void Mesh::finishCommunicate(comm_handle handle, FieldGroup& g) {
+  TRACE("Mesh::finishCommunicate(FieldGroup&)");
 
-    // Send data in x-direction
-    h = sendX(g);
+  // Wait for data from other processors
+  wait(handle);
 
-    // Wait for data from other processors
-    wait(h);
-  } else {
-    // Send data
-    comm_handle h = send(g);
+  if (include_corner_cells) {
+    // Send data in x-direction
+    comm_handle h = sendX(g);
 
     // Wait for data from other processors
     wait(h);
@@ -344,6 +392,32 @@ void Mesh::communicate(FieldGroup& g) {
   }
 }
 
+namespace {
+/// Communication plan used by the default Mesh implementation: the
+/// fields, and the handle of a communication in progress
+struct DefaultCommPlan {
+  FieldGroup fields;
+  comm_handle handle{nullptr};
+};
+} // namespace
+
+comm_handle Mesh::createCommPlan(FieldGroup& g) {
+  return static_cast<comm_handle>(new DefaultCommPlan{g});
+}
+
+void Mesh::startCommPlan(comm_handle plan) {
+  auto* p = static_cast<DefaultCommPlan*>(plan);
+  p->handle = startCommunicate(p->fields);
+}
+
+void Mesh::finishCommPlan(comm_handle plan) {
+  auto* p = static_cast<DefaultCommPlan*>(plan);
+  finishCommunicate(p->handle, p->fields);
+  p->handle = nullptr;
+}
+
+void Mesh::freeCommPlan(comm_handle plan) { delete static_cast<DefaultCommPlan*>(plan); }
+
 /// This is a bit of a hack for now to get FieldPerp communications
 /// The FieldData class needs to be changed to accomodate FieldPerp objects
 void Mesh::communicate(FieldPerp& f) {
@@ -651,6 +725,28 @@ void Mesh::createDefaultRegions() {
   addRegion3D("RGN_NOCORNERS", (getRegion3D("RGN_NOBNDRY") + getRegion3D("RGN_XGUARDS")
                                 + getRegion3D("RGN_YGUARDS") + getRegion3D("RGN_ZGUARDS"))
                                    .unique());
+  // Points whose stencils (up to the width of the guard cells) don't
+  // use guard cells, and the remainder of RGN_NOBNDRY. Used to
+  // overlap calculations with communication
+  addRegion3D("RGN_NOBNDRY_INTERIOR",
+              Region<Ind3D>(xstart + xstart, xend - xstart, ystart + ystart,
+                            yend - ystart, zstart + zstart, zend - zstart, LocalNy,
+                            LocalNz, maxregionblocksize));
+  addRegion3D("RGN_NOBNDRY_SHELL",
+              mask(getRegion3D("RGN_NOBNDRY"), getRegion3D("RGN_NOBNDRY_INTERIOR")));
+
+  if (region_tiling) {
+    const auto automatic = bout::defaultRegionTileShape(LocalNx, LocalNy, LocalNz);
+    auto& shape = region_tile_shape;
+    shape.x = (shape.x > 0) ? shape.x : automatic.x;
+    shape.y = (shape.y > 0) ? shape.y : automatic.y;
+    shape.z = (shape.z > 0) ? shape.z : automatic.z;
+    output_info.write(_("\tIterating over 3D regions in tiles of {:d} x {:d} x {:d}\n"),
+                      shape.x, shape.y, shape.z);
+    for (auto& region : regionMap3D) {
+      region.second.tile(shape, maxregionblocksize);
+    }
+  }
 
   //2D regions
   addRegion2D("RGN_ALL", Region<Ind2D>(0, LocalNx - 1, 0, LocalNy - 1, 0, 0, LocalNy, 1,
@@ -679,6 +775,11 @@ void Mesh::createDefaultRegions() {
   addRegion2D("RGN_NOCORNERS", (getRegion2D("RGN_NOBNDRY") + getRegion2D("RGN_XGUARDS")
                                 + getRegion2D("RGN_YGUARDS") + getRegion2D("RGN_ZGUARDS"))
                                    .unique());
+  addRegion2D("RGN_NOBNDRY_INTERIOR",
+              Region<Ind2D>(xstart + xstart, xend - xstart, ystart + ystart,
+                            yend - ystart, 0, 0, LocalNy, 1, maxregionblocksize));
+  addRegion2D("RGN_NOBNDRY_SHELL",
+              mask(getRegion2D("RGN_NOBNDRY"), getRegion2D("RGN_NOBNDRY_INTERIOR")));
 
   // Perp regions
   addRegionPerp("RGN_ALL", Region<IndPerp>(0, LocalNx - 1, 0, 0, 0, LocalNz - 1, 1,
@@ -718,6 +819,109 @@ void Mesh::createDefaultRegions() {
   BOUT_FOR(ind3D, getRegion3D("RGN_ALL")) {
     indexLookup3Dto2D[ind3D.ind] = ind3Dto2D(ind3D).ind;
   }
+
+  if (autotune_regions) {
+    autotuneRegions();
+  }
+}
+
+namespace {
+/// Time some typical loops over \p region, returning the fastest of
+/// \p repeats. Coordinates don't exist yet, so these are stand-ins
+/// using the same memory accesses as arithmetic, an x derivative and
+/// the Arakawa bracket
+BoutReal timeRegionKernels(const Region<Ind3D>& region, int nx, int ny, int nz,
+                           int repeats) {
+  // Padding so that the stencils can be used in the guard cells
+  const int nynz = ny * nz;
+  const int pad = nynz + 1;
+  const int size = nx * nynz + 2 * pad;
+  std::vector<BoutReal> a_data(size, 1.0), b_data(size, 2.0), c_data(size, 3.0),
+      result_data(size, 0.0);
+  const BoutReal* a = a_data.data() + pad;
+  const BoutReal* b = b_data.data() + pad;
+  const BoutReal* c = c_data.data() + pad;
+  BoutReal* result = result_data.data() + pad;
+
+  BoutReal fastest = std::numeric_limits<BoutReal>::max();
+  for (int repeat = 0; repeat < repeats; ++repeat) {
+    const auto start = std::chrono::steady_clock::now();
+
+    BOUT_FOR(i, region) { result[i.ind] = a[i.ind] * b[i.ind] + c[i.ind]; }
+
+    BOUT_FOR(i, region) { result[i.ind] = 0.5 * (a[i.ind + nynz] - a[i.ind - nynz]); }
+
+    BOUT_FOR(i, region) {
+      const int ind = i.ind;
+      result[ind] = (a[ind + nynz] - a[ind - nynz]) * (b[ind + 1] - b[ind - 1])
+                    - (a[ind + 1] - a[ind - 1]) * (b[ind + nynz] - b[ind - nynz]);
+    }
+
+    const std::chrono::duration<BoutReal> elapsed =
+        std::chrono::steady_clock::now() - start;
+    fastest = std::min(fastest, elapsed.count());
+  }
+  return fastest;
+}
+} // namespace
+
+void Mesh::autotuneRegions() {
+  std::set<int> block_sizes{maxregionblocksize};
+  for (int block_size = 8; block_size <= 1024; block_size *= 2) {
+    block_sizes.insert(block_size);
+  }
+
+  output_info.write(_("\tAutotuning 3D region block sizes\n"));
+  for (auto& entry : regionMap3D) {
+    auto& region = entry.second;
+    if (region.size() == 0) {
+      continue;
+    }
+    auto indices = region.getIndices();
+
+    int fastest_size = maxregionblocksize;
+    BoutReal fastest_time = std::numeric_limits<BoutReal>::max();
+    for (int block_size : block_sizes) {
+      Region<Ind3D> trial = region;
+      trial.setIndices(indices, block_size);
+      if (region_tiling) {
+        trial.tile(region_tile_shape, block_size);
+      }
+      const BoutReal time =
+          timeRegionKernels(trial, LocalNx, LocalNy, LocalNz, autotune_repeats);
+      if (time < fastest_time) {
+        fastest_time = time;
+        fastest_size = block_size;
+      }
+    }
+
+    region.setIndices(indices, fastest_size);
+    if (region_tiling) {
+      region.tile(region_tile_shape, fastest_size);
+    }
+    output_info.write(_("\t\t{:s}: block size {:d}\n"), entry.first, fastest_size);
+  }
+
+  const auto schedules = bout::runtimeSchedules();
+  if (schedules.empty()) {
+    output_info.write(_("\tOpenMP schedule was fixed at compile time, not autotuning\n"));
+    return;
+  }
+
+  const auto& region = getRegion3D("RGN_NOBNDRY");
+  std::string fastest_schedule = schedules.front();
+  BoutReal fastest_time = std::numeric_limits<BoutReal>::max();
+  for (const auto& schedule : schedules) {
+    bout::setRuntimeSchedule(schedule);
+    const BoutReal time =
+        timeRegionKernels(region, LocalNx, LocalNy, LocalNz, autotune_repeats);
+    if (time < fastest_time) {
+      fastest_time = time;
+      fastest_schedule = schedule;
+    }
+  }
+  bout::setRuntimeSchedule(fastest_schedule);
+  output_info.write(_("\tUsing OpenMP schedule '{:s}'\n"), fastest_schedule);
 }
 
 void Mesh::recalculateStaggeredCoordinates() {
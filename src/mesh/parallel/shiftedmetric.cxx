@@ -9,6 +9,7 @@
 #include "bout/paralleltransform.hxx"
 #include <bout/constants.hxx>
 #include <bout/fft.hxx>
+#include <bout/index_derivs_interface.hxx>
 #include <bout/mesh.hxx>
 #include <bout/output.hxx>
 #include <bout/sys/timer.hxx>
@@ -164,10 +165,23 @@ Field3D ShiftedMetric::shiftZ(const Field3D& f, const Tensor<dcomplex>& phs,
 
   Field3D result{emptyFrom(f).setDirectionY(y_direction_out)};
 
-  BOUT_FOR(i, mesh.getRegion2D(toString(region))) {
-    shiftZ(&f(i, 0), &phs(i.x(), i.y(), 0), &result(i, 0));
+  // Transform all the points in the region at once
+  const auto& region2D = mesh.getRegion2D(toString(region));
+  Matrix<dcomplex> modes = bout::fft::rfft(f, region2D);
+
+  const auto& indices = region2D.getIndices();
+  const int npoints = static_cast<int>(indices.size());
+  BOUT_OMP(parallel for)
+  for (int n = 0; n < npoints; ++n) {
+    const int ix = indices[n].x();
+    const int iy = indices[n].y();
+    for (int jz = 1; jz < nmodes; ++jz) {
+      modes(n, jz) *= phs(ix, iy, jz);
+    }
   }
 
+  bout::fft::irfft(modes, region2D, result);
+
   return result;
 }
 
@@ -229,16 +243,10 @@ void ShiftedMetric::calcParallelSlices(Field3D& f) {
 
   f.splitParallelSlices();
 
-  for (const auto& phase : parallel_slice_phases) {
-    auto& f_slice = f.ynext(phase.y_offset);
-    f_slice.allocate();
-    BOUT_FOR(i, mesh.getRegion2D("RGN_NOY")) {
-      const int ix = i.x();
-      const int iy = i.y();
-      const int iy_offset = iy + phase.y_offset;
-      shiftZ(&(f(ix, iy_offset, 0)), &(phase.phase_shift(ix, iy, 0)),
-             &(f_slice(ix, iy_offset, 0)));
-    }
+  // Shift to all the slices at once, so that f is only transformed once
+  auto slices = shiftZ(f, parallel_slice_phases);
+  for (std::size_t i = 0; i < slices.size(); ++i) {
+    f.ynext(parallel_slice_phases[i].y_offset) = std::move(slices[i]);
   }
 }
 
@@ -252,18 +260,15 @@ ShiftedMetric::shiftZ(const Field3D& f,
   const int nmodes = mesh.LocalNz / 2 + 1;
 
   // FFT in Z of input field at each (x, y) point
-  Matrix<Array<dcomplex>> f_fft(mesh.LocalNx, mesh.LocalNy);
-  f_fft = Array<dcomplex>(nmodes);
-
-  BOUT_FOR(i, mesh.getRegion2D("RGN_ALL")) {
-    int ix = i.x();
-    int iy = i.y();
-    f_fft(ix, iy).ensureUnique();
-    rfft(&f(i, 0), mesh.LocalNz, f_fft(ix, iy).begin());
-  }
+  const int ncolumns = mesh.LocalNx * mesh.LocalNy;
+  const Matrix<dcomplex> f_fft = fftColumns(f);
 
   std::vector<Field3D> results{};
 
+  // Shifted modes, in the same layout as f_fft
+  Matrix<dcomplex> shifted(ncolumns, nmodes);
+  const int ny_noy = mesh.yend - mesh.ystart + 1;
+
   for (auto& phase : phases) {
     // In C++17 std::vector::emplace_back returns a reference, which
     // would be very useful here!
@@ -273,20 +278,119 @@ ShiftedMetric::shiftZ(const Field3D& f,
     current_result.setLocation(f.getLocation());
 
     BOUT_FOR(i, mesh.getRegion2D("RGN_NOY")) {
-      // Deep copy the FFT'd field
-      int ix = i.x();
-      int iy = i.y();
-
-      Array<dcomplex> shifted_temp(f_fft(ix, iy + phase.y_offset));
-      shifted_temp.ensureUnique();
+      const int ix = i.x();
+      const int iy = i.y();
+      const int column = i.ind;
+      const int offset_column = i.yp(phase.y_offset).ind;
 
+      shifted(column, 0) = f_fft(offset_column, 0);
       for (int jz = 1; jz < nmodes; ++jz) {
-        shifted_temp[jz] *= phase.phase_shift(ix, iy, jz);
+        shifted(column, jz) = f_fft(offset_column, jz) * phase.phase_shift(ix, iy, jz);
       }
+    }
 
-      irfft(shifted_temp.begin(), mesh.LocalNz, &current_result(i.yp(phase.y_offset), 0));
+    // The y points at each x are contiguous in both arrays, so can be
+    // transformed back in one batch
+    for (int ix = 0; ix < mesh.LocalNx; ++ix) {
+      bout::fft::irfft(&shifted(ix * mesh.LocalNy + mesh.ystart, 0), mesh.LocalNz,
+                       &current_result(ix, mesh.ystart + phase.y_offset, 0), ny_noy,
+                       nmodes, mesh.LocalNz);
     }
   }
 
   return results;
 }
+
+Matrix<dcomplex> ShiftedMetric::fftColumns(const Field3D& f) const {
+  // The columns are contiguous, so can be transformed in one batch
+  const int ncolumns = mesh.LocalNx * mesh.LocalNy;
+  Matrix<dcomplex> f_fft(ncolumns, nmodes);
+  bout::fft::rfft(&f(0, 0, 0), mesh.LocalNz, &f_fft(0, 0), ncolumns, mesh.LocalNz,
+                  nmodes);
+  return f_fft;
+}
+
+const Tensor<dcomplex>& ShiftedMetric::slicePhase(int y_offset) const {
+  ASSERT2(y_offset != 0 and std::abs(y_offset) <= mesh.ystart);
+  // See parallel_slice_phases for the order of the slices
+  const auto& slice = parallel_slice_phases[y_offset > 0 ? y_offset - 1
+                                                         : mesh.ystart - y_offset - 1];
+  ASSERT2(slice.y_offset == y_offset);
+  return slice.phase_shift;
+}
+
+bool ShiftedMetric::canFusedYDerivative(DERIV derivType, const std::string& method,
+                                        const std::string& region) const {
+  const auto weights =
+      bout::derivatives::index::centralDifferenceWeights(derivType, method);
+  if (weights.empty()) {
+    return false;
+  }
+  // Parallel slice phases are only calculated in RGN_NOY, and only
+  // for offsets up to the number of guard cells
+  const int width = static_cast<int>(weights.size()) / 2;
+  return width <= mesh.ystart and (region == "RGN_NOBNDRY" or region == "RGN_NOY");
+}
+
+Field3D ShiftedMetric::fusedYDerivative(const Field3D& f, DERIV derivType,
+                                        const std::string& method,
+                                        const std::string& region) {
+  ASSERT1(f.getMesh() == &mesh);
+  ASSERT1(f.getLocation() == location);
+  ASSERT1(f.getDirectionY() == YDirectionType::Standard);
+  ASSERT1(canFusedYDerivative(derivType, method, region));
+
+  // Shifting to field-aligned, differentiating and shifting back
+  // gives, for the modes of each point,
+  //
+  //     result(y) = fromAlignedPhs(y) * sum_i w_i toAlignedPhs(y + i) f(y + i)
+  //
+  // and fromAlignedPhs(y) * toAlignedPhs(y + i) is the parallel
+  // slice phase for offset i, so only one forward and one inverse
+  // FFT of each point are needed
+  const auto weights =
+      bout::derivatives::index::centralDifferenceWeights(derivType, method);
+  const int width = static_cast<int>(weights.size()) / 2;
+
+  const Matrix<dcomplex> f_fft = fftColumns(f);
+  Matrix<dcomplex> result_fft(mesh.LocalNx * mesh.LocalNy, nmodes);
+
+  BOUT_FOR(i, mesh.getRegion2D(region)) {
+    const int ix = i.x();
+    const int iy = i.y();
+    const int column = i.ind;
+
+    for (int jz = 0; jz < nmodes; ++jz) {
+      result_fft(column, jz) = weights[width] * f_fft(column, jz);
+    }
+
+    for (int offset = -width; offset <= width; ++offset) {
+      if (offset == 0) {
+        continue;
+      }
+      const BoutReal weight = weights[width + offset];
+      const auto& phase = slicePhase(offset);
+      const int offset_column = i.yp(offset).ind;
+
+      // The constant mode isn't shifted
+      result_fft(column, 0) += weight * f_fft(offset_column, 0);
+      for (int jz = 1; jz < nmodes; ++jz) {
+        result_fft(column, jz) += weight * phase(ix, iy, jz) * f_fft(offset_column, jz);
+      }
+    }
+  }
+
+  Field3D result{emptyFrom(f)};
+
+  // The y points at each x are contiguous, so can be transformed back
+  // in one batch
+  const int xs = (region == "RGN_NOBNDRY") ? mesh.xstart : 0;
+  const int xe = (region == "RGN_NOBNDRY") ? mesh.xend : mesh.LocalNx - 1;
+  for (int ix = xs; ix <= xe; ++ix) {
+    bout::fft::irfft(&result_fft(ix * mesh.LocalNy + mesh.ystart, 0), mesh.LocalNz,
+                     &result(ix, mesh.ystart, 0), mesh.yend - mesh.ystart + 1, nmodes,
+                     mesh.LocalNz);
+  }
+
+  return result;
+}
@@ -0,0 +1,85 @@
+#include "bout/region.hxx"
+#include "bout/boutexception.hxx"
+#include "bout/build_config.hxx"
+
+#include <algorithm>
+
+#include <unistd.h>
+
+#if BOUT_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+/// Used if the cache size can't be found
+constexpr std::size_t default_cache_size = 256 * 1024;
+
+/// Size in bytes of the level 2 cache
+std::size_t level2CacheSize() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  const long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  if (size > 0) {
+    return static_cast<std::size_t>(size);
+  }
+#endif
+  return default_cache_size;
+}
+} // namespace
+
+namespace bout {
+
+RegionTileShape defaultRegionTileShape(int nx, int ny, int nz, std::size_t cache_size) {
+  if (cache_size == 0) {
+    cache_size = level2CacheSize();
+  }
+
+  // Typical operations read a few fields and write one. Use half the
+  // cache for these, leaving the rest for everything else
+  constexpr int nfields = 4;
+  const int cache_points =
+      static_cast<int>(cache_size / (2 * nfields * sizeof(BoutReal)));
+
+  // An x stencil needs the previous and next rows in x while the
+  // current one is being done. y stencils only need neighbouring rows
+  // in z, which are much closer together, so the x rows determine the
+  // tile size
+  constexpr int rows = 3;
+  const int row_points = std::max(1, cache_points / rows);
+
+  RegionTileShape shape;
+  shape.x = std::max(1, nx);
+  shape.z = std::max(1, std::min(nz, row_points));
+  shape.y = std::max(1, std::min(ny, row_points / shape.z));
+  return shape;
+}
+
+std::vector<std::string> runtimeSchedules() {
+#if BOUT_USE_OPENMP
+  if (std::string(build::openmp_schedule) == "runtime") {
+    return {"static", "dynamic", "guided"};
+  }
+#endif
+  return {};
+}
+
+void setRuntimeSchedule(const std::string& schedule) {
+  const auto schedules = runtimeSchedules();
+  if (std::find(schedules.begin(), schedules.end(), schedule) == schedules.end()) {
+    throw BoutException("Can't set OpenMP schedule to '{:s}'. BOUT++ must be compiled "
+                        "with BOUT_OPENMP_SCHEDULE=runtime to choose the schedule at "
+                        "run time",
+                        schedule);
+  }
+#if BOUT_USE_OPENMP
+  // Zero chunk size uses the default for each schedule
+  if (schedule == "static") {
+    omp_set_schedule(omp_sched_static, 0);
+  } else if (schedule == "dynamic") {
+    omp_set_schedule(omp_sched_dynamic, 0);
+  } else {
+    omp_set_schedule(omp_sched_guided, 0);
+  }
+#endif
+}
+
+} // namespace bout
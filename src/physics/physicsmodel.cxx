@@ -79,14 +79,39 @@ PhysicsModel::PhysicsModel()
                           .doc("Add output data to existing (dump) files?")
                           .withDefault(false)
                       ? bout::OptionsNetCDF::FileMode::append
-                      : bout::OptionsNetCDF::FileMode::replace),
+                      : bout::OptionsNetCDF::FileMode::replace,
+                  bout::isOutputParallel(Options::root())),
       output_enabled(Options::root()["output"]["enabled"]
                          .doc("Write output files")
                          .withDefault(true)),
-      restart_file(bout::getRestartFilename(Options::root())),
+      restart_file(bout::getRestartFilename(Options::root()),
+                   bout::OptionsNetCDF::FileMode::replace,
+                   bout::isRestartParallel(Options::root())),
       restart_enabled(Options::root()["restart_files"]["enabled"]
                           .doc("Write restart files")
-                          .withDefault(true)) {}
+                          .withDefault(true)) {
+
+  auto& output_opts = Options::root()["output"];
+  if (output_opts["async"]
+          .doc("Write output and restart files in a background thread?")
+          .withDefault(false)) {
+    // MPI is not initialised with thread support, so collective
+    // netCDF calls can't be made from another thread
+    if (bout::isOutputParallel(Options::root())
+        or bout::isRestartParallel(Options::root())) {
+      throw BoutException("output:async can't be used with parallel output or restart "
+                          "files");
+    }
+    const int max_pending = output_opts["async_max_pending"]
+                                .doc("Maximum number of writes queued by output:async")
+                                .withDefault(2);
+    if (max_pending < 1) {
+      throw BoutException("output:async_max_pending must be at least 1, but got {:d}",
+                          max_pending);
+    }
+    async_writer = std::make_unique<bout::AsyncOptionsWriter>(max_pending);
+  }
+}
 
 void PhysicsModel::initialise(Solver* s) {
   if (initialised) {
@@ -187,7 +212,7 @@ int PhysicsModel::postInit(bool restarting) {
     restart_options["BOUT_VERSION"].force(bout::version::as_double, "PhysicsModel");
 
     // Write _everything_ to restart file
-    restart_file.write(restart_options);
+    writeRestartFile();
   }
 
   // Add monitor to the solver which calls restart.write() and
@@ -218,7 +243,12 @@ void PhysicsModel::restartVars(Options& options) {
 }
 
 void PhysicsModel::writeRestartFile() {
-  if (restart_enabled) {
+  if (not restart_enabled) {
+    return;
+  }
+  if (async_writer) {
+    async_writer->write(restart_file, restart_options);
+  } else {
     restart_file.write(restart_options);
   }
 }
@@ -226,24 +256,38 @@ void PhysicsModel::writeRestartFile() {
 void PhysicsModel::writeOutputFile() { writeOutputFile(output_options); }
 
 void PhysicsModel::writeOutputFile(const Options& options) {
-  if (output_enabled) {
-    output_file.write(options, "t");
-  }
+  writeOutputFile(options, "t");
 }
 
 void PhysicsModel::writeOutputFile(const Options& options,
                                    const std::string& time_dimension) {
-  if (output_enabled) {
+  if (not output_enabled) {
+    return;
+  }
+  if (async_writer) {
+    async_writer->write(output_file, options, time_dimension);
+  } else {
     output_file.write(options, time_dimension);
   }
 }
 
 void PhysicsModel::finishOutputTimestep() const {
-  if (output_enabled) {
+  if (not output_enabled) {
+    return;
+  }
+  if (async_writer) {
+    async_writer->verifyTimesteps(output_file);
+  } else {
     output_file.verifyTimesteps();
   }
 }
 
+void PhysicsModel::finishOutput() {
+  if (async_writer) {
+    async_writer->flush();
+  }
+}
+
 int PhysicsModel::PhysicsModelMonitor::call(Solver* solver, BoutReal simtime,
                                             int iteration, int nout) {
   // Restart file variables
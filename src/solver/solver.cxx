@@ -576,6 +576,9 @@ int Solver::solve(int nout, BoutReal timestep) {
   try {
     status = run();
 
+    // Make sure all output has been written
+    model->finishOutput();
+
     time_t end_time = time(nullptr);
     output_progress.write(_("\nRun finished at  : {:s}\n"), toString(end_time));
     output_progress.write(_("Run time : "));
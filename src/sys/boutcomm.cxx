@@ -27,8 +27,11 @@ void BoutComm::setComm(MPI_Comm c) {
 
 MPI_Comm& BoutComm::getComm() {
   if (comm == MPI_COMM_NULL) {
-    // No communicator set. Initialise MPI
-    MPI_Init(pargc, pargv);
+    // No communicator set. Initialise MPI. Some solvers make MPI calls
+    // from the master thread inside OpenMP parallel regions, so ask for
+    // that to be allowed. threadSupport() gives the level provided
+    int provided;
+    MPI_Init_thread(pargc, pargv, MPI_THREAD_FUNNELED, &provided);
 
     // Duplicate MPI_COMM_WORLD
     MPI_Comm_dup(MPI_COMM_WORLD, &comm);
@@ -46,6 +49,14 @@ void BoutComm::setArgs(int& c, char**& v) {
   getInstance()->pargv = &v;
 }
 
+int BoutComm::threadSupport() {
+  // Make sure MPI is initialised
+  get();
+  int provided;
+  MPI_Query_thread(&provided);
+  return provided;
+}
+
 int BoutComm::rank() {
   int MYPE;
   MPI_Comm_rank(get(), &MYPE);
@@ -154,6 +154,15 @@ Field3D D2DX2(const Field3D& f, CELL_LOC outloc, const std::string& method,
               const std::string& region) {
   Coordinates* coords = f.getCoordinates(outloc);
 
+  if (coords->non_uniform and (outloc == CELL_DEFAULT or outloc == f.getLocation())) {
+    // Both derivatives are needed, so calculate them together
+    Field3D d2fdx2, dfdx;
+    bout::derivatives::index::fusedDerivatives<Field3D, DIRECTION::X>(
+        f, {{DERIV::StandardSecond, &d2fdx2, nullptr, method}, {DERIV::Standard, &dfdx}},
+        region);
+    return d2fdx2 / SQ(coords->dx) + coords->d1_dx * dfdx / coords->dx;
+  }
+
   Field3D result =
       bout::derivatives::index::D2DX2(f, outloc, method, region) / SQ(coords->dx);
 
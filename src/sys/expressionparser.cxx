@@ -36,6 +36,7 @@ using std::stringstream;
 using namespace std::string_literals;
 
 using bout::generator::Context;
+using bout::generator::Program;
 
 // Note: Here rather than in header to avoid many deprecated warnings
 // Remove in future and make this function pure virtual
@@ -43,6 +44,10 @@ double FieldGenerator::generate(const Context& ctx) {
   return generate(ctx.x(), ctx.y(), ctx.z(), ctx.t());
 }
 
+int FieldGenerator::compile(Program& program) {
+  return program.fallback(*this);
+}
+
 /////////////////////////////////////////////
 namespace { // These classes only visible in this file
 
@@ -54,6 +59,7 @@ public:
     return std::make_shared<FieldX>();
   }
   double generate(const Context& ctx) override { return ctx.x(); }
+  int compile(Program& program) override { return program.input(Program::Input::x); }
   std::string str() const override { return "x"s; }
 };
 
@@ -63,6 +69,7 @@ public:
     return std::make_shared<FieldY>();
   }
   double generate(const Context& ctx) override { return ctx.y(); }
+  int compile(Program& program) override { return program.input(Program::Input::y); }
   std::string str() const override { return "y"s; }
 };
 
@@ -72,6 +79,7 @@ public:
     return std::make_shared<FieldZ>();
   }
   double generate(const Context& ctx) override { return ctx.z(); }
+  int compile(Program& program) override { return program.input(Program::Input::z); }
   std::string str() const override { return "z"; }
 };
 
@@ -81,6 +89,7 @@ public:
     return std::make_shared<FieldT>();
   }
   double generate(const Context& ctx) override { return ctx.t(); }
+  int compile(Program& program) override { return program.input(Program::Input::t); }
   std::string str() const override { return "t"s; }
 };
 
@@ -184,6 +193,19 @@ FieldGeneratorPtr FieldBinary::clone(const list<FieldGeneratorPtr> args) {
   return std::make_shared<FieldBinary>(args.front(), args.back(), op);
 }
 
+int FieldBinary::compile(Program& program) {
+  switch (op) {
+  case '+':
+  case '-':
+  case '*':
+  case '/':
+  case '^':
+    return program.binary(op, lhs->compile(program), rhs->compile(program));
+  }
+  // Unknown operator, so generate will throw an exception
+  return program.fallback(*this);
+}
+
 BoutReal FieldBinary::generate(const Context& ctx) {
   BoutReal lval = lhs->generate(ctx);
   BoutReal rval = rhs->generate(ctx);
@@ -0,0 +1,358 @@
+#include "bout/sys/generator_program.hxx"
+
+#include "bout/boutexception.hxx"
+#include "bout/openmpwrap.hxx"
+#include "bout/sys/expressionparser.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bout {
+namespace generator {
+
+constexpr int Program::batch_size;
+
+namespace {
+/// Apply \p func to each of the \p n values
+template <typename Function>
+void transform(int n, const BoutReal* a, BoutReal* out, Function func) {
+  for (int j = 0; j < n; ++j) {
+    out[j] = func(a[j]);
+  }
+}
+
+template <typename Function>
+void transform(int n, const BoutReal* a, const BoutReal* b, BoutReal* out,
+               Function func) {
+  for (int j = 0; j < n; ++j) {
+    out[j] = func(a[j], b[j]);
+  }
+}
+} // namespace
+
+Program::Program(FieldGeneratorPtr generator) : root(std::move(generator)) {
+  if (root == nullptr) {
+    throw BoutException("Can't compile a null generator");
+  }
+
+  result_register = root->compile(*this);
+
+  // Remove instructions which aren't needed for the result, such as
+  // the arguments of operations done at compile time. Arguments
+  // always come before the instructions which use them
+  std::vector<bool> live(instructions.size(), false);
+  live[result_register] = true;
+  for (int i = static_cast<int>(instructions.size()) - 1; i >= 0; --i) {
+    if (live[i]) {
+      for (int arg : {instructions[i].arg1, instructions[i].arg2, instructions[i].arg3}) {
+        if (arg >= 0) {
+          live[arg] = true;
+        }
+      }
+    }
+  }
+  std::vector<int> new_register(instructions.size(), -1);
+  std::vector<Instruction> used;
+  for (std::size_t i = 0; i < instructions.size(); ++i) {
+    if (live[i]) {
+      auto instruction = instructions[i];
+      for (int* arg : {&instruction.arg1, &instruction.arg2, &instruction.arg3}) {
+        if (*arg >= 0) {
+          *arg = new_register[*arg];
+        }
+      }
+      new_register[i] = static_cast<int>(used.size());
+      used.push_back(instruction);
+    }
+  }
+  instructions = std::move(used);
+  result_register = new_register[result_register];
+
+  // Time-independent values which are needed to calculate the
+  // time-dependent ones are saved, so that everything else
+  // independent of time can be skipped
+  std::vector<bool> needed(instructions.size(), false);
+  needed[result_register] = true;
+  for (const auto& instruction : instructions) {
+    if (instruction.time_dependent) {
+      for (int arg : {instruction.arg1, instruction.arg2, instruction.arg3}) {
+        if (arg >= 0) {
+          needed[arg] = true;
+        }
+      }
+    }
+  }
+  for (std::size_t i = 0; i < instructions.size(); ++i) {
+    auto& instruction = instructions[i];
+    if (needed[i] and not instruction.time_dependent and not isPrecalculated(i)) {
+      instruction.saved_index = static_cast<int>(saved_registers.size());
+      saved_registers.push_back(static_cast<int>(i));
+    }
+  }
+}
+
+int Program::add(Instruction instruction) {
+  instructions.push_back(instruction);
+  return static_cast<int>(instructions.size()) - 1;
+}
+
+int Program::constant(BoutReal value) {
+  Instruction instruction{Op::constant};
+  instruction.value = value;
+  return add(instruction);
+}
+
+int Program::input(Input which) {
+  switch (which) {
+  case Input::x:
+    return add(Instruction{Op::x});
+  case Input::y:
+    return add(Instruction{Op::y});
+  case Input::z:
+    return add(Instruction{Op::z});
+  case Input::t: {
+    Instruction instruction{Op::t};
+    instruction.time_dependent = true;
+    return add(instruction);
+  }
+  }
+  throw BoutException("Unknown input to generator program");
+}
+
+int Program::binary(char op, int lhs, int rhs) {
+  Instruction instruction{Op::add};
+  switch (op) {
+  case '+':
+    instruction.op = Op::add;
+    break;
+  case '-':
+    instruction.op = Op::subtract;
+    break;
+  case '*':
+    instruction.op = Op::multiply;
+    break;
+  case '/':
+    instruction.op = Op::divide;
+    break;
+  case '^':
+    instruction.op = Op::power;
+    break;
+  default:
+    throw BoutException("Unknown binary operator '{:c}' in generator program", op);
+  }
+
+  if (isConstant(lhs) and isConstant(rhs)) {
+    const BoutReal lval = instructions[lhs].value;
+    const BoutReal rval = instructions[rhs].value;
+    switch (instruction.op) {
+    case Op::add:
+      return constant(lval + rval);
+    case Op::subtract:
+      return constant(lval - rval);
+    case Op::multiply:
+      return constant(lval * rval);
+    case Op::divide:
+      return constant(lval / rval);
+    default:
+      return constant(pow(lval, rval));
+    }
+  }
+
+  instruction.arg1 = lhs;
+  instruction.arg2 = rhs;
+  instruction.time_dependent = timeDependent(lhs, rhs);
+  return add(instruction);
+}
+
+int Program::function(BoutReal (*func)(BoutReal), int arg) {
+  if (isConstant(arg)) {
+    return constant(func(instructions[arg].value));
+  }
+  Instruction instruction{Op::function1};
+  instruction.function1 = func;
+  instruction.arg1 = arg;
+  instruction.time_dependent = timeDependent(arg);
+  return add(instruction);
+}
+
+int Program::function(BoutReal (*func)(BoutReal, BoutReal), int arg1, int arg2) {
+  if (isConstant(arg1) and isConstant(arg2)) {
+    return constant(func(instructions[arg1].value, instructions[arg2].value));
+  }
+  Instruction instruction{Op::function2};
+  instruction.function2 = func;
+  instruction.arg1 = arg1;
+  instruction.arg2 = arg2;
+  instruction.time_dependent = timeDependent(arg1, arg2);
+  return add(instruction);
+}
+
+int Program::where(int test, int gt0, int lt0) {
+  if (isConstant(test)) {
+    // Only one branch is needed
+    return (instructions[test].value > 0.0) ? gt0 : lt0;
+  }
+  Instruction instruction{Op::where};
+  instruction.arg1 = test;
+  instruction.arg2 = gt0;
+  instruction.arg3 = lt0;
+  instruction.time_dependent = timeDependent(test) or timeDependent(gt0, lt0);
+  return add(instruction);
+}
+
+int Program::fallback(FieldGenerator& generator) {
+  Instruction instruction{Op::fallback};
+  instruction.generator = &generator;
+  instruction.time_dependent = true;
+  return add(instruction);
+}
+
+bool Program::isConstant() const { return isConstant(result_register); }
+
+bool Program::dependsOnTime() const { return timeDependent(result_register); }
+
+bool Program::usesContext() const {
+  return std::any_of(instructions.begin(), instructions.end(),
+                     [](const Instruction& instruction) {
+                       return instruction.op == Op::fallback;
+                     });
+}
+
+void Program::evaluate(int npoints, const BoutReal* x, const BoutReal* y,
+                       const BoutReal* z, BoutReal t, BoutReal* result,
+                       const ContextFunction& context, SavedValues* saved) const {
+  if (npoints <= 0) {
+    return;
+  }
+
+  if (isConstant()) {
+    std::fill(result, result + npoints, instructions[result_register].value);
+    return;
+  }
+
+  const bool use_saved = (saved != nullptr) and (saved->npoints == npoints);
+  if ((saved != nullptr) and not use_saved) {
+    saved->values.resize(saved_registers.size() * npoints);
+    saved->npoints = npoints;
+  }
+
+  const int nbatches = (npoints + batch_size - 1) / batch_size;
+  const int ninstructions = static_cast<int>(instructions.size());
+
+  BOUT_OMP(parallel if (nbatches > 1)) {
+    // Each register holds the values for one batch of points
+    std::vector<BoutReal> workspace(ninstructions * batch_size);
+    std::vector<const BoutReal*> registers(ninstructions, nullptr);
+
+    // Constants and time are the same for all batches
+    for (int i = 0; i < ninstructions; ++i) {
+      const auto& instruction = instructions[i];
+      BoutReal* out = &workspace[i * batch_size];
+      if (instruction.op == Op::constant) {
+        std::fill(out, out + batch_size, instruction.value);
+      } else if (instruction.op == Op::t) {
+        std::fill(out, out + batch_size, t);
+      }
+      registers[i] = out;
+    }
+
+    BOUT_OMP(for schedule(static))
+    for (int batch = 0; batch < nbatches; ++batch) {
+      const int start = batch * batch_size;
+      evaluateBatch(start, std::min(batch_size, npoints - start), x, y, z, result,
+                    context, saved, use_saved, workspace, registers);
+    }
+  }
+}
+
+void Program::evaluateBatch(int start, int n, const BoutReal* x, const BoutReal* y,
+                            const BoutReal* z, BoutReal* result,
+                            const ContextFunction& context, SavedValues* saved,
+                            bool use_saved, std::vector<BoutReal>& workspace,
+                            std::vector<const BoutReal*>& registers) const {
+  const int ninstructions = static_cast<int>(instructions.size());
+
+  for (int i = 0; i < ninstructions; ++i) {
+    const auto& instruction = instructions[i];
+    BoutReal* out = &workspace[i * batch_size];
+
+    if (use_saved and not instruction.time_dependent and not isPrecalculated(i)) {
+      // Time-independent values are either saved or not needed
+      if (instruction.saved_index >= 0) {
+        registers[i] = &saved->values[instruction.saved_index * saved->npoints + start];
+      }
+      continue;
+    }
+
+    const BoutReal* a = instruction.arg1 >= 0 ? registers[instruction.arg1] : nullptr;
+    const BoutReal* b = instruction.arg2 >= 0 ? registers[instruction.arg2] : nullptr;
+
+    switch (instruction.op) {
+    case Op::constant:
+    case Op::t:
+      break;
+    case Op::x:
+      registers[i] = x + start;
+      break;
+    case Op::y:
+      registers[i] = y + start;
+      break;
+    case Op::z:
+      registers[i] = z + start;
+      break;
+    case Op::add:
+      transform(n, a, b, out, [](BoutReal l, BoutReal r) { return l + r; });
+      registers[i] = out;
+      break;
+    case Op::subtract:
+      transform(n, a, b, out, [](BoutReal l, BoutReal r) { return l - r; });
+      registers[i] = out;
+      break;
+    case Op::multiply:
+      transform(n, a, b, out, [](BoutReal l, BoutReal r) { return l * r; });
+      registers[i] = out;
+      break;
+    case Op::divide:
+      transform(n, a, b, out, [](BoutReal l, BoutReal r) { return l / r; });
+      registers[i] = out;
+      break;
+    case Op::power:
+      transform(n, a, b, out, [](BoutReal l, BoutReal r) { return pow(l, r); });
+      registers[i] = out;
+      break;
+    case Op::function1:
+      transform(n, a, out, instruction.function1);
+      registers[i] = out;
+      break;
+    case Op::function2:
+      transform(n, a, b, out, instruction.function2);
+      registers[i] = out;
+      break;
+    case Op::where: {
+      const BoutReal* c = registers[instruction.arg3];
+      for (int j = 0; j < n; ++j) {
+        out[j] = (a[j] > 0.0) ? b[j] : c[j];
+      }
+      registers[i] = out;
+      break;
+    }
+    case Op::fallback:
+      for (int j = 0; j < n; ++j) {
+        out[j] = instruction.generator->generate(context(start + j));
+      }
+      registers[i] = out;
+      break;
+    }
+
+    if ((saved != nullptr) and (instruction.saved_index >= 0)) {
+      std::copy(registers[i], registers[i] + n,
+                &saved->values[instruction.saved_index * saved->npoints + start]);
+    }
+  }
+
+  std::copy(registers[result_register], registers[result_register] + n,
+            result + start);
+}
+
+} // namespace generator
+} // namespace bout
@@ -36,6 +36,9 @@
 
 #if BOUT_USE_MSGSTACK
 int MsgStack::push(std::string message) {
+  if (isForeignThread()) {
+    return position;
+  }
 
 #if BOUT_USE_OPENMP
   // This is temporary fix: no messages from OMP regions if there's
@@ -55,7 +58,7 @@ int MsgStack::push(std::string message) {
 }
 
 void MsgStack::pop() {
-  if (position <= 0) {
+  if (position <= 0 or isForeignThread()) {
     return;
   }
   BOUT_OMP(single)
@@ -68,6 +71,9 @@ void MsgStack::pop(int id) {
     return;
   }
 #endif
+  if (isForeignThread()) {
+    return;
+  }
   if (id < 0) {
     id = 0;
   }
@@ -78,6 +84,9 @@ void MsgStack::pop(int id) {
 }
 
 void MsgStack::clear() {
+  if (isForeignThread()) {
+    return;
+  }
   BOUT_OMP(single)
   {
     stack.clear();
@@ -85,6 +94,15 @@ void MsgStack::clear() {
   }
 }
 
+bool MsgStack::isForeignThread() const {
+#if BOUT_USE_OPENMP
+  if (omp_in_parallel()) {
+    return false;
+  }
+#endif
+  return std::this_thread::get_id() != owner;
+}
+
 void MsgStack::dump() {
   BOUT_OMP(single)
   { output << this->getDump(); }
@@ -92,6 +110,10 @@ void MsgStack::dump() {
 
 std::string MsgStack::getDump() {
   std::string res = "====== Back trace ======\n";
+  if (isForeignThread()) {
+    // The stack may be changing, so can't be read
+    return res;
+  }
   for (int i = position - 1; i >= 0; i--) {
     if (stack[i] != "") {
       res += " -> ";
@@ -0,0 +1,162 @@
+/**************************************************************************
+ * The parts of the global arrays in a parallel output file which
+ * belong to each processor
+ *
+ **************************************************************************
+ * Copyright 2023 BOUT++ contributors
+ *
+ * Contact: Ben Dudson, dudson2@llnl.gov
+ *
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+#ifndef BOUT_LOCAL_SLAB_H
+#define BOUT_LOCAL_SLAB_H
+
+#include "bout/boutexception.hxx"
+#include "bout/field2d.hxx"
+#include "bout/field3d.hxx"
+#include "bout/mesh.hxx"
+#include "bout/sys/range.hxx"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace bout {
+
+/// A rectangle of a processor's local (x, y) indices, and where it is
+/// in the global arrays of a parallel file. Ranges of local indices
+/// are inclusive, and may be empty
+struct SlabPart {
+  int xstart{0}, xend{-1}, ystart{0}, yend{-1};
+  /// Global indices of (xstart, ystart)
+  std::size_t xoffset{0}, yoffset{0};
+
+  std::size_t nx() const {
+    return xend < xstart ? 0 : static_cast<std::size_t>(xend - xstart + 1);
+  }
+  std::size_t ny() const {
+    return yend < ystart ? 0 : static_cast<std::size_t>(yend - ystart + 1);
+  }
+
+  /// Copy this part of \p field into a contiguous array
+  template <typename T>
+  std::vector<BoutReal> pack(const T& field) const {
+    const int nz = field.getNz();
+    std::vector<BoutReal> data;
+    data.reserve(nx() * ny() * nz);
+    for (int x = xstart; x <= xend; ++x) {
+      for (int y = ystart; y <= yend; ++y) {
+        for (int z = 0; z < nz; ++z) {
+          data.push_back(field(x, y, z));
+        }
+      }
+    }
+    return data;
+  }
+};
+
+template <>
+inline std::vector<BoutReal> SlabPart::pack<Field2D>(const Field2D& field) const {
+  std::vector<BoutReal> data;
+  data.reserve(nx() * ny());
+  for (int x = xstart; x <= xend; ++x) {
+    for (int y = ystart; y <= yend; ++y) {
+      data.push_back(field(x, y));
+    }
+  }
+  return data;
+}
+
+/// The part of the global arrays in a parallel file which belongs to
+/// this processor: the interior with any x boundary cells, and the
+/// cells in the lower and upper y boundaries.
+///
+/// A y boundary may only cover part of the x range, for example if
+/// the separatrix is on this processor. The y guard cells at the
+/// other x are not boundary cells, and their global indices may be
+/// another processor's boundary cells, so they are not included.
+///
+/// Every processor has all three parts, some of which may be empty,
+/// so that all processors make the same number of collective writes.
+///
+/// Values which aren't fields, such as scalars and strings, may be
+/// different on each processor, so are only written by the processor
+/// with \p write_values set
+struct LocalSlab {
+  explicit LocalSlab(Mesh* mesh, bool write_values = true)
+      : global_nx(mesh->GlobalNx), global_ny(mesh->GlobalNy),
+        write_values(write_values) {
+    const int xstart = mesh->firstX() ? 0 : mesh->xstart;
+    const int xend = mesh->lastX() ? mesh->LocalNx - 1 : mesh->xend;
+
+    const auto makePart = [&](std::pair<int, int> xrange, int ystart, int yend) {
+      SlabPart part{xrange.first, xrange.second, ystart, yend, 0, 0};
+      if (part.nx() > 0 and part.ny() > 0) {
+        part.xoffset = mesh->getGlobalXIndex(part.xstart);
+        part.yoffset = mesh->getGlobalYIndex(part.ystart);
+      }
+      return part;
+    };
+
+    // The x range of a y boundary. This includes the corner cells if
+    // the boundary reaches an x boundary
+    const auto boundaryX = [&](RangeIterator range) -> std::pair<int, int> {
+      int first = 0;
+      int last = -1;
+      int count = 0;
+      for (range.first(); !range.isDone(); range.next()) {
+        first = (count == 0) ? range.ind : std::min(first, range.ind);
+        last = std::max(last, range.ind);
+        ++count;
+      }
+      if (count == 0) {
+        return {0, -1};
+      }
+      if (count != last - first + 1) {
+        throw BoutException("Parallel files need each y boundary on a processor to be "
+                            "a single range in x");
+      }
+      if (first == mesh->xstart) {
+        first = xstart;
+      }
+      if (last == mesh->xend) {
+        last = xend;
+      }
+      return {std::max(first, xstart), std::min(last, xend)};
+    };
+
+    parts[0] = makePart({xstart, xend}, mesh->ystart, mesh->yend);
+    parts[1] = makePart(boundaryX(mesh->iterateBndryLowerY()), 0, mesh->ystart - 1);
+    parts[2] = makePart(boundaryX(mesh->iterateBndryUpperY()), mesh->yend + 1,
+                        mesh->LocalNy - 1);
+  }
+
+  /// The interior, then the lower and upper y boundary cells
+  std::array<SlabPart, 3> parts;
+  /// Size of the global arrays
+  int global_nx, global_ny;
+  /// Does this processor write the values which aren't fields?
+  bool write_values;
+};
+
+} // namespace bout
+
+#endif // BOUT_LOCAL_SLAB_H
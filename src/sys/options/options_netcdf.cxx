@@ -5,18 +5,70 @@
 #include "bout/options_netcdf.hxx"
 
 #include "bout/bout.hxx"
+#include "bout/boutcomm.hxx"
 #include "bout/globals.hxx"
 #include "bout/mesh.hxx"
 #include "bout/sys/timer.hxx"
+#include "local_slab.hxx"
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
+#include <map>
 #include <netcdf>
+#include <netcdf_meta.h>
+#include <type_traits>
 #include <vector>
 
+#if NC_HAS_PARALLEL4
+#include <netcdf_par.h>
+#endif
+
 using namespace netCDF;
 
 namespace {
+/// A netCDF-4 file opened by all the processors in BoutComm for
+/// parallel I/O. The netCDF-C++ library can't do this itself, but once
+/// open the file can be used like any other NcFile
+class ParallelNcFile : public NcFile {
+public:
+  ParallelNcFile(const std::string& filename, NcFile::FileMode mode) {
+#if NC_HAS_PARALLEL4
+    int status = NC_NOERR;
+    switch (mode) {
+    case NcFile::read:
+      status = nc_open_par(filename.c_str(), NC_NOWRITE, BoutComm::get(), MPI_INFO_NULL,
+                           &myId);
+      break;
+    case NcFile::write:
+      status = nc_open_par(filename.c_str(), NC_WRITE, BoutComm::get(), MPI_INFO_NULL,
+                           &myId);
+      break;
+    case NcFile::replace:
+      status = nc_create_par(filename.c_str(), NC_NETCDF4 | NC_CLOBBER, BoutComm::get(),
+                             MPI_INFO_NULL, &myId);
+      break;
+    case NcFile::newFile:
+      status = nc_create_par(filename.c_str(), NC_NETCDF4 | NC_NOCLOBBER,
+                             BoutComm::get(), MPI_INFO_NULL, &myId);
+      break;
+    }
+    if (status != NC_NOERR) {
+      throw BoutException("Could not open NetCDF file '{:s}' for parallel I/O: {:s}",
+                          filename, nc_strerror(status));
+    }
+    nullObject = false;
+#else
+    throw BoutException("Can't open '{:s}' for parallel I/O: the NetCDF library was not "
+                        "built with parallel support",
+                        filename);
+#endif
+  }
+};
+
+using bout::LocalSlab;
+using bout::SlabPart;
+
 /// Name of the attribute used to track individual variable's time indices
 constexpr auto current_time_index_name = "current_time_index";
 
@@ -56,7 +108,112 @@ T readAttribute(const NcAtt& attribute) {
   return value;
 }
 
-void readGroup(const std::string& filename, const NcGroup& group, Options& result) {
+/// Is \p dims a field's dimensions in a parallel file, i.e. {"x", "y"}
+/// for a Field2D or {"x", "y", "z"} for a Field3D?
+bool isFieldDims(const std::vector<NcDim>& dims, const LocalSlab& slab) {
+  return (dims.size() == 2 or dims.size() == 3) and dims[0].getName() == "x"
+         and dims[0].getSize() == static_cast<std::size_t>(slab.global_nx)
+         and dims[1].getName() == "y"
+         and dims[1].getSize() == static_cast<std::size_t>(slab.global_ny)
+         and (dims.size() == 2 or dims[2].getName() == "z");
+}
+
+/// Read one part of this processor's slab of a field from a parallel
+/// file, in the order of the global array
+std::vector<double> readPart(const NcVar& var, const SlabPart& part) {
+  const auto dims = var.getDims();
+
+  std::vector<std::size_t> start{part.xoffset, part.yoffset};
+  std::vector<std::size_t> count{part.nx(), part.ny()};
+  if (dims.size() == 3) {
+    start.push_back(0);
+    count.push_back(dims[2].getSize());
+  }
+
+  const auto size = part.nx() * part.ny() * (dims.size() == 3 ? count[2] : 1);
+  // Empty parts are still read, in case access to the variable is
+  // collective, and netCDF needs a valid pointer
+  std::vector<double> data(std::max(size, std::size_t{1}));
+  var.getVar(start, count, data.data());
+  data.resize(size);
+  return data;
+}
+
+/// Read this processor's part of a 2D field from a parallel file into a
+/// Matrix the size of the local mesh. Guard cells which aren't boundary
+/// cells are set to zero
+Matrix<double> readSlab2D(const NcVar& var, const LocalSlab& slab, Mesh* mesh) {
+  Matrix<double> value(mesh->LocalNx, mesh->LocalNy);
+  value = 0.0;
+
+  for (const auto& part : slab.parts) {
+    const auto data = readPart(var, part);
+    auto it = std::begin(data);
+    for (int x = part.xstart; x <= part.xend; ++x) {
+      for (int y = part.ystart; y <= part.yend; ++y) {
+        value(x, y) = *it++;
+      }
+    }
+  }
+  return value;
+}
+
+/// Read this processor's part of a 3D field from a parallel file into a
+/// Tensor the size of the local mesh. Guard cells which aren't boundary
+/// cells are set to zero
+Tensor<double> readSlab3D(const NcVar& var, const LocalSlab& slab, Mesh* mesh) {
+  const auto nz = static_cast<int>(var.getDim(2).getSize());
+
+  Tensor<double> value(mesh->LocalNx, mesh->LocalNy, nz);
+  value = 0.0;
+
+  for (const auto& part : slab.parts) {
+    const auto data = readPart(var, part);
+    auto it = std::begin(data);
+    for (int x = part.xstart; x <= part.xend; ++x) {
+      for (int y = part.ystart; y <= part.yend; ++y) {
+        for (int z = 0; z < nz; ++z) {
+          value(x, y, z) = *it++;
+        }
+      }
+    }
+  }
+  return value;
+}
+
+/// Read the attributes of \p var into \p result, and set the
+/// "source" attribute to \p filename
+void readAttributes(const std::string& filename, const NcVar& var, Options& result) {
+  result.attributes["source"] = filename;
+
+  for (const auto& attpair : var.getAtts()) {
+    const auto& att_name = attpair.first; // Attribute name
+    const auto& att = attpair.second;     // NcVarAtt object
+
+    auto att_type = att.getType(); // Type of the attribute
+
+    if (att_type == ncInt) {
+      result.attributes[att_name] = readAttribute<int>(att);
+    } else if (att_type == ncFloat) {
+      result.attributes[att_name] = readAttribute<float>(att);
+    } else if (att_type == ncDouble) {
+      result.attributes[att_name] = readAttribute<double>(att);
+    } else if ((att_type == ncString) or (att_type == ncChar)) {
+      std::string value;
+      att.getValues(value);
+      result.attributes[att_name] = value;
+    }
+    // Else ignore
+  }
+}
+
+/// Read all the variables and groups in \p group into \p result. If
+/// \p slab isn't null, this is a parallel file, and only this
+/// processor's part of fields is read. The values of variables with
+/// more than \p max_dims dimensions are not read, only their attributes
+void readGroup(const std::string& filename, const NcGroup& group, Options& result,
+               const LocalSlab* slab = nullptr, Mesh* mesh = nullptr,
+               int max_dims = 3) {
 
   // Iterate over all variables
   for (const auto& varpair : group.getVars()) {
@@ -67,6 +224,11 @@ void readGroup(const std::string& filename, const NcGroup& group, Options& resul
     auto ndims = var.getDimCount(); // Number of dimensions
     auto dims = var.getDims();      // Vector of dimensions
 
+    if (ndims > max_dims) {
+      readAttributes(filename, var, result[var_name]);
+      continue;
+    }
+
     switch (ndims) {
     case 0: {
       // Scalar variables
@@ -92,12 +254,19 @@ void readGroup(const std::string& filename, const NcGroup& group, Options& resul
         std::string value;
         value.resize(dims[0].getSize());
         var.getVar(&(value[0]));
+        if (var_type == ncChar) {
+          // Remove any padding from strings in parallel files
+          value.erase(value.find_last_not_of('\0') + 1);
+        }
         result[var_name] = value;
       }
       break;
     }
     case 2: {
-      if (var_type == ncDouble or var_type == ncFloat) {
+      if ((var_type == ncDouble or var_type == ncFloat) and slab != nullptr
+          and isFieldDims(dims, *slab)) {
+        result[var_name] = readSlab2D(var, *slab, mesh);
+      } else if (var_type == ncDouble or var_type == ncFloat) {
         Matrix<double> value(static_cast<int>(dims[0].getSize()),
                              static_cast<int>(dims[1].getSize()));
         var.getVar(value.begin());
@@ -106,7 +275,10 @@ void readGroup(const std::string& filename, const NcGroup& group, Options& resul
       break;
     }
     case 3: {
-      if (var_type == ncDouble or var_type == ncFloat) {
+      if ((var_type == ncDouble or var_type == ncFloat) and slab != nullptr
+          and isFieldDims(dims, *slab)) {
+        result[var_name] = readSlab3D(var, *slab, mesh);
+      } else if (var_type == ncDouble or var_type == ncFloat) {
         Tensor<double> value(static_cast<int>(dims[0].getSize()),
                              static_cast<int>(dims[1].getSize()),
                              static_cast<int>(dims[2].getSize()));
@@ -115,28 +287,7 @@ void readGroup(const std::string& filename, const NcGroup& group, Options& resul
       }
     }
     }
-    result[var_name].attributes["source"] = filename;
-
-    // Get variable attributes
-    for (const auto& attpair : var.getAtts()) {
-      const auto& att_name = attpair.first; // Attribute name
-      const auto& att = attpair.second;     // NcVarAtt object
-
-      auto att_type = att.getType(); // Type of the attribute
-
-      if (att_type == ncInt) {
-        result[var_name].attributes[att_name] = readAttribute<int>(att);
-      } else if (att_type == ncFloat) {
-        result[var_name].attributes[att_name] = readAttribute<float>(att);
-      } else if (att_type == ncDouble) {
-        result[var_name].attributes[att_name] = readAttribute<double>(att);
-      } else if ((att_type == ncString) or (att_type == ncChar)) {
-        std::string value;
-        att.getValues(value);
-        result[var_name].attributes[att_name] = value;
-      }
-      // Else ignore
-    }
+    readAttributes(filename, var, result[var_name]);
   }
 
   // Iterate over groups
@@ -144,7 +295,7 @@ void readGroup(const std::string& filename, const NcGroup& group, Options& resul
     const auto& name = grouppair.first;
     const auto& subgroup = grouppair.second;
 
-    readGroup(filename, subgroup, result[name]);
+    readGroup(filename, subgroup, result[name], slab, mesh, max_dims);
   }
 }
 } // namespace
@@ -154,6 +305,16 @@ namespace bout {
 Options OptionsNetCDF::read() {
   Timer timer("io");
 
+  Options result;
+
+  if (parallel) {
+    // Every processor reads its own part of the fields
+    const ParallelNcFile read_file(filename, NcFile::read);
+    const LocalSlab slab(bout::globals::mesh);
+    readGroup(filename, read_file, result, &slab, bout::globals::mesh);
+    return result;
+  }
+
   // Open file
   const NcFile read_file(filename, NcFile::read);
 
@@ -161,12 +322,97 @@ Options OptionsNetCDF::read() {
     throw BoutException("Could not open NetCDF file '{:s}' for reading", filename);
   }
 
-  Options result;
   readGroup(filename, read_file, result);
 
   return result;
 }
 
+netCDF::NcFile& OptionsNetCDF::getReadFile() {
+  if (not read_file) {
+    if (parallel) {
+      read_file = std::make_unique<ParallelNcFile>(filename, NcFile::read);
+    } else {
+      read_file = std::make_unique<NcFile>(filename, NcFile::read);
+    }
+  }
+  if (read_file->isNull()) {
+    throw BoutException("Could not open NetCDF file '{:s}' for reading", filename);
+  }
+  return *read_file;
+}
+
+Options OptionsNetCDF::readMetadata() {
+  Timer timer("io");
+
+  Options result;
+  readGroup(filename, getReadFile(), result, nullptr, nullptr, 1);
+  return result;
+}
+
+std::map<std::string, std::vector<int>> OptionsNetCDF::variableShapes() {
+  Timer timer("io");
+
+  std::map<std::string, std::vector<int>> result;
+  for (const auto& varpair : getReadFile().getVars()) {
+    std::vector<int> shape;
+    for (const auto& dim : varpair.second.getDims()) {
+      shape.push_back(static_cast<int>(dim.getSize()));
+    }
+    result[varpair.first] = shape;
+  }
+  return result;
+}
+
+Options OptionsNetCDF::readSlab(const std::string& name, const std::vector<int>& start,
+                                const std::vector<int>& count) {
+  Timer timer("io");
+
+  const auto var = getReadFile().getVar(name);
+  if (var.isNull()) {
+    throw BoutException("Variable '{:s}' not found in NetCDF file '{:s}'", name,
+                        filename);
+  }
+
+  const auto ndims = static_cast<std::size_t>(var.getDimCount());
+  if (start.size() != ndims or count.size() != ndims) {
+    throw BoutException("Reading '{:s}' from '{:s}': expected {:d} dimensions, got start "
+                        "with {:d} and count with {:d}",
+                        name, filename, ndims, start.size(), count.size());
+  }
+
+  const std::vector<std::size_t> nc_start(start.begin(), start.end());
+  const std::vector<std::size_t> nc_count(count.begin(), count.end());
+
+  Options result;
+  switch (ndims) {
+  case 1: {
+    Array<double> value(count[0]);
+    var.getVar(nc_start, nc_count, value.begin());
+    result = value;
+    break;
+  }
+  case 2: {
+    Matrix<double> value(count[0], count[1]);
+    var.getVar(nc_start, nc_count, value.begin());
+    result = value;
+    break;
+  }
+  case 3: {
+    Tensor<double> value(count[0], count[1], count[2]);
+    var.getVar(nc_start, nc_count, value.begin());
+    result = value;
+    break;
+  }
+  default:
+    throw BoutException("Can only read part of a 1D, 2D or 3D variable, but '{:s}' in "
+                        "'{:s}' has {:d} dimensions",
+                        name, filename, ndims);
+  }
+
+  readAttributes(filename, var, result);
+  return result;
+}
+
 } // namespace bout
 
 namespace {
@@ -221,9 +467,11 @@ NcType NcTypeVisitor::operator()<FieldPerp>(const FieldPerp& UNUSED(t)) {
   return operator()<BoutReal>(0.0);
 }
 
-/// Visit a variant type, returning dimensions
+/// Visit a variant type, returning dimensions. If \p slab isn't null,
+/// fields use the dimensions of the global arrays in a parallel file
 struct NcDimVisitor {
-  NcDimVisitor(NcGroup& group) : group(group) {}
+  NcDimVisitor(NcGroup& group, const LocalSlab* slab = nullptr)
+      : group(group), slab(slab) {}
   template <typename T>
   std::vector<NcDim> operator()(const T& UNUSED(value)) {
     return {};
@@ -231,6 +479,7 @@ struct NcDimVisitor {
 
 private:
   NcGroup& group;
+  const LocalSlab* slab;
 };
 
 NcDim findDimension(NcGroup& group, const std::string& name, unsigned int size) {
@@ -259,12 +508,27 @@ NcDim findDimension(NcGroup& group, const std::string& name, unsigned int size)
   }
 }
 
+/// Strings in parallel files are written as arrays of characters, as
+/// variable-length types can't be written in parallel
+template <>
+std::vector<NcDim> NcDimVisitor::operator()<std::string>(const std::string& value) {
+  if (slab == nullptr) {
+    return {};
+  }
+  // The length is the same on every processor, see padParallelString
+  const auto length = value.size();
+  auto chardim = findDimension(group, fmt::format("char{}", length), length);
+  ASSERT0(!chardim.isNull());
+
+  return {chardim};
+}
+
 template <>
 std::vector<NcDim> NcDimVisitor::operator()<Field2D>(const Field2D& value) {
-  auto xdim = findDimension(group, "x", value.getNx());
+  auto xdim = findDimension(group, "x", slab ? slab->global_nx : value.getNx());
   ASSERT0(!xdim.isNull());
 
-  auto ydim = findDimension(group, "y", value.getNy());
+  auto ydim = findDimension(group, "y", slab ? slab->global_ny : value.getNy());
   ASSERT0(!ydim.isNull());
 
   return {xdim, ydim};
@@ -272,10 +536,10 @@ std::vector<NcDim> NcDimVisitor::operator()<Field2D>(const Field2D& value) {
 
 template <>
 std::vector<NcDim> NcDimVisitor::operator()<Field3D>(const Field3D& value) {
-  auto xdim = findDimension(group, "x", value.getNx());
+  auto xdim = findDimension(group, "x", slab ? slab->global_nx : value.getNx());
   ASSERT0(!xdim.isNull());
 
-  auto ydim = findDimension(group, "y", value.getNy());
+  auto ydim = findDimension(group, "y", slab ? slab->global_ny : value.getNy());
   ASSERT0(!ydim.isNull());
 
   auto zdim = findDimension(group, "z", value.getNz());
@@ -286,6 +550,10 @@ std::vector<NcDim> NcDimVisitor::operator()<Field3D>(const Field3D& value) {
 
 template <>
 std::vector<NcDim> NcDimVisitor::operator()<FieldPerp>(const FieldPerp& value) {
+  if (slab != nullptr) {
+    throw BoutException("FieldPerp can't be written to a parallel file");
+  }
+
   auto xdim = findDimension(group, "x", value.getNx());
   ASSERT0(!xdim.isNull());
 
@@ -295,9 +563,37 @@ std::vector<NcDim> NcDimVisitor::operator()<FieldPerp>(const FieldPerp& value) {
   return {xdim, zdim};
 }
 
-/// Visit a variant type, and put the data into a NcVar
+/// Write this processor's slab of \p field to a parallel file. Any
+/// leading (time) index is given by \p leading_start and
+/// \p leading_count. Every part is written, even if it is empty, as
+/// the writes are collective
+template <typename T>
+void putSlab(NcVar& var, const LocalSlab& slab, const T& field,
+             const std::vector<std::size_t>& leading_start = {},
+             const std::vector<std::size_t>& leading_count = {}) {
+  for (const auto& part : slab.parts) {
+    auto start = leading_start;
+    auto count = leading_count;
+    start.insert(start.end(), {part.xoffset, part.yoffset});
+    count.insert(count.end(), {part.nx(), part.ny()});
+    if (std::is_same<T, Field3D>::value) {
+      start.push_back(0);
+      count.push_back(static_cast<std::size_t>(field.getNz()));
+    }
+
+    auto data = part.pack(field);
+    if (data.empty()) {
+      // Nothing is written, but netCDF still needs a valid pointer
+      data.push_back(0.0);
+    }
+    var.putVar(start, count, data.data());
+  }
+}
+
+/// Visit a variant type, and put the data into a NcVar. If \p slab
+/// isn't null, only this processor's part of fields is written
 struct NcPutVarVisitor {
-  NcPutVarVisitor(NcVar& var) : var(var) {}
+  NcPutVarVisitor(NcVar& var, const LocalSlab* slab = nullptr) : var(var), slab(slab) {}
   template <typename T>
   void operator()(const T& value) {
     var.putVar(&value);
@@ -305,6 +601,7 @@ struct NcPutVarVisitor {
 
 private:
   NcVar& var;
+  const LocalSlab* slab;
 };
 
 template <>
@@ -316,12 +613,21 @@ void NcPutVarVisitor::operator()<bool>(const bool& value) {
 template <>
 void NcPutVarVisitor::operator()<std::string>(const std::string& value) {
   const char* cstr = value.c_str();
+  if (slab != nullptr) {
+    // Array of characters
+    var.putVar(cstr);
+    return;
+  }
   var.putVar(&cstr);
 }
 
 /// In addition to writing the data, set the "cell_location" attribute
 template <>
 void NcPutVarVisitor::operator()<Field2D>(const Field2D& value) {
+  if (slab != nullptr) {
+    putSlab(var, *slab, value);
+    return;
+  }
   // Pointer to data. Assumed to be contiguous array
   var.putVar(&value(0, 0));
 }
@@ -329,6 +635,10 @@ void NcPutVarVisitor::operator()<Field2D>(const Field2D& value) {
 /// In addition to writing the data, set the "cell_location" attribute
 template <>
 void NcPutVarVisitor::operator()<Field3D>(const Field3D& value) {
+  if (slab != nullptr) {
+    putSlab(var, *slab, value);
+    return;
+  }
   // Pointer to data. Assumed to be contiguous array
   var.putVar(&value(0, 0, 0));
 }
@@ -342,8 +652,9 @@ void NcPutVarVisitor::operator()<FieldPerp>(const FieldPerp& value) {
 /// Visit a variant type, and put the data into a NcVar
 struct NcPutVarCountVisitor {
   NcPutVarCountVisitor(NcVar& var, const std::vector<size_t>& start,
-                       const std::vector<size_t>& count)
-      : var(var), start(start), count(count) {}
+                       const std::vector<size_t>& count,
+                       const LocalSlab* slab = nullptr)
+      : var(var), start(start), count(count), slab(slab) {}
   template <typename T>
   void operator()(const T& value) {
     var.putVar(start, &value);
@@ -353,20 +664,34 @@ private:
   NcVar& var;
   const std::vector<size_t>& start; ///< Starting (corner) index
   const std::vector<size_t>& count; ///< Index count in each dimension
+  const LocalSlab* slab;            ///< This processor's part of a parallel file
 };
 
 template <>
 void NcPutVarCountVisitor::operator()<std::string>(const std::string& value) {
   const char* cstr = value.c_str();
+  if (slab != nullptr) {
+    // Array of characters
+    var.putVar(start, count, cstr);
+    return;
+  }
   var.putVar(start, &cstr);
 }
 template <>
 void NcPutVarCountVisitor::operator()<Field2D>(const Field2D& value) {
+  if (slab != nullptr) {
+    putSlab(var, *slab, value, {start[0]}, {1});
+    return;
+  }
   // Pointer to data. Assumed to be contiguous array
   var.putVar(start, count, &value(0, 0));
 }
 template <>
 void NcPutVarCountVisitor::operator()<Field3D>(const Field3D& value) {
+  if (slab != nullptr) {
+    putSlab(var, *slab, value, {start[0]}, {1});
+    return;
+  }
   // Pointer to data. Assumed to be contiguous array
   var.putVar(start, count, &value(0, 0, 0));
 }
@@ -412,8 +737,38 @@ void NcPutAttVisitor::operator()(const std::string& value) {
   var.putAtt(name, value);
 }
 
-void writeGroup(const Options& options, NcGroup group,
-                const std::string& time_dimension) {
+/// Strings in parallel files are arrays of characters, and the
+/// dimensions and variables of a parallel file must be defined with
+/// the same sizes on every processor. Returns \p value padded with
+/// null characters to the length of the string being written, or of
+/// \p var if it already exists, which is the same on every processor
+std::string padParallelString(std::string value, const NcVar& var,
+                              const LocalSlab& slab) {
+  // Only the processor writing the value knows its length
+  unsigned long local_length = slab.write_values ? value.size() : 0;
+  unsigned long length = 0;
+  MPI_Allreduce(&local_length, &length, 1, MPI_UNSIGNED_LONG, MPI_MAX, BoutComm::get());
+
+  // If the variable has another type, the error is reported when it is written
+  if (not var.isNull() and var.getType() == ncChar and var.getDimCount() > 0) {
+    const auto var_length = var.getDims().back().getSize();
+    if (length > var_length) {
+      throw BoutException("String is longer than the {:d} characters of the existing "
+                          "variable in a parallel file",
+                          var_length);
+    }
+    length = var_length;
+  }
+
+  // Zero length would be an unlimited dimension
+  value.resize(std::max(length, 1UL), '\0');
+  return value;
+}
+
+/// Write \p options into \p group. If \p slab isn't null, this is a
+/// parallel file, and each processor writes its part of the fields
+void writeGroup(const Options& options, NcGroup group, const std::string& time_dimension,
+                const LocalSlab* slab = nullptr) {
 
   for (const auto& childpair : options.getChildren()) {
     const auto& name = childpair.first;
@@ -421,14 +776,24 @@ void writeGroup(const Options& options, NcGroup group,
 
     if (child.isValue()) {
       try {
-        auto nctype = bout::utils::visit(NcTypeVisitor(), child.value);
+        const Options::ValueType* value = &child.value;
+
+        auto nctype = bout::utils::visit(NcTypeVisitor(), *value);
 
         if (nctype.isNull()) {
           continue; // Skip this value
         }
 
+        Options::ValueType padded_string;
+        if (slab != nullptr and bout::utils::holds_alternative<std::string>(*value)) {
+          nctype = ncChar;
+          padded_string = padParallelString(bout::utils::get<std::string>(*value),
+                                            group.getVar(name), *slab);
+          value = &padded_string;
+        }
+
         // Get spatial dimensions
-        auto spatial_dims = bout::utils::visit(NcDimVisitor(group), child.value);
+        auto spatial_dims = bout::utils::visit(NcDimVisitor(group, slab), *value);
 
         // Vector of all dimensions, including time
         std::vector<NcDim> dims{spatial_dims};
@@ -510,13 +875,33 @@ void writeGroup(const Options& options, NcGroup group,
           }
         }
 
+        // In a parallel file, each processor writes its part of the
+        // fields, but only one writes other values, as they may be
+        // different on each processor
+        const bool is_field = bout::utils::holds_alternative<Field2D>(*value)
+                              or bout::utils::holds_alternative<Field3D>(*value);
+        const bool write_value = slab == nullptr or is_field or slab->write_values;
+
+#if NC_HAS_PARALLEL4
+        if (slab != nullptr) {
+          // Time-evolving variables are written by all processors, which
+          // is needed to extend unlimited dimensions. Other values are
+          // written by one processor
+          nc_var_par_access(group.getId(), var.getId(),
+                            (is_field or !time_dim.isNull()) ? NC_COLLECTIVE
+                                                             : NC_INDEPENDENT);
+        }
+#endif
+
         // Write the variable
 
         if (time_dim.isNull()) {
           // No time index
 
           // Put the data into the variable
-          bout::utils::visit(NcPutVarVisitor(var), child.value);
+          if (write_value) {
+            bout::utils::visit(NcPutVarVisitor(var, slab), *value);
+          }
 
         } else {
           // Has a time index, so need the record index
@@ -536,8 +921,15 @@ void writeGroup(const Options& options, NcGroup group,
           count_index[0] = 1; // Writing one record
 
           // Put the data into the variable
-          bout::utils::visit(NcPutVarCountVisitor(var, start_index, count_index),
-                             child.value);
+          if (write_value) {
+            bout::utils::visit(NcPutVarCountVisitor(var, start_index, count_index, slab),
+                               *value);
+          } else {
+            // Take part in the collective write, without writing anything
+            const std::vector<size_t> no_count(dims.size(), 0);
+            const double no_data = 0.0;
+            var.putVar(start_index, no_count, static_cast<const void*>(&no_data));
+          }
 
           // We've just written a new time slice, so we need to update
           // the attribute to track it
@@ -567,7 +959,7 @@ void writeGroup(const Options& options, NcGroup group,
         subgroup = group.addGroup(name);
       }
 
-      writeGroup(child, subgroup, time_dimension);
+      writeGroup(child, subgroup, time_dimension, slab);
     }
   }
 }
@@ -645,16 +1037,24 @@ namespace bout {
 
 OptionsNetCDF::OptionsNetCDF() : data_file(nullptr) {}
 
-OptionsNetCDF::OptionsNetCDF(std::string filename, FileMode mode)
-    : filename(std::move(filename)), file_mode(mode), data_file(nullptr) {}
+OptionsNetCDF::OptionsNetCDF(std::string filename, FileMode mode, bool parallel)
+    : filename(std::move(filename)), file_mode(mode), parallel(parallel),
+      data_file(nullptr) {}
 
 OptionsNetCDF::~OptionsNetCDF() = default;
 OptionsNetCDF::OptionsNetCDF(OptionsNetCDF&&) noexcept = default;
 OptionsNetCDF& OptionsNetCDF::operator=(OptionsNetCDF&&) noexcept = default;
 
 void OptionsNetCDF::verifyTimesteps() const {
-  NcFile dataFile(filename, NcFile::read);
-  auto errors = ::verifyTimesteps(dataFile);
+  std::vector<TimeDimensionError> errors;
+  if (parallel) {
+    // Opening a parallel file is collective, so use it if it's already open
+    errors = data_file ? ::verifyTimesteps(*data_file)
+                       : ::verifyTimesteps(ParallelNcFile(filename, NcFile::read));
+  } else {
+    NcFile dataFile(filename, NcFile::read);
+    errors = ::verifyTimesteps(dataFile);
+  }
 
   if (errors.empty()) {
     // No errors
@@ -675,6 +1075,10 @@ void OptionsNetCDF::verifyTimesteps() const {
 /// Write options to file
 void OptionsNetCDF::write(const Options& options, const std::string& time_dim) {
   Timer timer("io");
+  writeData(options, time_dim);
+}
+
+void OptionsNetCDF::writeData(const Options& options, const std::string& time_dim) {
 
   // Check the file mode to use
   auto ncmode = NcFile::replace;
@@ -687,14 +1091,23 @@ void OptionsNetCDF::write(const Options& options, const std::string& time_dim) {
   }
 
   if (not data_file) {
-    data_file = std::make_unique<netCDF::NcFile>(filename, ncmode);
+    if (parallel) {
+      data_file = std::make_unique<ParallelNcFile>(filename, ncmode);
+    } else {
+      data_file = std::make_unique<netCDF::NcFile>(filename, ncmode);
+    }
   }
 
   if (data_file->isNull()) {
     throw BoutException("Could not open NetCDF file '{:s}' for writing", filename);
   }
 
-  writeGroup(options, *data_file, time_dim);
+  if (parallel) {
+    const LocalSlab slab(bout::globals::mesh, BoutComm::rank() == 0);
+    writeGroup(options, *data_file, time_dim, &slab);
+  } else {
+    writeGroup(options, *data_file, time_dim);
+  }
 
   data_file->sync();
 }
@@ -708,7 +1121,16 @@ std::string getRestartDirectoryName(Options& options) {
   return options["datadir"].withDefault<std::string>("data");
 }
 
+bool isRestartParallel(Options& options) {
+  return options["restart_files"]["parallel"]
+      .doc("Write a single restart file shared by all processors?")
+      .withDefault(false);
+}
+
 std::string getRestartFilename(Options& options) {
+  if (isRestartParallel(options)) {
+    return fmt::format("{}/BOUT.restart.nc", bout::getRestartDirectoryName(options));
+  }
   return getRestartFilename(options, BoutComm::rank());
 }
 
@@ -717,7 +1139,17 @@ std::string getRestartFilename(Options& options, int rank) {
                      rank);
 }
 
+bool isOutputParallel(Options& options) {
+  return options["output"]["parallel"]
+      .doc("Write a single output file shared by all processors?")
+      .withDefault(false);
+}
+
 std::string getOutputFilename(Options& options) {
+  if (isOutputParallel(options)) {
+    return fmt::format("{}/BOUT.dmp.nc",
+                       options["datadir"].withDefault<std::string>("data"));
+  }
   return getOutputFilename(options, BoutComm::rank());
 }
 
@@ -731,7 +1163,9 @@ void writeDefaultOutputFile() { writeDefaultOutputFile(Options::root()); }
 void writeDefaultOutputFile(Options& options) {
   bout::experimental::addBuildFlagsToOptions(options);
   bout::globals::mesh->outputVars(options);
-  OptionsNetCDF(getOutputFilename(Options::root())).write(options);
+  OptionsNetCDF(getOutputFilename(Options::root()), OptionsNetCDF::FileMode::replace,
+                isOutputParallel(Options::root()))
+      .write(options);
 }
 
 } // namespace bout
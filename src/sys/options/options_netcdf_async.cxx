@@ -0,0 +1,156 @@
+#include "bout/options_netcdf_async.hxx"
+
+#include "bout/array.hxx"
+#include "bout/boutexception.hxx"
+#include "bout/field.hxx"
+#include "bout/field2d.hxx"
+#include "bout/field3d.hxx"
+#include "bout/fieldperp.hxx"
+#include "bout/output.hxx"
+#include "bout/sys/timer.hxx"
+#include "bout/utils.hxx"
+
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace {
+/// Copy an `Options` value, ensuring that fields and arrays don't
+/// share data with the original
+struct DeepCopyVisitor {
+  template <typename T>
+  Options::ValueType operator()(const T& value) {
+    return value;
+  }
+  Options::ValueType operator()(const Field2D& value) { return copy(value); }
+  Options::ValueType operator()(const Field3D& value) { return copy(value); }
+  Options::ValueType operator()(const FieldPerp& value) { return copy(value); }
+  Options::ValueType operator()(const Array<BoutReal>& value) { return copy(value); }
+  Options::ValueType operator()(const Matrix<BoutReal>& value) {
+    auto result = value;
+    result.ensureUnique();
+    return result;
+  }
+  Options::ValueType operator()(const Tensor<BoutReal>& value) {
+    auto result = value;
+    result.ensureUnique();
+    return result;
+  }
+};
+
+void deepCopyValues(Options& options) {
+  if (options.isValue()) {
+    options.value = bout::utils::visit(DeepCopyVisitor{}, options.value);
+    return;
+  }
+  for (const auto& child : options.getChildren()) {
+    deepCopyValues(options[child.first]);
+  }
+}
+} // namespace
+
+namespace bout {
+
+Options deepCopy(const Options& options) {
+  Options result = options;
+  deepCopyValues(result);
+  return result;
+}
+
+AsyncOptionsWriter::AsyncOptionsWriter(std::size_t max_pending)
+    : max_pending(max_pending == 0 ? 1 : max_pending),
+      worker(&AsyncOptionsWriter::run, this) {}
+
+AsyncOptionsWriter::~AsyncOptionsWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  task_added.notify_all();
+  worker.join();
+
+  if (failed) {
+    output_error.write("Error writing output in background thread: {:s}\n", error);
+  }
+}
+
+void AsyncOptionsWriter::write(OptionsNetCDF& file, const Options& options,
+                               const std::string& time_dim) {
+  Timer timer("io");
+  auto snapshot = std::make_unique<Options>(deepCopy(options));
+  const Options* data = snapshot.get();
+  enqueue({[&file, data, time_dim]() { file.writeData(*data, time_dim); },
+           std::move(snapshot)});
+}
+
+void AsyncOptionsWriter::verifyTimesteps(const OptionsNetCDF& file) {
+  enqueue({[&file]() { file.verifyTimesteps(); }, nullptr});
+}
+
+void AsyncOptionsWriter::flush() {
+  Timer timer("io");
+  std::unique_lock<std::mutex> lock(mutex);
+  task_done.wait(lock, [this] { return tasks.empty(); });
+  collect();
+}
+
+std::size_t AsyncOptionsWriter::pending() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return tasks.size();
+}
+
+void AsyncOptionsWriter::enqueue(Task task) {
+  std::unique_lock<std::mutex> lock(mutex);
+  task_done.wait(lock, [this] { return tasks.size() < max_pending; });
+  collect();
+  tasks.push_back(std::move(task));
+  lock.unlock();
+  task_added.notify_one();
+}
+
+void AsyncOptionsWriter::collect() {
+  finished.clear();
+  if (failed) {
+    failed = false;
+    throw BoutException(std::exchange(error, {}));
+  }
+}
+
+void AsyncOptionsWriter::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    task_added.wait(lock, [this] { return stopping or not tasks.empty(); });
+    if (tasks.empty()) {
+      return;
+    }
+    // References to deque elements stay valid when other elements
+    // are added at the back, so the task can be used without the lock
+    Task& task = tasks.front();
+    lock.unlock();
+
+    // Keep only the message of any error. The main thread throws a
+    // new exception, so no exception is shared between threads
+    bool task_failed = false;
+    std::string task_error;
+    try {
+      task.operation();
+    } catch (const std::exception& e) {
+      task_failed = true;
+      task_error = e.what();
+    } catch (...) {
+      task_failed = true;
+      task_error = "Unknown error";
+    }
+
+    lock.lock();
+    if (task_failed and not failed) {
+      failed = true;
+      error = std::move(task_error);
+    }
+    finished.push_back(std::move(task.options));
+    tasks.pop_front();
+    task_done.notify_all();
+  }
+}
+
+} // namespace bout
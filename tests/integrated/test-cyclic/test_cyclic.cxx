@@ -9,6 +9,8 @@
 #include <bout/cyclic_reduction.hxx>
 #include <bout/dcomplex.hxx>
 
+#include <vector>
+
 // Change this to dcomplex to test complex matrix inversion
 using T = BoutReal;
 
@@ -29,9 +31,6 @@ int main(int argc, char** argv) {
   bool periodic;
   OPTION(options, periodic, false);
 
-  // Create a cyclic reduction object, operating on Ts
-  auto* cr = new CyclicReduce<T>(BoutComm::get(), n);
-
   int mype, npe;
   MPI_Comm_rank(BoutComm::get(), &mype);
   MPI_Comm_size(BoutComm::get(), &npe);
@@ -74,33 +73,52 @@ int main(int argc, char** argv) {
       T xp = ((pe * n) % 4) - 2.;
       rhs(s, i) = a(s, i) * x(s, i - 1) + b(s, i) * x(s, i) + c(s, i) * xp;
     }
-
-    // Zero x, so that solve has to do something
-
-    for (int i = 0; i < n; i++) {
-      x(s, i) = 0.0;
-    }
   }
 
-  // Solve system
-
-  cr->setPeriodic(periodic);
-  cr->setCoefs(a, b, c);
-  cr->solve(rhs, x);
-
-  // Destroy solver
-  delete cr;
+  // Solve the system with and without pipelining. Each solver is used
+  // twice: the second solve reuses the factorisation from the first,
+  // with a different RHS. The pipelined results are also compared
+  // with the ones which aren't pipelined
+  int passed = 1;
+  std::vector<Matrix<T>> unpipelined_x;
+  for (const bool pipelined : {false, true}) {
+    CyclicReduce<T> cr(BoutComm::get(), n);
+    cr.setPeriodic(periodic);
+    cr.setPipelined(pipelined);
+    cr.setCoefs(a, b, c);
+
+    for (const int solve : {0, 1}) {
+      const BoutReal factor = (solve == 0) ? 1. : -3.;
+      Matrix<T> scaled_rhs(nsys, n);
+      for (int s = 0; s < nsys; s++) {
+        for (int i = 0; i < n; i++) {
+          scaled_rhs(s, i) = factor * rhs(s, i);
+          // Zero x, so that solve has to do something
+          x(s, i) = 0.0;
+        }
+      }
 
-  // Check result
+      output << (pipelined ? "Pipelined" : "Not pipelined")
+             << (cr.isFactorised() ? ", reusing factorisation" : "") << endl;
+      cr.solve(scaled_rhs, x);
+
+      // Check result
+      for (int s = 0; s < nsys; s++) {
+        output << "System " << s << endl;
+        for (int i = 0; i < n; i++) {
+          T val = factor * (((mype * n + i) % 4) - 2.);
+          output << "\t" << i << " : " << val << " ?= " << x(s, i) << endl;
+          if (std::abs(val - x(s, i)) > tol) {
+            passed = 0;
+          }
+          if (pipelined and std::abs(unpipelined_x[solve](s, i) - x(s, i)) > tol) {
+            passed = 0;
+          }
+        }
+      }
 
-  int passed = 1;
-  for (int s = 0; s < nsys; s++) {
-    output << "System " << s << endl;
-    for (int i = 0; i < n; i++) {
-      T val = ((mype * n + i) % 4) - 2.;
-      output << "\t" << i << " : " << val << " ?= " << x(s, i) << endl;
-      if (std::abs(val - x(s, i)) > tol) {
-        passed = 0;
+      if (not pipelined) {
+        unpipelined_x.push_back(x);
       }
     }
   }
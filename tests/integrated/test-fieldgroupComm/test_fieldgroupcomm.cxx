@@ -1,18 +1,29 @@
 #include <bout/physicsmodel.hxx>
 
 class TestFieldGroupComm : public PhysicsModel {
+public:
+  ~TestFieldGroupComm() override {
+    if (plan4 != nullptr) {
+      mesh->freeCommPlan(plan4);
+    }
+  }
+
 protected:
   int init(bool UNUSED(restarting)) {
     //Create identical fields
     solver->add(fld1, "fld1");
     solver->add(fld2, "fld2");
     solver->add(fld3, "fld3");
+    solver->add(fld4, "fld4");
 
     //Create different communicators
     comm1.add(fld1);
     comm2.add(fld2, fld2);
     comm3.add(fld3);
 
+    // Communication plan, reused every RHS call
+    plan4 = mesh->createCommPlan(fld4);
+
     return 0;
   }
 
@@ -25,16 +36,20 @@ protected:
     //3. Twice with single entry
     mesh->communicate(comm3);
     mesh->communicate(comm3);
+    //4. Persistent communication plan
+    mesh->communicate(plan4);
 
     ddt(fld1) = Grad_par(fld1);
     ddt(fld2) = Grad_par(fld2);
     ddt(fld3) = Grad_par(fld3);
+    ddt(fld4) = Grad_par(fld4);
     return 0;
   }
 
 private:
-  Field3D fld1, fld2, fld3;
+  Field3D fld1, fld2, fld3, fld4;
   FieldGroup comm1, comm2, comm3;
+  comm_handle plan4{nullptr};
 };
 
 BOUTMAIN(TestFieldGroupComm);
@@ -0,0 +1,78 @@
+/*
+ * Test that the PCR and PCR-Thomas Laplacian solvers give the same
+ * result with several OpenMP threads as with a single thread, and
+ * the same result as the cyclic solver.
+ *
+ * These solvers make MPI calls inside OpenMP parallel regions, from
+ * the master thread only, if MPI provides MPI_THREAD_FUNNELED
+ */
+
+#include <bout/bout.hxx>
+#include <bout/boutcomm.hxx>
+#include <bout/field_factory.hxx>
+#include <bout/invert_laplace.hxx>
+
+#if BOUT_USE_OPENMP
+#include <omp.h>
+#endif
+
+#include <string>
+
+int main(int argc, char** argv) {
+  BoutInitialise(argc, argv);
+
+  using bout::globals::mesh;
+  Options& root = Options::root();
+
+  const Field2D a = FieldFactory::get()->create2D("a:function", &root, mesh);
+  const Field2D c = FieldFactory::get()->create2D("c:function", &root, mesh);
+  const Field2D d = FieldFactory::get()->create2D("d:function", &root, mesh);
+  const Field3D rhs = FieldFactory::get()->create3D("rhs:function", &root, mesh);
+
+  output << "MPI thread support: "
+         << (BoutComm::threadSupport() >= MPI_THREAD_FUNNELED ? "funneled" : "single")
+         << endl;
+
+  auto cyclic = Laplacian::create(&root["cyclic"]);
+  cyclic->setCoefA(a);
+  cyclic->setCoefC(c);
+  cyclic->setCoefD(d);
+  const Field3D expected = cyclic->solve(rhs);
+
+  bool passed = true;
+  for (const std::string type : {"pcr", "pcr_thomas"}) {
+    auto solver = Laplacian::create(&root[type]);
+    solver->setCoefA(a);
+    solver->setCoefC(c);
+    solver->setCoefD(d);
+
+    const Field3D threaded = solver->solve(rhs);
+
+#if BOUT_USE_OPENMP
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    const Field3D serial = solver->solve(rhs);
+#if BOUT_USE_OPENMP
+    omp_set_num_threads(nthreads);
+#endif
+
+    // The arithmetic is the same for any number of threads
+    const BoutReal difference = max(abs(threaded - serial, "RGN_NOY"), true, "RGN_NOY");
+    output << type << ": maximum difference " << difference << endl;
+    if (difference > 0.0) {
+      passed = false;
+    }
+
+    const BoutReal error = max(abs(threaded - expected, "RGN_NOY"), true, "RGN_NOY");
+    output << type << ": maximum difference from cyclic " << error << endl;
+    if (error > 1e-10) {
+      passed = false;
+    }
+  }
+
+  output << "******* PCR threads test case: " << (passed ? "PASSED" : "FAILED") << endl;
+
+  BoutFinalise();
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+#include "bout/bout.hxx"
+
+#include "bout/boutcomm.hxx"
+#include "bout/options_netcdf.hxx"
+
+#include <netcdf_meta.h>
+
+#include <cmath>
+#include <string>
+
+using bout::OptionsNetCDF;
+
+namespace {
+/// Value of the test fields at global index (x, y, z), so that it is
+/// the same on every processor
+BoutReal globalValue(int x, int y, int z = 0) { return x + 100. * y + 10000. * z; }
+} // namespace
+
+int main(int argc, char** argv) {
+  BoutInitialise(argc, argv);
+
+#if NC_HAS_PARALLEL4
+  Mesh* mesh = bout::globals::mesh;
+  const int rank = BoutComm::rank();
+
+  Field2D f2d{mesh};
+  f2d.allocate();
+  for (const auto& i : f2d.getRegion("RGN_ALL")) {
+    f2d[i] = globalValue(mesh->getGlobalXIndex(i.x()), mesh->getGlobalYIndex(i.y()));
+  }
+
+  Field3D f3d{mesh};
+  f3d.allocate();
+  for (const auto& i : f3d.getRegion("RGN_ALL")) {
+    f3d[i] =
+        globalValue(mesh->getGlobalXIndex(i.x()), mesh->getGlobalYIndex(i.y()), i.z());
+  }
+
+  Options data;
+  data["f2d"] = f2d;
+  data["f3d"] = f3d;
+  data["int"] = 42;
+  data["string"] = "hello";
+  // Different on each processor, so only processor 0's values are written
+  data["rank"] = rank;
+  data["rank_string"] = std::string(rank + 1, 'x');
+  data["t_rank"] = static_cast<BoutReal>(rank);
+  data["t_rank"].attributes["time_dimension"] = "t";
+
+  data["t_scalar"] = 1.0;
+  data["t_scalar"].attributes["time_dimension"] = "t";
+  data["t_field"] = f3d;
+  data["t_field"].attributes["time_dimension"] = "t";
+
+  const std::string filename = "data/parallel.nc";
+  OptionsNetCDF(filename, OptionsNetCDF::FileMode::replace, true).write(data);
+
+  // Append a second time point, with a shorter string
+  data["string"] = "hi";
+  data["t_scalar"] = 2.0;
+  data["t_field"] = 2. * f3d;
+  OptionsNetCDF(filename, OptionsNetCDF::FileMode::append, true).write(data);
+
+  // Read back in, each processor reading its own part of the fields
+  Options result = OptionsNetCDF(filename, OptionsNetCDF::FileMode::append, true).read();
+
+  int passed = 1;
+  const auto check = [&passed](bool ok, const std::string& what) {
+    if (not ok) {
+      output << "Wrong " << what << endl;
+      passed = 0;
+    }
+  };
+
+  check(result["int"].as<int>() == 42, "int");
+  check(result["string"].as<std::string>() == "hi", "string");
+  check(result["rank"].as<int>() == 0, "rank");
+  check(result["rank_string"].as<std::string>() == "x", "rank_string");
+
+  const auto t_rank = result["t_rank"].as<Array<BoutReal>>();
+  check(t_rank.size() == 2 and t_rank[0] == 0. and t_rank[1] == 0., "t_rank");
+
+  const auto t_scalar = result["t_scalar"].as<Array<BoutReal>>();
+  check(t_scalar.size() == 2 and t_scalar[0] == 1. and t_scalar[1] == 2., "t_scalar");
+
+  const auto f2d_in = result["f2d"].as<Field2D>(mesh);
+  for (const auto& i : f2d.getRegion("RGN_NOBNDRY")) {
+    check(std::abs(f2d_in[i] - f2d[i]) < 1e-10, "f2d");
+  }
+
+  const auto f3d_in = result["f3d"].as<Field3D>(mesh);
+  for (const auto& i : f3d.getRegion("RGN_NOBNDRY")) {
+    check(std::abs(f3d_in[i] - f3d[i]) < 1e-10, "f3d");
+  }
+
+  int allpassed;
+  MPI_Allreduce(&passed, &allpassed, 1, MPI_INT, MPI_MIN, BoutComm::get());
+
+  output << "******* Parallel netCDF test case: ";
+  if (allpassed) {
+    output << "PASSED" << endl;
+  } else {
+    output << "FAILED" << endl;
+  }
+
+  BoutFinalise();
+  return allpassed ? 0 : 1;
+#else
+  output << "netCDF doesn't support parallel I/O, skipping test" << endl;
+
+  BoutFinalise();
+  return 0;
+#endif
+}
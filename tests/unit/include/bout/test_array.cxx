@@ -153,6 +153,20 @@ TEST_F(ArrayTest, Reallocate) {
   EXPECT_DOUBLE_EQ(a[5], 25);
 }
 
+TEST_F(ArrayTest, ReallocateNewMemory) {
+  Array<double> a{};
+
+  // No data of this size in the store yet
+  EXPECT_TRUE(a.reallocate(47));
+
+  // Released data is reused
+  a.clear();
+  Array<double> b{};
+  if (Array<double>::useStore()) {
+    EXPECT_FALSE(b.reallocate(47));
+  }
+}
+
 TEST_F(ArrayTest, MakeUnique) {
   Array<double> a(20);
 
@@ -251,3 +265,56 @@ TEST_F(ArrayTest, OutOfBoundsThrow) {
   EXPECT_THROW(a[-1] = 1.0, BoutException);
 }
 #endif
+
+TEST_F(ArrayTest, StoreStats) {
+  const auto before = Array<double>::storeStats();
+
+  {
+    Array<double> a(40);
+  }
+  // Reuses the data released by a
+  Array<double> b(40);
+
+  const auto after = Array<double>::storeStats();
+  if (Array<double>::useStore()) {
+    EXPECT_EQ(after.misses - before.misses, 1U);
+    EXPECT_EQ(after.hits - before.hits, 1U);
+    EXPECT_EQ(after.bytes_held, before.bytes_held);
+    EXPECT_GE(after.peak_bytes_held, 40 * sizeof(double));
+  }
+}
+
+TEST_F(ArrayTest, StoreLimit) {
+  Array<double>::setStoreLimit(45 * sizeof(double));
+  EXPECT_EQ(Array<double>::getStoreLimit(), 45 * sizeof(double));
+
+  const auto before = Array<double>::storeStats();
+  {
+    // Too large to fit in the store
+    Array<double> a(50);
+  }
+  const auto too_large = Array<double>::storeStats();
+  if (Array<double>::useStore()) {
+    EXPECT_EQ(too_large.evictions - before.evictions, 1U);
+  }
+
+  {
+    Array<double> a(42);
+  }
+  const auto fits = Array<double>::storeStats();
+  if (Array<double>::useStore()) {
+    EXPECT_LE(fits.bytes_held, 45 * sizeof(double));
+  }
+
+  {
+    // Replaces the data of size 42
+    Array<double> a(43);
+  }
+  const auto replaced = Array<double>::storeStats();
+  if (Array<double>::useStore()) {
+    EXPECT_GT(replaced.evictions, fits.evictions);
+    EXPECT_LE(replaced.bytes_held, 45 * sizeof(double));
+  }
+
+  Array<double>::setStoreLimit(0);
+}
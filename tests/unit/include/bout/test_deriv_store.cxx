@@ -4,6 +4,7 @@
 #include <bout/boutexception.hxx>
 #include <bout/deriv_store.hxx>
 #include <bout/output.hxx>
+#include <bout/stencils.hxx>
 #include <bout/unused.hxx>
 
 #include <typeindex>
@@ -332,3 +333,55 @@ TEST_F(DerivativeStoreTest, GetStandardFromFlowDerivative) {
       store.getFlowDerivative("bad type", DIRECTION::X, STAGGER::None, DERIV::Standard),
       BoutException);
 }
+
+namespace {
+BoutReal stencilReturnThree(const stencil& UNUSED(f)) { return 3.0; }
+} // namespace
+
+TEST_F(DerivativeStoreTest, RegisterStencilKernel) {
+  DerivativeStore<FieldType>::StencilKernel kernel;
+  kernel.standard = &stencilReturnThree;
+  kernel.nGuards = 1;
+  store.registerStencilKernel(kernel, DERIV::StandardSecond, DIRECTION::X, "FirstOrder");
+
+  const auto result =
+      store.getStencilKernel("FirstOrder", DIRECTION::X, DERIV::StandardSecond);
+  EXPECT_TRUE(result.isValid());
+  EXPECT_EQ(result.standard, &stencilReturnThree);
+  EXPECT_EQ(result.upwind, nullptr);
+  EXPECT_EQ(result.nGuards, 1);
+
+  // Kernels are specific to the type and direction
+  EXPECT_FALSE(store.getStencilKernel("FirstOrder", DIRECTION::X, DERIV::Standard)
+                   .isValid());
+  EXPECT_FALSE(store.getStencilKernel("FirstOrder", DIRECTION::Z, DERIV::StandardSecond)
+                   .isValid());
+
+  EXPECT_THROW(store.registerStencilKernel(kernel, DERIV::StandardSecond, DIRECTION::X,
+                                           "FirstOrder"),
+               BoutException);
+}
+
+TEST_F(DerivativeStoreTest, RegisterFusedPair) {
+  const auto pair = [](const FieldType& UNUSED(inp), FieldType& second, FieldType& first,
+                       const std::string& UNUSED(region)) {
+    second.resize(10, 1.0);
+    first.resize(6, 2.0);
+  };
+  store.registerFusedPair(pair, DIRECTION::X, "SecondOrder", "FirstOrder");
+
+  const auto result = store.getFusedPair("SecondOrder", "FirstOrder", DIRECTION::X);
+  ASSERT_TRUE(result);
+
+  FieldType inp, second, first;
+  result(inp, second, first, "RGN_ALL");
+  EXPECT_EQ(second.size(), 10);
+  EXPECT_EQ(first.size(), 6);
+
+  // Pairs are specific to the order of the methods and the direction
+  EXPECT_FALSE(store.getFusedPair("FirstOrder", "SecondOrder", DIRECTION::X));
+  EXPECT_FALSE(store.getFusedPair("SecondOrder", "FirstOrder", DIRECTION::Z));
+
+  EXPECT_THROW(store.registerFusedPair(pair, DIRECTION::X, "SecondOrder", "FirstOrder"),
+               BoutException);
+}
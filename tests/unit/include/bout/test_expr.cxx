@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx"
+
+#include "bout/array.hxx"
+#include "bout/expr.hxx"
+#include "bout/field2d.hxx"
+#include "bout/field3d.hxx"
+
+#include <random>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+using bout::expr::lazy;
+
+// Reuse the "standard" fixture for FakeMesh
+using ExprTest = FakeMeshFixture;
+
+namespace {
+template <class FieldType>
+FieldType random_field(std::default_random_engine& re) {
+  std::uniform_real_distribution<double> unif(1.0, 2.0);
+  FieldType result;
+  result.allocate();
+  BOUT_FOR(i, result.getRegion("RGN_ALL")) { result[i] = unif(re); }
+  return result;
+}
+} // namespace
+
+TEST_F(ExprTest, Field3DArithmetic) {
+  std::default_random_engine re;
+  const auto a = random_field<Field3D>(re);
+  const auto b = random_field<Field3D>(re);
+  const auto c = random_field<Field3D>(re);
+  const auto d = random_field<Field3D>(re);
+  const auto e = random_field<Field3D>(re);
+  const auto f = random_field<Field3D>(re);
+
+  const Field3D expected = a * b + c * d - e / f;
+  const Field3D actual = bout::expr::eval(lazy(a) * b + lazy(c) * d - lazy(e) / f);
+
+  EXPECT_TRUE(IsFieldEqual(actual, expected));
+}
+
+TEST_F(ExprTest, Fused) {
+  std::default_random_engine re;
+  const auto a = random_field<Field3D>(re);
+  const auto b = random_field<Field3D>(re);
+  const auto c = random_field<Field3D>(re);
+  const auto d = random_field<Field3D>(re);
+  const auto e = random_field<Field3D>(re);
+  const auto f = random_field<Field2D>(re);
+
+  // Count the blocks of field data taken from the store or newly
+  // allocated
+  const auto allocations = []() {
+    const auto stats = Array<BoutReal>::storeStats();
+    return stats.hits + stats.misses;
+  };
+
+  // The eager operators allocate a temporary for each operation
+  const auto before_eager = allocations();
+  const Field3D expected = a * b + c * d - e / f;
+  EXPECT_EQ(allocations() - before_eager, 5);
+
+  // Only the result is allocated if the expression is fused
+  const auto before = allocations();
+  const Field3D actual = bout::expr::eval(lazy(a) * b + lazy(c) * d - lazy(e) / f);
+  EXPECT_EQ(allocations() - before, 1);
+
+  EXPECT_TRUE(IsFieldEqual(actual, expected));
+}
+
+TEST_F(ExprTest, MixedArithmetic) {
+  std::default_random_engine re;
+  const auto a = random_field<Field3D>(re);
+  const auto b = random_field<Field2D>(re);
+  const auto c = random_field<Field3D>(re);
+
+  const Field3D expected = 2.0 * a + b * c - b / 3.0 - (a / b);
+  const Field3D actual =
+      bout::expr::eval(2.0 * lazy(a) + lazy(b) * c - lazy(b) / 3.0 - lazy(a) / b);
+
+  EXPECT_TRUE(IsFieldEqual(actual, expected));
+}
+
+TEST_F(ExprTest, Field2DResult) {
+  std::default_random_engine re;
+  const auto a = random_field<Field2D>(re);
+  const auto b = random_field<Field2D>(re);
+
+  const Field2D expected = -a * b + 1.0;
+  const Field2D actual = bout::expr::eval(-lazy(a) * b + 1.0);
+
+  EXPECT_TRUE(IsFieldEqual(actual, expected));
+}
+
+TEST_F(ExprTest, AssignRegion) {
+  std::default_random_engine re;
+  const auto a = random_field<Field3D>(re);
+  const auto b = random_field<Field2D>(re);
+
+  Field3D result{0.0};
+  bout::expr::assign(result, lazy(a) * b, "RGN_NOBNDRY");
+
+  EXPECT_TRUE(IsFieldEqual(result, a * b, "RGN_NOBNDRY"));
+  EXPECT_TRUE(IsFieldEqual(result, 0.0, "RGN_XGUARDS"));
+}
+
+TEST_F(ExprTest, AssignAliased) {
+  std::default_random_engine re;
+  Field3D a = random_field<Field3D>(re);
+  const auto b = random_field<Field3D>(re);
+
+  // Another field shares a's data, which should not be modified
+  const Field3D copy = a;
+  const Field3D expected = a * b + a;
+
+  bout::expr::assign(a, lazy(a) * b + a);
+
+  EXPECT_TRUE(IsFieldEqual(a, expected));
+  EXPECT_FALSE(IsFieldEqual(copy, expected));
+}
+
+TEST_F(ExprTest, IncompatibleLocations) {
+  Field3D a(mesh_staggered), b(mesh_staggered);
+
+  a = 1.0;
+  b = 2.0;
+
+  a.setLocation(CELL_XLOW);
+  b.setLocation(CELL_CENTRE);
+
+#if CHECK > 0
+  EXPECT_THROW(bout::expr::eval(lazy(a) + b), BoutException);
+#else
+  EXPECT_NO_THROW(bout::expr::eval(lazy(a) + b));
+#endif
+}
@@ -10,8 +10,10 @@
 
 #include <algorithm>
 #include <list>
+#include <numeric>
 #include <random>
 #include <sstream>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -1100,6 +1102,103 @@ TEST_F(RegionTest, regionGetStatsEmpty) {
   EXPECT_EQ(strRepresentation.str(), "Empty");
 }
 
+TEST_F(RegionTest, regionTile) {
+  Region<Ind3D> region(0, mesh->LocalNx - 1, 0, mesh->LocalNy - 1, 0, mesh->LocalNz - 1,
+                       mesh->LocalNy, mesh->LocalNz);
+  const auto indices = region.getIndices();
+
+  const RegionTileShape shape{2, 2, 3};
+  region.tile(shape);
+
+  // Indices are unchanged
+  EXPECT_EQ(region.getIndices(), indices);
+
+  // Every point is visited once, one tile at a time
+  std::vector<int> count(indices.size(), 0);
+  std::vector<std::tuple<int, int, int>> tiles;
+  for (const auto& block : region.getBlocks()) {
+    const auto tile = std::make_tuple(block.first.x() / shape.x,
+                                      block.first.y() / shape.y,
+                                      block.first.z() / shape.z);
+    if (tiles.empty() or tiles.back() != tile) {
+      // Haven't already finished this tile
+      EXPECT_EQ(std::find(tiles.begin(), tiles.end(), tile), tiles.end());
+      tiles.push_back(tile);
+    }
+    for (auto i = block.first; i < block.second; ++i) {
+      EXPECT_EQ(i.x() / shape.x, std::get<0>(tile));
+      EXPECT_EQ(i.y() / shape.y, std::get<1>(tile));
+      EXPECT_EQ(i.z() / shape.z, std::get<2>(tile));
+      ++count[i.ind];
+    }
+  }
+  EXPECT_TRUE(std::all_of(count.begin(), count.end(), [](int c) { return c == 1; }));
+
+  // Some tiles at the edges are smaller than the shape
+  EXPECT_EQ(tiles.size(), 2 * 3 * 3);
+}
+
+TEST_F(RegionTest, regionTileLoop) {
+  Region<Ind3D> region(0, mesh->LocalNx - 1, 0, mesh->LocalNy - 1, 0, mesh->LocalNz - 1,
+                       mesh->LocalNy, mesh->LocalNz);
+  region.tile({1, 2, 4});
+
+  Field3D a{0.0};
+  BOUT_FOR(i, region) { a[i] += static_cast<BoutReal>(i.ind); }
+
+  for (const auto& i : region) {
+    EXPECT_EQ(a[i], static_cast<BoutReal>(i.ind));
+  }
+}
+
+TEST(RegionTileShapeTest, DefaultShape) {
+  // Enough room for all of z and two y points
+  constexpr int nz = 16;
+  constexpr std::size_t cache_size = 2 * 4 * sizeof(BoutReal) * 3 * nz * 2;
+  const auto shape = bout::defaultRegionTileShape(10, 20, nz, cache_size);
+  EXPECT_EQ(shape.x, 10);
+  EXPECT_EQ(shape.y, 2);
+  EXPECT_EQ(shape.z, nz);
+
+  // Small cache, so z is split
+  const auto small = bout::defaultRegionTileShape(10, 20, nz, 2 * 4 * sizeof(BoutReal));
+  EXPECT_EQ(small.y, 1);
+  EXPECT_EQ(small.z, 1);
+
+  // Large cache, but can't be larger than the box
+  const auto large = bout::defaultRegionTileShape(10, 20, nz, 1 << 30);
+  EXPECT_EQ(large.y, 20);
+  EXPECT_EQ(large.z, nz);
+}
+
+TEST_F(RegionTest, AutotuneRegions) {
+  const auto before = mesh->getRegion3D("RGN_NOBNDRY").getIndices();
+
+  {
+    WithQuietOutput quiet{output_info};
+    mesh->autotuneRegions();
+  }
+
+  // Only the blocks can change
+  const auto& region = mesh->getRegion3D("RGN_NOBNDRY");
+  EXPECT_EQ(region.getIndices(), before);
+
+  std::vector<int> count(mesh->LocalNx * mesh->LocalNy * mesh->LocalNz, 0);
+  BOUT_FOR_SERIAL(i, region) { ++count[i.ind]; }
+  for (const auto& i : before) {
+    EXPECT_EQ(count[i.ind], 1);
+  }
+  EXPECT_EQ(std::accumulate(count.begin(), count.end(), 0), static_cast<int>(before.size()));
+}
+
+TEST(RegionScheduleTest, SetRuntimeSchedule) {
+  const auto schedules = bout::runtimeSchedules();
+  for (const auto& schedule : schedules) {
+    EXPECT_NO_THROW(bout::setRuntimeSchedule(schedule));
+  }
+  EXPECT_THROW(bout::setRuntimeSchedule("not a schedule"), BoutException);
+}
+
 TEST(RegionIndexConversionTest, Ind3DtoInd2D) {
   // This could just be:
   //     EXPECT_FALSE(std::is_convertible<Ind3D, Ind2D>::value());
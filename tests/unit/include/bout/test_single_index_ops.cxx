@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 
+#include "solver/test_fakesolver.hxx"
 #include "test_extras.hxx"
 
 #include "bout/derivs.hxx"
@@ -107,9 +108,6 @@ TEST_F(SingleIndexOpsTest, DDZ) {
   ASSERT_TRUE(IsFieldEqual(difops, indexops, "RGN_NOBNDRY"));
 }
 
-#if !BOUT_USE_METRIC_3D
-// Arakawa bracket not implemented for 3D metrics yet
-
 TEST_F(SingleIndexOpsTest, bracket2d3d) {
   // Fill a field with random numbers
   std::default_random_engine re;
@@ -164,7 +162,51 @@ TEST_F(SingleIndexOpsTest, bracket3d3d) {
   ASSERT_TRUE(IsFieldEqual(difops, indexops, "RGN_NOBNDRY"));
 }
 
-#endif // !BOUT_USE_METRIC_3D
+#if BOUT_USE_METRIC_3D
+TEST_F(SingleIndexOpsTest, bracketCTUVaryingMetric) {
+  WithQuietOutput quiet{output_info};
+
+  std::default_random_engine re;
+
+  auto f = random_field<Field3D>(re);
+  auto g = random_field<Field3D>(re);
+  auto g2d = random_field<Field2D>(re);
+
+  Options options;
+  FakeSolver solver{&options};
+
+  // Spacing which varies in z
+  auto* coords = mesh->getCoordinates();
+  const auto dx = [](int z) { return 1.0 + 0.1 * z; };
+  const auto dz = [](int z) { return 0.5 + 0.2 * z; };
+  coords->dx.allocate();
+  coords->dz.allocate();
+  BOUT_FOR(i, coords->dx.getRegion("RGN_ALL")) {
+    coords->dx[i] = dx(i.z());
+    coords->dz[i] = dz(i.z());
+  }
+
+  const Field3D varying3d3d = bracket(f, g, BRACKET_CTU, CELL_DEFAULT, &solver);
+  const Field3D varying3d2d = bracket(f, g2d, BRACKET_CTU, CELL_DEFAULT, &solver);
+
+  // CTU only uses the spacing at the same z, so each z should be the
+  // same as with uniform spacing equal to the spacing at that z
+  for (int z = 0; z < mesh->LocalNz; ++z) {
+    coords->dx = dx(z);
+    coords->dz = dz(z);
+
+    const Field3D uniform3d3d = bracket(f, g, BRACKET_CTU, CELL_DEFAULT, &solver);
+    const Field3D uniform3d2d = bracket(f, g2d, BRACKET_CTU, CELL_DEFAULT, &solver);
+
+    for (int x = mesh->xstart; x <= mesh->xend; ++x) {
+      for (int y = mesh->ystart; y <= mesh->yend; ++y) {
+        EXPECT_DOUBLE_EQ(varying3d3d(x, y, z), uniform3d3d(x, y, z));
+        EXPECT_DOUBLE_EQ(varying3d2d(x, y, z), uniform3d2d(x, y, z));
+      }
+    }
+  }
+}
+#endif // BOUT_USE_METRIC_3D
 
 TEST_F(SingleIndexOpsTest, Delp2_3D) {
   // Fill a field with random numbers
@@ -107,3 +107,66 @@ TEST(CyclicReduction, SerialSolveDoubleMatrix) {
   EXPECT_NEAR(x(1, 3), 0.8, CyclicReduceTolerance);
   EXPECT_NEAR(x(1, 4), 6.6, CyclicReduceTolerance);
 }
+
+TEST(CyclicReduction, SerialSolveRepeated) {
+  using namespace bout::testing;
+  CyclicReduce<BoutReal> reduce{BoutComm::get(), reduction_size};
+
+  auto a = makeMatrixFromVector({{0., 1., 1., 1., 1.}, {0., -2., -2., -2., -2.}});
+  auto b = makeMatrixFromVector({{5., 4., 3., 2., 1.}, {1., 1., 1., 1., 1.}});
+  auto c = makeMatrixFromVector({{2., 2., 2., 2., 0.}, {2., 2., 2., 2., 0.}});
+
+  reduce.setCoefs(a, b, c);
+  EXPECT_FALSE(reduce.isFactorised());
+
+  auto rhs = makeMatrixFromVector({{0., 1., 2., 2., 3.}, {5., 4., 5., 4., 5.}});
+  Matrix<BoutReal> x{2, reduction_size};
+  reduce.solve(rhs, x);
+  EXPECT_TRUE(reduce.isFactorised());
+
+  // Second solve reuses the factorisation
+  auto rhs2 = makeMatrixFromVector({{0., 2., 4., 4., 6.}, {-5., -4., -5., -4., -5.}});
+  Matrix<BoutReal> x2{2, reduction_size};
+  reduce.solve(rhs2, x2);
+
+  for (int i = 0; i < reduction_size; ++i) {
+    EXPECT_NEAR(x2(0, i), 2. * x(0, i), CyclicReduceTolerance);
+    EXPECT_NEAR(x2(1, i), -x(1, i), CyclicReduceTolerance);
+  }
+
+  // Changing the coefficients needs a new factorisation
+  reduce.setCoefs(a, b, c);
+  EXPECT_FALSE(reduce.isFactorised());
+  reduce.solve(rhs, x2);
+  for (int i = 0; i < reduction_size; ++i) {
+    EXPECT_NEAR(x2(0, i), x(0, i), CyclicReduceTolerance);
+    EXPECT_NEAR(x2(1, i), x(1, i), CyclicReduceTolerance);
+  }
+}
+
+// With one processor there is no communication to overlap, so
+// setPipelined falls back to the ordinary solve. The pipelined solve
+// itself is tested in tests/integrated/test-cyclic
+TEST(CyclicReduction, SerialSolvePipelinedFallback) {
+  using namespace bout::testing;
+  CyclicReduce<BoutReal> reduce{BoutComm::get(), reduction_size};
+  reduce.setPipelined();
+
+  auto a = makeMatrixFromVector({{0., 1., 1., 1., 1.}, {0., -2., -2., -2., -2.}});
+  auto b = makeMatrixFromVector({{5., 4., 3., 2., 1.}, {1., 1., 1., 1., 1.}});
+  auto c = makeMatrixFromVector({{2., 2., 2., 2., 0.}, {2., 2., 2., 2., 0.}});
+
+  reduce.setCoefs(a, b, c);
+
+  auto rhs = makeMatrixFromVector({{0., 1., 2., 2., 3.}, {5., 4., 5., 4., 5.}});
+  Matrix<BoutReal> x{2, reduction_size};
+
+  reduce.solve(rhs, x);
+
+  EXPECT_NEAR(x(0, 0), -1., CyclicReduceTolerance);
+  EXPECT_NEAR(x(0, 2), -4., CyclicReduceTolerance);
+  EXPECT_NEAR(x(0, 4), -2.75, CyclicReduceTolerance);
+  EXPECT_NEAR(x(1, 0), 3.4, CyclicReduceTolerance);
+  EXPECT_NEAR(x(1, 2), 5., CyclicReduceTolerance);
+  EXPECT_NEAR(x(1, 4), 6.6, CyclicReduceTolerance);
+}
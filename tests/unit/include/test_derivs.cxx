@@ -10,6 +10,7 @@
 #include "bout/paralleltransform.hxx"
 
 #include <algorithm>
+#include <map>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -491,3 +492,94 @@ TEST_P(FluxDerivativesInterfaceTest, Sanity) {
 
   EXPECT_TRUE(IsFieldEqual(result, expected, "RGN_NOBNDRY", derivatives_tolerance));
 }
+
+/////////////////////////////////////////////////////////////////////
+// Several derivatives calculated together should give the same result
+// as calculating them separately
+
+using FusedDerivativesTest = DerivativesTest;
+
+auto getFusableMethodsForDirection(DIRECTION direction)
+    -> std::vector<std::tuple<DIRECTION, DERIV, std::string>> {
+  std::vector<std::tuple<DIRECTION, DERIV, std::string>> methods{};
+  for (auto derivative_order : {DERIV::Standard, DERIV::StandardSecond,
+                                DERIV::StandardFourth, DERIV::Upwind}) {
+    const auto order_methods = getMethodsForDirection(derivative_order, direction);
+    methods.insert(methods.end(), order_methods.begin(), order_methods.end());
+  }
+  return methods;
+}
+
+auto fusedMethodToString(
+    const ::testing::TestParamInfo<std::tuple<DIRECTION, DERIV, std::string>>& param)
+    -> std::string {
+  const std::map<DERIV, std::string> names{{DERIV::Standard, "First"},
+                                           {DERIV::StandardSecond, "Second"},
+                                           {DERIV::StandardFourth, "Fourth"},
+                                           {DERIV::Upwind, "Upwind"}};
+  return names.at(std::get<1>(param.param)) + "_" + std::get<2>(param.param);
+}
+
+INSTANTIATE_TEST_SUITE_P(X, FusedDerivativesTest,
+                         ::testing::ValuesIn(getFusableMethodsForDirection(DIRECTION::X)),
+                         fusedMethodToString);
+
+INSTANTIATE_TEST_SUITE_P(Y, FusedDerivativesTest,
+                         ::testing::ValuesIn(getFusableMethodsForDirection(DIRECTION::Y)),
+                         fusedMethodToString);
+
+INSTANTIATE_TEST_SUITE_P(Z, FusedDerivativesTest,
+                         ::testing::ValuesIn(getFusableMethodsForDirection(DIRECTION::Z)),
+                         fusedMethodToString);
+
+TEST_P(FusedDerivativesTest, MatchesSeparate) {
+  using bout::derivatives::index::FusedDerivative;
+  using bout::derivatives::index::fusedDerivatives;
+
+  const auto direction = std::get<0>(GetParam());
+  const auto derivative_order = std::get<1>(GetParam());
+  const auto method = std::get<2>(GetParam());
+  const bool is_upwind = (derivative_order == DERIV::Upwind);
+
+  auto& store = DerivativeStore<Field3D>::getInstance();
+
+  Field3D separate{mesh};
+  separate.allocate();
+  if (is_upwind) {
+    store.getFlowDerivative(method, direction, STAGGER::None, derivative_order)(
+        velocity, input, separate, "RGN_NOBNDRY");
+  } else {
+    store.getStandardDerivative(method, direction, STAGGER::None, derivative_order)(
+        input, separate, "RGN_NOBNDRY");
+  }
+  Field3D separate_first{mesh};
+  separate_first.allocate();
+  store.getStandardDerivative("C2", direction)(input, separate_first, "RGN_NOBNDRY");
+
+  // The central second derivatives should be using the compiled pair
+  if (derivative_order == DERIV::StandardSecond and (method == "C2" or method == "C4")) {
+    EXPECT_TRUE(store.getFusedPair(method, "C2", direction));
+  }
+
+  Field3D fused, fused_first;
+  const std::vector<FusedDerivative<Field3D>> derivatives{
+      {derivative_order, &fused, is_upwind ? &velocity : nullptr, method},
+      {DERIV::Standard, &fused_first, nullptr, "C2"}};
+
+  switch (direction) {
+  case DIRECTION::X:
+    fusedDerivatives<Field3D, DIRECTION::X>(input, derivatives);
+    break;
+  case DIRECTION::Y:
+    fusedDerivatives<Field3D, DIRECTION::Y>(input, derivatives);
+    break;
+  case DIRECTION::Z:
+    fusedDerivatives<Field3D, DIRECTION::Z>(input, derivatives);
+    break;
+  default:
+    break;
+  }
+
+  EXPECT_TRUE(IsFieldEqual(fused, separate, "RGN_NOBNDRY"));
+  EXPECT_TRUE(IsFieldEqual(fused_first, separate_first, "RGN_NOBNDRY"));
+}
@@ -19,6 +19,8 @@
 #include "bout/options.hxx"
 #include "bout/vecops.hxx"
 
+#include <vector>
+
 /// Global mesh
 namespace bout {
 namespace globals {
@@ -142,4 +144,41 @@ TEST_P(CyclicTest, DummyTest) {
   // No test yet
 }
 
+TEST_P(CyclicTest, CoefficientGeneration) {
+  const int generation = solver.coefficientGeneration();
+
+  solver.setCoefA(1.0);
+  EXPECT_EQ(solver.coefficientGeneration(), generation + 1);
+
+  solver.setCoefD(2.0);
+  solver.setInnerBoundaryFlags(INVERT_AC_GRAD);
+  EXPECT_EQ(solver.coefficientGeneration(), generation + 3);
+}
+
+#if BOUT_HAS_FFTW
+TEST_P(CyclicTest, SolveSeveralRHS) {
+  const Field3D g3 = 2. * f3 + coef3;
+  const auto x = solver.solve(std::vector<Field3D>{f3, g3});
+
+  ASSERT_EQ(x.size(), 2U);
+  EXPECT_TRUE(IsFieldEqual(x[0], solver.solve(f3), "RGN_NOBNDRY", tol));
+  EXPECT_TRUE(IsFieldEqual(x[1], solver.solve(g3), "RGN_NOBNDRY", tol));
+}
+
+TEST_P(CyclicTest, RebuildAfterGeometry) {
+  const Field3D before = solver.solve(f3);
+
+  // The matrices depend on the metric, so must be built again
+  auto* coords = mesh->getCoordinates();
+  coords->g11 = 2.0;
+  coords->geometry();
+  const Field3D after = solver.solve(f3);
+
+  EXPECT_FALSE(IsFieldEqual(before, after, "RGN_NOBNDRY", tol));
+
+  LaplaceCyclic new_solver(&Options::root()["laplace"]);
+  EXPECT_TRUE(IsFieldEqual(after, new_solver.solve(f3), "RGN_NOBNDRY", tol));
+}
+#endif
+
 #endif // BOUT_USE_METRIC_3D
@@ -0,0 +1,123 @@
+#include "bout/build_config.hxx"
+
+#if BOUT_HAS_FFTW and not BOUT_USE_METRIC_3D
+
+#include <cmath>
+
+#include "../../../../src/invert/laplace/impls/naulin/naulin_laplace.hxx"
+#include "test_extras.hxx"
+#include "bout/invert_laplace.hxx"
+#include "gtest/gtest.h"
+
+#include "bout/constants.hxx"
+#include "bout/field2d.hxx"
+#include "bout/field3d.hxx"
+#include "bout/griddata.hxx"
+#include "bout/mesh.hxx"
+#include "bout/options.hxx"
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+class NaulinTest : public FakeMeshFixture {
+public:
+  WithQuietOutput info{output_info}, warn{output_warn}, progress{output_progress},
+      all{output};
+  NaulinTest() : FakeMeshFixture() {
+    const int nx = mesh->GlobalNx, ny = mesh->GlobalNy, nz = mesh->GlobalNz;
+
+    static_cast<FakeMesh*>(bout::globals::mesh)
+        ->setGridDataSource(new GridFromOptions(Options::getRoot()));
+    bout::globals::mesh->getCoordinates()->geometry();
+    f3.allocate();
+    coef3.allocate();
+
+    BOUT_FOR(i, mesh->getRegion3D("RGN_ALL")) {
+      const BoutReal x = i.x() / (BoutReal)nx - 0.5;
+      const BoutReal y = i.y() / (BoutReal)ny - 0.5;
+      const BoutReal z = i.z() / (BoutReal)nz - 0.5;
+      f3[i] = 1e3 * exp(-0.5 * sqrt(x * x + y * y + z * z) / sigmasq);
+      coef3[i] = 1. + 0.5 * (x + y) + 0.3 * sin(TWOPI * z);
+    }
+  }
+
+  ~NaulinTest() { Options::cleanup(); }
+
+  /// Options section \p name for a solver, to which extra settings can be added
+  Options& getOptions(const std::string& name) {
+    Options& options = Options::root()[name];
+    options["type"] = "naulin";
+    options["rtol"] = tol / 30;
+    options["atol"] = tol / 30;
+    options["delp2solver"]["type"] = "cyclic";
+    return options;
+  }
+
+  const BoutReal sigmasq = 0.02;
+  Field3D f3, coef3;
+  static constexpr BoutReal tol = 1e-8;
+};
+
+TEST_F(NaulinTest, UsePreviousSolution) {
+  LaplaceNaulin solver{&getOptions("laplace")};
+  Options& from_zero_options = getOptions("from_zero");
+  from_zero_options["use_previous_solution"] = false;
+  LaplaceNaulin from_zero{&from_zero_options};
+  solver.setCoefC(coef3);
+  from_zero.setCoefC(coef3);
+
+  const Field3D x = solver.solve(f3);
+  EXPECT_TRUE(IsFieldEqual(x, from_zero.solve(f3), "RGN_NOBNDRY", tol));
+
+  // Starting from the solution, no more iterations are needed
+  solver.resetMeanIterations();
+  EXPECT_TRUE(IsFieldEqual(solver.solve(f3), x, "RGN_NOBNDRY", tol));
+  EXPECT_EQ(solver.getMeanIterations(), 0.0);
+
+  from_zero.resetMeanIterations();
+  from_zero.solve(f3);
+  EXPECT_GT(from_zero.getMeanIterations(), 0.0);
+}
+
+TEST_F(NaulinTest, ChangeCoefficients) {
+  LaplaceNaulin solver{&getOptions("laplace")};
+  solver.setCoefD(coef3);
+  solver.solve(f3);
+
+  // The coefficients given to the delp2solver must be updated
+  const Field3D new_coef = 2. * coef3 + 1.;
+  solver.setCoefD(new_coef);
+  solver.setCoefA(0.1 * coef3);
+
+  LaplaceNaulin fresh{&getOptions("fresh")};
+  fresh.setCoefD(new_coef);
+  fresh.setCoefA(0.1 * coef3);
+
+  EXPECT_TRUE(IsFieldEqual(solver.solve(f3), fresh.solve(f3), "RGN_NOBNDRY", tol));
+}
+
+TEST_F(NaulinTest, Anderson) {
+  Options& options = getOptions("laplace");
+  options["use_previous_solution"] = false;
+  LaplaceNaulin solver{&options};
+
+  Options& anderson_options = getOptions("anderson");
+  anderson_options["use_previous_solution"] = false;
+  anderson_options["anderson_depth"] = 3;
+  LaplaceNaulin anderson{&anderson_options};
+  const Field3D coef = coef3 * coef3 * coef3;
+  solver.setCoefC(coef);
+  anderson.setCoefC(coef);
+
+  EXPECT_TRUE(IsFieldEqual(anderson.solve(f3), solver.solve(f3), "RGN_NOBNDRY", tol));
+  EXPECT_LT(anderson.getMeanIterations(), solver.getMeanIterations());
+}
+
+#endif // BOUT_HAS_FFTW and not BOUT_USE_METRIC_3D
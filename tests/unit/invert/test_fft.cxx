@@ -7,6 +7,7 @@
 #include "bout/constants.hxx"
 #include "bout/dcomplex.hxx"
 #include "bout/fft.hxx"
+#include "bout/field3d.hxx"
 
 #include <algorithm>
 #include <iostream>
@@ -111,4 +112,131 @@ TEST_P(FFTTest, RoundTrip) {
     EXPECT_NEAR(output[i], real_signal[i], FFTTolerance);
   }
 }
+
+TEST_P(FFTTest, rfftBatched) {
+  // Signals are padded, to check the distances are used
+  constexpr int howmany = 3;
+  const int in_dist = size + 2;
+  const int out_dist = nmodes + 1;
+
+  Array<BoutReal> input{howmany * in_dist};
+  for (int n = 0; n < howmany; ++n) {
+    for (int i = 0; i < size; ++i) {
+      input[n * in_dist + i] = (n + 1) * real_signal[i];
+    }
+  }
+
+  Array<dcomplex> output{howmany * out_dist};
+  bout::fft::rfft(input.begin(), size, output.begin(), howmany, in_dist, out_dist);
+
+  for (int n = 0; n < howmany; ++n) {
+    for (int i = 0; i < nmodes; ++i) {
+      EXPECT_NEAR(real(output[n * out_dist + i]), (n + 1) * real(fft_signal[i]),
+                  FFTTolerance);
+      EXPECT_NEAR(imag(output[n * out_dist + i]), (n + 1) * imag(fft_signal[i]),
+                  FFTTolerance);
+    }
+  }
+}
+
+TEST_P(FFTTest, irfftBatched) {
+  constexpr int howmany = 3;
+  const int in_dist = nmodes + 1;
+  const int out_dist = size + 2;
+
+  Array<dcomplex> input{howmany * in_dist};
+  for (int n = 0; n < howmany; ++n) {
+    for (int i = 0; i < nmodes; ++i) {
+      input[n * in_dist + i] = static_cast<BoutReal>(n + 1) * fft_signal[i];
+    }
+  }
+
+  Array<BoutReal> output{howmany * out_dist};
+  bout::fft::irfft(input.begin(), size, output.begin(), howmany, in_dist, out_dist);
+
+  for (int n = 0; n < howmany; ++n) {
+    for (int i = 0; i < size; ++i) {
+      EXPECT_NEAR(output[n * out_dist + i], (n + 1) * real_signal[i], FFTTolerance);
+    }
+  }
+}
+
+TEST(FFTPlanTest, LargeBatch) {
+  // Large enough to be split into chunks
+  constexpr int size = 8;
+  constexpr int nmodes = (size / 2) + 1;
+  constexpr int howmany = 150;
+
+  Array<BoutReal> input{howmany * size};
+  for (int n = 0; n < howmany; ++n) {
+    for (int i = 0; i < size; ++i) {
+      input[n * size + i] = std::cos((n % 3) * i * TWOPI / size) + n;
+    }
+  }
+
+  Array<dcomplex> modes{howmany * nmodes};
+  bout::fft::rfft(input.begin(), size, modes.begin(), howmany, size, nmodes);
+
+  Array<BoutReal> output{howmany * size};
+  bout::fft::irfft(modes.begin(), size, output.begin(), howmany, nmodes, size);
+
+  for (int i = 0; i < howmany * size; ++i) {
+    EXPECT_NEAR(output[i], input[i], FFTTolerance);
+  }
+}
+
+TEST(FFTPlanTest, MixedLengths) {
+  // Alternate between lengths, so each transform uses a different plan
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    for (int size : {8, 9, 16}) {
+      Array<BoutReal> signal{size};
+      for (int i = 0; i < size; ++i) {
+        signal[i] = std::cos(i * TWOPI / size);
+      }
+
+      const Array<BoutReal> output{bout::fft::irfft(bout::fft::rfft(signal), size)};
+
+      for (int i = 0; i < size; ++i) {
+        EXPECT_NEAR(output[i], signal[i], FFTTolerance);
+      }
+    }
+  }
+}
+
+TEST(FFTPlanTest, Cleanup) {
+  Array<BoutReal> signal{8};
+  std::fill(signal.begin(), signal.end(), 1.0);
+
+  bout::fft::rfft(signal);
+  bout::fft::fft_cleanup();
+
+  // Plans are made again after cleanup
+  const auto output = bout::fft::rfft(signal);
+  EXPECT_NEAR(real(output[0]), 1.0, FFTTolerance);
+}
+
+using FFTFieldTest = FakeMeshFixture;
+
+TEST_F(FFTFieldTest, RoundTripRegion) {
+  const Field3D input = makeField<Field3D>(
+      [](Ind3D& i) { return std::sin(i.z() * TWOPI / nz) + i.x() + (10. * i.y()); },
+      bout::globals::mesh);
+
+  const auto& region = bout::globals::mesh->getRegion2D("RGN_NOBNDRY");
+  const Matrix<dcomplex> modes = bout::fft::rfft(input, region);
+
+  ASSERT_EQ(modes.shape(), std::make_tuple(static_cast<int>(region.size()), nz / 2 + 1));
+
+  // Row 0 is the first point in the region
+  const auto first = region.getIndices()[0];
+  EXPECT_NEAR(real(modes(0, 0)), first.x() + (10. * first.y()), FFTTolerance);
+  EXPECT_NEAR(imag(modes(0, 1)), -0.5, FFTTolerance);
+
+  Field3D output{0.0};
+  bout::fft::irfft(modes, region, output);
+
+  EXPECT_TRUE(IsFieldEqual(output, input, "RGN_NOBNDRY", FFTTolerance));
+  // Points outside the region are unchanged
+  EXPECT_DOUBLE_EQ(output(0, 0, 0), 0.0);
+}
 #endif
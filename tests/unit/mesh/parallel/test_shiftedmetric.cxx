@@ -421,4 +421,48 @@ TEST_F(ShiftedMetricTest, CalcParallelSlices) {
   EXPECT_TRUE(IsFieldEqual(input.ynext(-1), expected_down_1, "RGN_YDOWN", FFTTolerance));
   EXPECT_TRUE(IsFieldEqual(input.ynext(-2), expected_down2, "RGN_YDOWN2", FFTTolerance));
 }
+
+TEST_F(ShiftedMetricTest, CanFusedYDerivative) {
+  auto& transform = mesh->getCoordinates()->getParallelTransform();
+
+  EXPECT_TRUE(transform.canFusedYDerivative(DERIV::Standard, "C2", "RGN_NOBNDRY"));
+  EXPECT_TRUE(transform.canFusedYDerivative(DERIV::StandardSecond, "C4", "RGN_NOY"));
+  EXPECT_FALSE(transform.canFusedYDerivative(DERIV::Standard, "W2", "RGN_NOBNDRY"));
+  EXPECT_FALSE(transform.canFusedYDerivative(DERIV::StandardFourth, "C2", "RGN_NOBNDRY"));
+  EXPECT_FALSE(transform.canFusedYDerivative(DERIV::Standard, "C2", "RGN_ALL"));
+}
+
+TEST_F(ShiftedMetricTest, FusedYDerivative) {
+  using bout::derivatives::index::standardDerivative;
+  auto& transform = mesh->getCoordinates()->getParallelTransform();
+  const Field3D aligned = toFieldAligned(input, "RGN_NOX");
+
+  for (const std::string method : {"C2", "C4"}) {
+    SCOPED_TRACE(method);
+
+    const Field3D expected_first = fromFieldAligned(
+        standardDerivative<Field3D, DIRECTION::Y, DERIV::Standard>(aligned, CELL_DEFAULT,
+                                                                   method, "RGN_NOBNDRY"),
+        "RGN_NOBNDRY");
+    EXPECT_TRUE(IsFieldEqual(
+        transform.fusedYDerivative(input, DERIV::Standard, method, "RGN_NOBNDRY"),
+        expected_first, "RGN_NOBNDRY", FFTTolerance));
+
+    const Field3D expected_second = fromFieldAligned(
+        standardDerivative<Field3D, DIRECTION::Y, DERIV::StandardSecond>(
+            aligned, CELL_DEFAULT, method, "RGN_NOBNDRY"),
+        "RGN_NOBNDRY");
+    EXPECT_TRUE(IsFieldEqual(
+        transform.fusedYDerivative(input, DERIV::StandardSecond, method, "RGN_NOBNDRY"),
+        expected_second, "RGN_NOBNDRY", FFTTolerance));
+
+    // Used by DDY and D2DY2 on fields which aren't field aligned
+    EXPECT_TRUE(IsFieldEqual(
+        bout::derivatives::index::DDY(input, CELL_DEFAULT, method, "RGN_NOBNDRY"),
+        expected_first, "RGN_NOBNDRY", FFTTolerance));
+    EXPECT_TRUE(IsFieldEqual(
+        bout::derivatives::index::D2DY2(input, CELL_DEFAULT, method, "RGN_NOBNDRY"),
+        expected_second, "RGN_NOBNDRY", FFTTolerance));
+  }
+}
 #endif
@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+
+#include "bout/boundary_region.hxx"
+#include "bout/boundary_standard.hxx"
+#include "bout/field3d.hxx"
+#include "bout/field_factory.hxx"
+
+#include "test_extras.hxx"
+
+#include <memory>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+using bout::generator::Context;
+
+class BoundaryStandardTest : public FakeMeshFixture {
+public:
+  BoundaryStandardTest() : FakeMeshFixture(), region("xin", mesh->ystart, mesh->yend, mesh) {
+    Options options;
+    options["input"]["transform_from_field_aligned"] = false;
+    factory = FieldFactory{mesh, &options};
+  }
+
+  /// Check the boundary values of \p f after applying a Dirichlet
+  /// condition with \p gen to a field which was zero
+  void checkDirichlet(const Field3D& f, FieldGenerator& gen, BoutReal t) {
+    for (region.first(); !region.isDone(); region.next1d()) {
+      for (int zk = 0; zk < mesh->LocalNz; ++zk) {
+        const BoutReal val = gen.generate(Context(&region, zk, CELL_CENTRE, t, mesh));
+        EXPECT_DOUBLE_EQ(f(region.x, region.y, zk), 2 * val);
+      }
+    }
+  }
+
+  WithQuietOutput quiet_info{output_info};
+  WithQuietOutput quiet_warn{output_warn};
+
+  BoundaryRegionXIn region;
+  FieldFactory factory;
+};
+
+TEST_F(BoundaryStandardTest, DirichletTimeIndependent) {
+  auto gen = factory.parse("x + sin(y) * cos(z)");
+  BoundaryDirichlet boundary(&region, gen);
+
+  Field3D f{0.0};
+  boundary.apply(f, 0.0);
+  checkDirichlet(f, *gen, 0.0);
+
+  f = 0.0;
+  boundary.apply(f, 1.0);
+  checkDirichlet(f, *gen, 1.0);
+}
+
+TEST_F(BoundaryStandardTest, DirichletTimeDependent) {
+  auto gen = factory.parse("x + sin(y) * cos(z) * t");
+  BoundaryDirichlet boundary(&region, gen);
+
+  for (BoutReal t : {0.0, 1.0, 2.5}) {
+    Field3D f{0.0};
+    boundary.apply(f, t);
+    checkDirichlet(f, *gen, t);
+  }
+}
+
+TEST_F(BoundaryStandardTest, DirichletChangingValue) {
+  // Can't tell whether a value given by pointer changes, so it must
+  // be evaluated every time
+  BoutReal value = 1.0;
+  auto gen = generator(&value);
+  BoundaryDirichlet boundary(&region, gen);
+
+  Field3D f{0.0};
+  boundary.apply(f, 0.0);
+  checkDirichlet(f, *gen, 0.0);
+
+  value = 3.0;
+  f = 0.0;
+  boundary.apply(f, 0.0);
+  checkDirichlet(f, *gen, 0.0);
+}
+
+TEST_F(BoundaryStandardTest, DirichletField2D) {
+  auto gen = factory.parse("x * y - t");
+  BoundaryDirichlet boundary(&region, gen);
+
+  for (BoutReal t : {0.0, 1.0}) {
+    Field2D f{0.0};
+    boundary.apply(f, t);
+    for (region.first(); !region.isDone(); region.next1d()) {
+      const BoutReal val = gen->generate(Context(&region, CELL_CENTRE, t, mesh));
+      EXPECT_DOUBLE_EQ(f(region.x, region.y), 2 * val);
+    }
+  }
+}
+
+TEST_F(BoundaryStandardTest, GeneratorValuesOtherPoints) {
+  auto gen = factory.parse("x + 2 * y + 3 * z");
+  BoundaryGeneratorValues values;
+  values.update(gen, &region, CELL_CENTRE, 0.0, mesh->LocalNz);
+
+  // All points in the boundary, not just the innermost
+  for (region.first(); !region.isDone(); region.next()) {
+    for (int zk = 0; zk < mesh->LocalNz; ++zk) {
+      EXPECT_DOUBLE_EQ(values(zk),
+                       gen->generate(Context(&region, zk, CELL_CENTRE, 0.0, mesh)));
+    }
+  }
+}
@@ -3,6 +3,9 @@
 #include "bout/build_config.hxx"
 #include "bout/constants.hxx"
 #include "bout/coordinates.hxx"
+#include "bout/difops.hxx"
+#include "bout/fft.hxx"
+#include "bout/invert_laplace.hxx"
 #include "bout/mesh.hxx"
 #include "bout/output.hxx"
 
@@ -303,3 +306,56 @@ TEST_F(CoordinatesTest, NegativeB) {
   output_warn.enable();
   output_info.enable();
 }
+
+#if BOUT_HAS_FFTW and not BOUT_USE_METRIC_3D
+namespace {
+/// Calculate Delp2 with the FFT one (x, y) column at a time
+Field3D delp2Reference(const Field3D& f) {
+  const int nkz = (mesh->LocalNz / 2) + 1;
+  Field3D result{0.0};
+  Array<dcomplex> ftm(nkz);
+  Array<dcomplex> ft(nkz);
+  Array<dcomplex> ftp(nkz);
+  Array<dcomplex> delft(nkz);
+  for (int jx = mesh->xstart; jx <= mesh->xend; jx++) {
+    for (int jy = mesh->ystart; jy <= mesh->yend; jy++) {
+      bout::fft::rfft(&f(jx - 1, jy, 0), mesh->LocalNz, ftm.begin());
+      bout::fft::rfft(&f(jx, jy, 0), mesh->LocalNz, ft.begin());
+      bout::fft::rfft(&f(jx + 1, jy, 0), mesh->LocalNz, ftp.begin());
+      for (int jz = 0; jz < nkz; jz++) {
+        dcomplex a, b, c;
+        laplace_tridag_coefs(jx, jy, jz, a, b, c);
+        delft[jz] = a * ftm[jz] + b * ft[jz] + c * ftp[jz];
+      }
+      bout::fft::irfft(delft.begin(), mesh->LocalNz, &result(jx, jy, 0));
+    }
+  }
+  return result;
+}
+} // namespace
+
+TEST_F(CoordinatesTest, Delp2FFT) {
+  WithQuietOutput quiet_info{output_info};
+  WithQuietOutput quiet_warn{output_warn};
+  WithQuietOutput quiet_progress{output_progress};
+
+  Field3D f{0.0};
+  BOUT_FOR(i, f.getRegion("RGN_ALL")) {
+    f[i] = i.x() + (0.5 * i.y()) + sin(i.z() * TWOPI / mesh->LocalNz)
+           + (0.1 * i.x() * cos(2 * i.z() * TWOPI / mesh->LocalNz));
+  }
+
+  auto* coords = mesh->getCoordinates();
+  EXPECT_TRUE(IsFieldEqual(Delp2(f), delp2Reference(f), "RGN_NOBNDRY"));
+  // Second call uses the cached coefficients
+  EXPECT_TRUE(IsFieldEqual(Delp2(f), delp2Reference(f), "RGN_NOBNDRY"));
+
+  // Changing the geometry must update the coefficients
+  coords->g11 = 2.0;
+  coords->g33 = 3.0;
+  coords->geometry(false);
+  EXPECT_TRUE(IsFieldEqual(Delp2(f), delp2Reference(f), "RGN_NOBNDRY"));
+
+  Laplacian::cleanup();
+}
+#endif
@@ -8,6 +8,8 @@
 
 #include "test_extras.hxx"
 
+#include <algorithm>
+
 /// Test fixture to make sure the global mesh is our fake one
 class MeshTest : public ::testing::Test {
 public:
@@ -76,6 +78,38 @@ TEST_F(MeshTest, HasRegionPerp) {
   EXPECT_FALSE(localmesh.hasRegionPerp("SOME_MADE_UP_REGION_NAME"));
 }
 
+TEST_F(MeshTest, InteriorAndShellRegions) {
+  FakeMesh mesh{7, 7, 3};
+  mesh.createDefaultRegions();
+
+  const auto& nobndry = mesh.getRegion3D("RGN_NOBNDRY");
+  const auto& interior = mesh.getRegion3D("RGN_NOBNDRY_INTERIOR");
+  const auto& shell = mesh.getRegion3D("RGN_NOBNDRY_SHELL");
+
+  EXPECT_EQ(nobndry.size(), 5 * 5 * 3);
+  EXPECT_EQ(interior.size(), 3 * 3 * 3);
+  EXPECT_EQ(shell.size(), nobndry.size() - interior.size());
+
+  // Interior and shell together make up RGN_NOBNDRY
+  EXPECT_EQ((interior + shell).asSorted().getIndices(), nobndry.getIndices());
+
+  // Neighbours of interior points are not guard cells
+  const auto is_in_nobndry = [&nobndry](const Ind3D& i) {
+    return std::find(nobndry.begin(), nobndry.end(), i) != nobndry.end();
+  };
+  for (const auto& i : interior) {
+    EXPECT_TRUE(is_in_nobndry(i.xp()));
+    EXPECT_TRUE(is_in_nobndry(i.xm()));
+    EXPECT_TRUE(is_in_nobndry(i.yp()));
+    EXPECT_TRUE(is_in_nobndry(i.ym()));
+  }
+
+  const auto& interior2D = mesh.getRegion2D("RGN_NOBNDRY_INTERIOR");
+  const auto& shell2D = mesh.getRegion2D("RGN_NOBNDRY_SHELL");
+  EXPECT_EQ(interior2D.size(), 3 * 3);
+  EXPECT_EQ(shell2D.size(), 5 * 5 - 3 * 3);
+}
+
 TEST_F(MeshTest, GetRegionTemplatedFromMesh) {
   using namespace ::testing;
   localmesh.createDefaultRegions();
@@ -0,0 +1,179 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx"
+#include "bout/bout_types.hxx"
+#include "bout/sys/expressionparser.hxx"
+#include "bout/sys/generator_program.hxx"
+
+#include <cmath>
+#include <vector>
+
+using bout::generator::Context;
+using bout::generator::Program;
+
+namespace {
+// Need to inherit from ExpressionParser in order to expose the
+// protected parseString as a public method
+class ProgramParser : public ExpressionParser {
+public:
+  ProgramParser() {
+    addGenerator("sin", std::make_shared<SinGenerator>());
+    addGenerator("increment", std::make_shared<IncrementGenerator>());
+  }
+  using ExpressionParser::parseString;
+
+private:
+  /// Compiled function of one argument
+  class SinGenerator : public FieldGenerator {
+  public:
+    SinGenerator(FieldGeneratorPtr arg = nullptr) : arg(std::move(arg)) {}
+    FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override {
+      return std::make_shared<SinGenerator>(args.front());
+    }
+    BoutReal generate(const Context& ctx) override { return std::sin(arg->generate(ctx)); }
+    int compile(Program& program) override {
+      return program.function([](BoutReal value) { return std::sin(value); },
+                              arg->compile(program));
+    }
+
+  private:
+    FieldGeneratorPtr arg;
+  };
+
+  /// Doesn't implement compile, so has to use generate
+  class IncrementGenerator : public FieldGenerator {
+  public:
+    IncrementGenerator(FieldGeneratorPtr arg = nullptr) : arg(std::move(arg)) {}
+    FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override {
+      return std::make_shared<IncrementGenerator>(args.front());
+    }
+    BoutReal generate(const Context& ctx) override { return arg->generate(ctx) + 1; }
+
+  private:
+    FieldGeneratorPtr arg;
+  };
+};
+
+class GeneratorProgramTest : public ::testing::Test {
+public:
+  GeneratorProgramTest() {
+    // More than one batch, and not a multiple of the batch size
+    const int npoints = 2 * Program::batch_size + 7;
+    for (int i = 0; i < npoints; ++i) {
+      x.push_back(0.01 * i);
+      y.push_back(1.0 - 0.003 * i);
+      z.push_back(0.5 + 0.02 * i);
+    }
+  }
+
+  /// Evaluate \p program at all the points
+  std::vector<BoutReal> evaluate(const Program& program, BoutReal t,
+                                 Program::SavedValues* saved = nullptr) {
+    std::vector<BoutReal> result(x.size());
+    program.evaluate(static_cast<int>(x.size()), x.data(), y.data(), z.data(), t,
+                     result.data(), [&](int i) { return context(i, t); }, saved);
+    return result;
+  }
+
+  /// Evaluate \p generator at all the points, one at a time
+  std::vector<BoutReal> generate(FieldGenerator& generator, BoutReal t) {
+    std::vector<BoutReal> result;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      result.push_back(generator.generate(context(static_cast<int>(i), t)));
+    }
+    return result;
+  }
+
+  Context context(int i, BoutReal t) const {
+    return Context().set("x", x[i], "y", y[i], "z", z[i], "t", t);
+  }
+
+  ProgramParser parser;
+  std::vector<BoutReal> x, y, z;
+};
+
+void expectEqual(const std::vector<BoutReal>& result,
+                 const std::vector<BoutReal>& expected) {
+  ASSERT_EQ(result.size(), expected.size());
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    EXPECT_DOUBLE_EQ(result[i], expected[i]) << "at point " << i;
+  }
+}
+} // namespace
+
+TEST_F(GeneratorProgramTest, NullGenerator) {
+  EXPECT_THROW(Program{nullptr}, BoutException);
+}
+
+TEST_F(GeneratorProgramTest, ConstantFolding) {
+  const Program program(parser.parseString("1 + 2 * 3 - 2^2"));
+
+  EXPECT_TRUE(program.isConstant());
+  EXPECT_FALSE(program.dependsOnTime());
+  EXPECT_EQ(program.size(), 1);
+  expectEqual(evaluate(program, 0.0), std::vector<BoutReal>(x.size(), 3.0));
+}
+
+TEST_F(GeneratorProgramTest, PartialConstantFolding) {
+  // The constants and sin of a constant are calculated once
+  const Program program(parser.parseString("x * (2 + sin(1))"));
+
+  EXPECT_FALSE(program.isConstant());
+  EXPECT_EQ(program.size(), 3);
+}
+
+TEST_F(GeneratorProgramTest, MatchesGenerate) {
+  for (const auto& expression :
+       {"x", "y", "z", "t", "x + y * z", "x - y / z", "(x - y) * (z + t)", "x^2 + y^z",
+        "sin(x * y) - t / 3", "-x", "2 * sin(z) ^ 2 - 1"}) {
+    const auto generator = parser.parseString(expression);
+    const Program program(generator);
+    SCOPED_TRACE(expression);
+    expectEqual(evaluate(program, 1.5), generate(*generator, 1.5));
+  }
+}
+
+TEST_F(GeneratorProgramTest, TimeDependence) {
+  EXPECT_FALSE(Program(parser.parseString("x * y + sin(z)")).dependsOnTime());
+  EXPECT_TRUE(Program(parser.parseString("x * y + sin(t)")).dependsOnTime());
+  EXPECT_TRUE(Program(parser.parseString("t")).dependsOnTime());
+}
+
+TEST_F(GeneratorProgramTest, Fallback) {
+  const auto generator = parser.parseString("2 * increment(x * y) + z");
+  const Program program(generator);
+
+  // Not known whether the fallback depends on time
+  EXPECT_TRUE(program.dependsOnTime());
+  expectEqual(evaluate(program, 0.0), generate(*generator, 0.0));
+}
+
+TEST_F(GeneratorProgramTest, SavedValues) {
+  const auto generator = parser.parseString("sin(x * y) * t + z / y");
+  const Program program(generator);
+
+  Program::SavedValues saved;
+  expectEqual(evaluate(program, 1.0, &saved), generate(*generator, 1.0));
+  EXPECT_EQ(saved.npoints, static_cast<int>(x.size()));
+
+  // Use the saved time-independent values at a different time
+  expectEqual(evaluate(program, 2.0, &saved), generate(*generator, 2.0));
+
+  // Check that the saved values are used, by changing the inputs
+  const auto changed_x = x;
+  x.assign(x.size(), 0.0);
+  std::vector<BoutReal> result(x.size());
+  program.evaluate(static_cast<int>(x.size()), x.data(), y.data(), z.data(), 2.0,
+                   result.data(), [&](int i) { return context(i, 2.0); }, &saved);
+  x = changed_x;
+  expectEqual(result, generate(*generator, 2.0));
+}
+
+TEST_F(GeneratorProgramTest, SavedValuesTimeIndependent) {
+  const auto generator = parser.parseString("x * y - z");
+  const Program program(generator);
+
+  Program::SavedValues saved;
+  expectEqual(evaluate(program, 1.0, &saved), generate(*generator, 1.0));
+  expectEqual(evaluate(program, 2.0, &saved), generate(*generator, 2.0));
+}
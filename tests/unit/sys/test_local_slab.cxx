@@ -0,0 +1,141 @@
+#include "gtest/gtest.h"
+
+#include "../../../src/sys/options/local_slab.hxx"
+#include "test_extras.hxx"
+#include "bout/sys/range.hxx"
+
+#include <set>
+#include <utility>
+
+using bout::LocalSlab;
+
+namespace {
+/// A mesh whose lower y boundary only covers part of the x range, as
+/// if the separatrix were on this processor
+class SplitBoundaryMesh : public FakeMesh {
+public:
+  SplitBoundaryMesh(int nx, int ny, int nz, RangeIterator lower)
+      : FakeMesh(nx, ny, nz), lower(std::move(lower)) {}
+
+  RangeIterator iterateBndryLowerY() const override { return lower; }
+
+  // Put this processor somewhere in the middle of the global arrays
+  int getGlobalXIndex(int xlocal) const override { return xlocal + 4; }
+  int getGlobalYIndex(int ylocal) const override { return ylocal + 10; }
+
+private:
+  RangeIterator lower;
+};
+
+/// Global (x, y) indices of all the cells in \p slab. Fails if any are
+/// in more than one part
+std::set<std::pair<std::size_t, std::size_t>> globalCells(const LocalSlab& slab) {
+  std::set<std::pair<std::size_t, std::size_t>> cells;
+  for (const auto& part : slab.parts) {
+    for (std::size_t x = 0; x < part.nx(); ++x) {
+      for (std::size_t y = 0; y < part.ny(); ++y) {
+        EXPECT_TRUE(cells.emplace(part.xoffset + x, part.yoffset + y).second);
+      }
+    }
+  }
+  return cells;
+}
+} // namespace
+
+TEST(LocalSlabTest, AllBoundaries) {
+  WithQuietOutput quiet{output_info};
+  FakeMesh mesh(8, 6, 1);
+  const LocalSlab slab(&mesh);
+
+  EXPECT_EQ(slab.global_nx, 8);
+  EXPECT_EQ(slab.global_ny, 6);
+
+  // The interior with the x boundaries
+  EXPECT_EQ(slab.parts[0].xstart, 0);
+  EXPECT_EQ(slab.parts[0].xend, 7);
+  EXPECT_EQ(slab.parts[0].ystart, 1);
+  EXPECT_EQ(slab.parts[0].yend, 4);
+
+  // Both y boundaries, including the corners
+  EXPECT_EQ(slab.parts[1].xstart, 0);
+  EXPECT_EQ(slab.parts[1].xend, 7);
+  EXPECT_EQ(slab.parts[1].ystart, 0);
+  EXPECT_EQ(slab.parts[1].yend, 0);
+  EXPECT_EQ(slab.parts[2].xstart, 0);
+  EXPECT_EQ(slab.parts[2].xend, 7);
+  EXPECT_EQ(slab.parts[2].ystart, 5);
+  EXPECT_EQ(slab.parts[2].yend, 5);
+
+  // Every cell is written once
+  EXPECT_EQ(globalCells(slab).size(), 8 * 6U);
+}
+
+TEST(LocalSlabTest, SplitLowerBoundary) {
+  WithQuietOutput quiet{output_info};
+  SplitBoundaryMesh mesh(8, 6, 1, RangeIterator(3, 6));
+  const LocalSlab slab(&mesh);
+
+  EXPECT_EQ(slab.parts[0].xoffset, 4U);
+  EXPECT_EQ(slab.parts[0].yoffset, 11U);
+
+  // Only the part of the lower y guard cells which is a boundary,
+  // which reaches the outer x boundary
+  const auto& lower = slab.parts[1];
+  EXPECT_EQ(lower.xstart, 3);
+  EXPECT_EQ(lower.xend, 7);
+  EXPECT_EQ(lower.ystart, 0);
+  EXPECT_EQ(lower.yend, 0);
+  EXPECT_EQ(lower.xoffset, 7U);
+  EXPECT_EQ(lower.yoffset, 10U);
+
+  EXPECT_EQ(slab.parts[2].nx(), 8U);
+  EXPECT_EQ(slab.parts[2].ny(), 1U);
+
+  // The y guard cells at x = 0, 1, 2 are not written
+  const auto cells = globalCells(slab);
+  EXPECT_EQ(cells.size(), 8 * 6 - 3U);
+  for (std::size_t x = 4; x < 7; ++x) {
+    EXPECT_EQ(cells.count({x, 10}), 0U);
+  }
+}
+
+TEST(LocalSlabTest, NoLowerBoundary) {
+  WithQuietOutput quiet{output_info};
+  SplitBoundaryMesh mesh(8, 6, 1, RangeIterator());
+  const LocalSlab slab(&mesh);
+
+  // Every processor has the same number of parts, even if empty
+  EXPECT_EQ(slab.parts[1].nx(), 0U);
+  EXPECT_EQ(slab.parts[1].xoffset, 0U);
+  EXPECT_EQ(slab.parts[1].yoffset, 0U);
+
+  EXPECT_EQ(globalCells(slab).size(), 8 * 5U);
+}
+
+TEST(LocalSlabTest, DisjointBoundary) {
+  WithQuietOutput quiet{output_info};
+  SplitBoundaryMesh mesh(8, 6, 1, RangeIterator(1, 2, RangeIterator(5, 6)));
+
+  EXPECT_THROW(LocalSlab{&mesh}, BoutException);
+}
+
+TEST(LocalSlabTest, Pack) {
+  bout::SlabPart part{1, 2, 0, 1, 0, 0};
+
+  Matrix<BoutReal> data(3, 2);
+  // Anything with getNz() and (x, y, z) indexing, like a Field3D
+  struct {
+    Matrix<BoutReal>& data;
+    int getNz() const { return 2; }
+    BoutReal operator()(int x, int y, int z) const { return data(x, y) + 0.5 * z; }
+  } field{data};
+
+  for (int x = 0; x < 3; ++x) {
+    for (int y = 0; y < 2; ++y) {
+      data(x, y) = 10 * x + y;
+    }
+  }
+
+  const std::vector<BoutReal> expected{10, 10.5, 11, 11.5, 20, 20.5, 21, 21.5};
+  EXPECT_EQ(part.pack(field), expected);
+}
@@ -305,4 +305,76 @@ TEST_F(OptionsNetCDFTest, WriteMultipleTimeDimensions) {
   EXPECT_NO_THROW(OptionsNetCDF(filename).verifyTimesteps());
 }
 
+TEST_F(OptionsNetCDFTest, ReadMetadata) {
+  {
+    Options options;
+    options["int"] = 42;
+    options["field"] = Field3D(2.4);
+    options["field"].attributes["thing"] = 4;
+
+    OptionsNetCDF(filename).write(options);
+  }
+
+  Options data = OptionsNetCDF(filename).readMetadata();
+
+  EXPECT_EQ(data["int"], 42);
+  EXPECT_FALSE(data.isSet("field"));
+  EXPECT_EQ(data["field"].attributes["thing"].as<int>(), 4);
+}
+
+TEST_F(OptionsNetCDFTest, VariableShapes) {
+  {
+    Options options;
+    options["int"] = 42;
+    options["field"] = Field3D(2.4);
+
+    OptionsNetCDF(filename).write(options);
+  }
+
+  const auto shapes = OptionsNetCDF(filename).variableShapes();
+
+  EXPECT_TRUE(shapes.at("int").empty());
+  EXPECT_EQ(shapes.at("field"), (std::vector<int>{bout::globals::mesh->LocalNx,
+                                                  bout::globals::mesh->LocalNy,
+                                                  bout::globals::mesh->LocalNz}));
+}
+
+TEST_F(OptionsNetCDFTest, ReadSlab) {
+  {
+    Field2D field{bout::globals::mesh};
+    field.allocate();
+    for (int i = 0; i < nx; ++i) {
+      for (int j = 0; j < ny; ++j) {
+        field(i, j) = 10 * i + j;
+      }
+    }
+    Options options;
+    options["field"] = field;
+    options["field"].attributes["thing"] = 4;
+
+    OptionsNetCDF(filename).write(options);
+  }
+
+  Options slab = OptionsNetCDF(filename).readSlab("field", {1, 2}, {2, 3});
+
+  EXPECT_EQ(slab.attributes["thing"].as<int>(), 4);
+
+  const auto value = slab.as<Matrix<BoutReal>>();
+  ASSERT_EQ(value.shape(), std::make_tuple(2, 3));
+  EXPECT_DOUBLE_EQ(value(0, 0), 12.0);
+  EXPECT_DOUBLE_EQ(value(1, 2), 24.0);
+}
+
+TEST_F(OptionsNetCDFTest, ReadSlabWrongDimensions) {
+  {
+    Options options;
+    options["field"] = Field3D(2.4);
+
+    OptionsNetCDF(filename).write(options);
+  }
+
+  EXPECT_THROW(OptionsNetCDF(filename).readSlab("field", {0, 0}, {1, 1}), BoutException);
+  EXPECT_THROW(OptionsNetCDF(filename).readSlab("missing", {0}, {1}), BoutException);
+}
+
 #endif // BOUT_HAS_NETCDF
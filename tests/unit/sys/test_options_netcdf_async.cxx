@@ -0,0 +1,159 @@
+// Test writing to NetCDF files in a background thread
+
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx"
+#include "bout/array.hxx"
+#include "bout/field3d.hxx"
+#include "bout/mesh.hxx"
+#include "bout/options_netcdf_async.hxx"
+
+#include <cstdio>
+
+using bout::AsyncOptionsWriter;
+using bout::OptionsNetCDF;
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+}
+} // namespace bout
+
+// Reuse the "standard" fixture for FakeMesh
+class OptionsNetCDFAsyncTest : public FakeMeshFixture {
+public:
+  OptionsNetCDFAsyncTest() : FakeMeshFixture() {}
+  ~OptionsNetCDFAsyncTest() override { std::remove(filename.c_str()); }
+
+  // A temporary filename
+  std::string filename{std::tmpnam(nullptr)};
+};
+
+TEST_F(OptionsNetCDFAsyncTest, DeepCopyField3D) {
+  Field3D field = 1.0;
+  Options options;
+  options["field"] = field;
+
+  Options snapshot = bout::deepCopy(options);
+
+  // Change original in place, as a solver would
+  field(1, 1, 1) = 2.0;
+  options["field"].as<Field3D>()(1, 1, 1) = 3.0;
+
+  EXPECT_TRUE(IsFieldEqual(snapshot["field"].as<Field3D>(), 1.0));
+}
+
+TEST_F(OptionsNetCDFAsyncTest, DeepCopyArray) {
+  Array<BoutReal> array(3);
+  array[0] = 1.0;
+  Options options;
+  options["section"]["array"] = array;
+
+  Options snapshot = bout::deepCopy(options);
+
+  array[0] = 2.0;
+
+  EXPECT_DOUBLE_EQ(snapshot["section"]["array"].as<Array<BoutReal>>()[0], 1.0);
+}
+
+TEST_F(OptionsNetCDFAsyncTest, DeepCopyAttributes) {
+  Options options;
+  options["value"] = 42;
+  options["value"].attributes["time_dimension"] = "t";
+
+  Options snapshot = bout::deepCopy(options);
+
+  EXPECT_EQ(snapshot["value"].as<int>(), 42);
+  EXPECT_EQ(snapshot["value"].attributes["time_dimension"].as<std::string>(), "t");
+}
+
+TEST_F(OptionsNetCDFAsyncTest, WriteErrorRethrown) {
+  // Fails with or without netCDF
+  OptionsNetCDF file("/nonexistent/directory/file.nc");
+  AsyncOptionsWriter writer;
+
+  Options options;
+  options["value"] = 1.0;
+  writer.write(file, options);
+
+  try {
+    writer.flush();
+    FAIL() << "flush didn't throw";
+  } catch (const BoutException& e) {
+    EXPECT_NE(std::string(e.what()), "");
+  }
+
+  // The error is only thrown once, and the destructor doesn't throw
+  EXPECT_NO_THROW(writer.flush());
+}
+
+#if BOUT_HAS_NETCDF && !BOUT_HAS_LEGACY_NETCDF
+
+TEST_F(OptionsNetCDFAsyncTest, WriteAndFlush) {
+  {
+    OptionsNetCDF file(filename);
+    AsyncOptionsWriter writer;
+
+    Field3D field = 1.0;
+    Options options;
+    options["field"] = field;
+    options["int"] = 42;
+    writer.write(file, options);
+
+    // Changes after write shouldn't affect the file
+    field = 2.0;
+    options["field"] = field;
+
+    writer.flush();
+    EXPECT_EQ(writer.pending(), 0);
+  }
+
+  Options data = OptionsNetCDF(filename).read();
+
+  EXPECT_EQ(data["int"], 42);
+  EXPECT_TRUE(IsFieldEqual(data["field"].as<Field3D>(bout::globals::mesh), 1.0));
+}
+
+TEST_F(OptionsNetCDFAsyncTest, WriteTimesteps) {
+  {
+    OptionsNetCDF file(filename);
+    AsyncOptionsWriter writer(1);
+
+    Options options;
+    for (int i = 0; i < 5; ++i) {
+      options["value"].assignRepeat(static_cast<BoutReal>(i));
+      writer.write(file, options);
+      writer.verifyTimesteps(file);
+    }
+    EXPECT_NO_THROW(writer.flush());
+  }
+
+  Options data = OptionsNetCDF(filename).read();
+
+  const auto values = data["value"].as<Array<BoutReal>>();
+  ASSERT_EQ(values.size(), 5);
+  EXPECT_DOUBLE_EQ(values[4], 4.0);
+}
+
+TEST_F(OptionsNetCDFAsyncTest, FlushRethrows) {
+  OptionsNetCDF file(filename);
+  AsyncOptionsWriter writer;
+
+  Options options;
+  options["thing1"].assignRepeat(1.0);
+  writer.write(file, options);
+
+  // Second variable has one fewer timestep
+  options["thing1"].assignRepeat(2.0);
+  options["thing2"].assignRepeat(3.0);
+  writer.write(file, options);
+  writer.verifyTimesteps(file);
+
+  EXPECT_THROW(writer.flush(), BoutException);
+
+  // Error is only thrown once
+  EXPECT_NO_THROW(writer.flush());
+}
+
+#endif // BOUT_HAS_NETCDF